@@ -6,6 +6,7 @@
 #include "MeshUtilities.h"
 #include "PackageTools.h"
 #include "TurboSequence_MeshAsset_Lf.h"
+#include "TurboSequence_Utility_Lf.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/SkeletalMeshSocket.h"
 #include "Engine/SkinnedAssetCommon.h"
@@ -460,6 +461,38 @@ void FTurboSequence_Editor_LfModule::CreateStaticMesh(UTurboSequence_MeshAsset_L
 	Actor->Destroy();
 }
 
+void FTurboSequence_Editor_LfModule::BakeAnimationLibrary(UTurboSequence_MeshAsset_Lf* DataAsset)
+{
+	if (!IsValid(DataAsset->ReferenceMeshNative))
+	{
+		UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't bake the animation library of %s, the reference mesh is missing..."),
+		       *DataAsset->GetName());
+		return;
+	}
+
+	DataAsset->BakedAnimationLibrary.Empty();
+	for (const TObjectPtr<UAnimSequence>& Animation : DataAsset->AnimationsToBake)
+	{
+		if (!IsValid(Animation))
+		{
+			continue;
+		}
+
+		FTurboSequence_BakedAnimation_Lf BakedAnimation;
+		if (FTurboSequence_Utility_Lf::BakeAnimation(BakedAnimation, DataAsset, Animation))
+		{
+			DataAsset->BakedAnimationLibrary.Add(MoveTemp(BakedAnimation));
+		}
+		else
+		{
+			UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't bake %s into %s, the animation doesn't fit the skeleton..."),
+			       *Animation->GetName(), *DataAsset->GetName());
+		}
+	}
+
+	DataAsset->MarkPackageDirty();
+}
+
 
 
 void FTurboSequence_Editor_LfModule::OnFilesLoaded()
@@ -41,6 +41,16 @@ void FTurboSequence_MeshAssetAction_Lf::GetActions( const TArray<UObject*>& InOb
 			)
 		);
 
+	MenuBuilder.AddMenuEntry(
+		NSLOCTEXT("FTurboSequence_MeshAssetAction","MeshAssetAction_BakeAnimations", "Bake Animation Library"),
+		NSLOCTEXT("FTurboSequence_MeshAssetAction", "MeshAssetAction_BakeAnimationsTooltip", "Samples the Animations To Bake offline into GPU ready keyframes stored in the asset"),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateSP( this, &FTurboSequence_MeshAssetAction_Lf::BakeAnimationLibrary, Objects ),
+			FCanExecuteAction()
+			)
+		);
+
 	MenuBuilder.AddMenuSeparator();
 }
 
@@ -55,3 +65,14 @@ void FTurboSequence_MeshAssetAction_Lf::CreateStaticMesh(TArray<TWeakObjectPtr<c
 	}
 }
 
+
+void FTurboSequence_MeshAssetAction_Lf::BakeAnimationLibrary(TArray<TWeakObjectPtr<class UTurboSequence_MeshAsset_Lf>> Objects)
+{
+	for (TWeakObjectPtr<UTurboSequence_MeshAsset_Lf> MeshAssetPtr : Objects)
+	{
+		if(UTurboSequence_MeshAsset_Lf* MeshAsset = MeshAssetPtr.Get())
+		{
+			FTurboSequence_Editor_LfModule::BakeAnimationLibrary(MeshAsset);
+		}
+	}
+}
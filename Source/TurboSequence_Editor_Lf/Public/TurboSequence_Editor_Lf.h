@@ -26,6 +26,7 @@ public:
 	inline static int16 RepairMaxIterationCounter = 0;
 
 	static void CreateStaticMesh(UTurboSequence_MeshAsset_Lf* DataAsset);
+	static void BakeAnimationLibrary(UTurboSequence_MeshAsset_Lf* DataAsset);
 	
 	void OnInvalidMeshAssetCaches() const;
 
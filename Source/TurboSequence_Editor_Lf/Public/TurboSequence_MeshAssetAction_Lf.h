@@ -18,4 +18,5 @@ public:
 
 	void GetActions( const TArray<UObject*>& InObjects, FMenuBuilder& MenuBuilder );
 	void CreateStaticMesh(TArray<TWeakObjectPtr<class UTurboSequence_MeshAsset_Lf>> Objects);
+	void BakeAnimationLibrary(TArray<TWeakObjectPtr<class UTurboSequence_MeshAsset_Lf>> Objects);
 };
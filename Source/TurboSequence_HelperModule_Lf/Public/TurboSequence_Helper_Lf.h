@@ -576,6 +576,128 @@ public:
 		return FVector(Vector.X, Vector.Y, Vector.Z);
 	}
 
+	// Compact instance transform, 21 bit fixed point position per axis relative to a tile origin,
+	// smallest three rotation with 10 bits per component and a uniform scale, decoded by TS_CompactTransform_Lf.ush
+	static constexpr int32 NumCompactTransformValues = 4;
+	static constexpr int32 CompactPositionBits = 21;
+	static constexpr int32 CompactPositionBias = 1 << (CompactPositionBits - 1);
+
+	/**
+	 * Encodes a transform into NumCompactTransformValues integers.
+	 *
+	 * @param OutValues Receives the encoded transform
+	 * @param Transform The transform to encode, non uniform scale keeps the largest axis, mirrored axes become
+	 *                  a negative scale and a half turn of the rotation
+	 * @param TileOrigin The origin the position is relative to
+	 * @param PositionStep The world space size of one fixed point position step
+	 *
+	 * @return false if the position is out of the range of the tile, OutValues stays untouched
+	 *
+	 * @throws None
+	 */
+	static FORCEINLINE_DEBUGGABLE bool EncodeCompactTransform(int32* OutValues, const FTransform& Transform,
+	                                                          const FVector& TileOrigin, const double PositionStep)
+	{
+		const FVector Steps = (Transform.GetLocation() - TileOrigin) / PositionStep;
+		const int64 X = FMath::RoundToInt64(Steps.X) + CompactPositionBias;
+		const int64 Y = FMath::RoundToInt64(Steps.Y) + CompactPositionBias;
+		const int64 Z = FMath::RoundToInt64(Steps.Z) + CompactPositionBias;
+		constexpr int64 MaxPosition = (1 << CompactPositionBits) - 1;
+		if (X < 0 || Y < 0 || Z < 0 || X > MaxPosition || Y > MaxPosition || Z > MaxPosition)
+		{
+			return false;
+		}
+		OutValues[0] = static_cast<int32>(static_cast<uint32>(X) | static_cast<uint32>(Y) << CompactPositionBits);
+		OutValues[1] = static_cast<int32>(static_cast<uint32>(Y) >> (32 - CompactPositionBits) | static_cast<uint32>(Z) << (
+			CompactPositionBits * 2 - 32));
+
+		// A negative scale on one or three axes is a negative uniform scale, the axes flipped in addition are
+		// a half turn around the remaining axis, applied before the rotation
+		const FVector Scale3D = Transform.GetScale3D();
+		const int32 NumMirroredAxes = (Scale3D.X < 0) + (Scale3D.Y < 0) + (Scale3D.Z < 0);
+		const double ScaleSign = NumMirroredAxes % 2 ? -1 : 1;
+		FQuat Rotation = Transform.GetRotation().GetNormalized();
+		if (NumMirroredAxes == 1 || NumMirroredAxes == 2)
+		{
+			const bool bFlipsX = (Scale3D.X < 0) != (ScaleSign < 0);
+			const bool bFlipsY = (Scale3D.Y < 0) != (ScaleSign < 0);
+			Rotation = Rotation * (!bFlipsX ? FQuat(1, 0, 0, 0) : !bFlipsY ? FQuat(0, 1, 0, 0) : FQuat(0, 0, 1, 0));
+		}
+
+		// Smallest three, the largest component is rebuilt from the unit length and kept positive
+		double Components[4] = {Rotation.X, Rotation.Y, Rotation.Z, Rotation.W};
+		int32 LargestIndex = 0;
+		for (int32 i = 1; i < 4; ++i)
+		{
+			if (FMath::Abs(Components[i]) > FMath::Abs(Components[LargestIndex]))
+			{
+				LargestIndex = i;
+			}
+		}
+		const double Sign = Components[LargestIndex] < 0 ? -1 : 1;
+		uint32 PackedRotation = static_cast<uint32>(LargestIndex) << 30;
+		for (int32 i = 0, Shift = 20; i < 4; ++i)
+		{
+			if (i != LargestIndex)
+			{
+				const double Normalized = FMath::Clamp(Components[i] * Sign * UE_DOUBLE_SQRT_2 * 0.5 + 0.5, 0.0, 1.0);
+				PackedRotation |= static_cast<uint32>(FMath::RoundToInt(Normalized * 1023)) << Shift;
+				Shift -= 10;
+			}
+		}
+		OutValues[2] = static_cast<int32>(PackedRotation);
+
+		const float Scale = Scale3D.GetAbsMax() * ScaleSign;
+		FMemory::Memcpy(&OutValues[3], &Scale, sizeof(float));
+
+		return true;
+	}
+
+	/**
+	 * Decodes a transform written by EncodeCompactTransform.
+	 *
+	 * @param Values The encoded transform
+	 * @param TileOrigin The origin the position is relative to
+	 * @param PositionStep The world space size of one fixed point position step
+	 *
+	 * @return The decoded transform
+	 *
+	 * @throws None
+	 */
+	static FORCEINLINE_DEBUGGABLE FTransform DecodeCompactTransform(const int32* Values, const FVector& TileOrigin,
+	                                                                const double PositionStep)
+	{
+		constexpr uint32 PositionMask = (1 << CompactPositionBits) - 1;
+		const uint32 Low = static_cast<uint32>(Values[0]);
+		const uint32 High = static_cast<uint32>(Values[1]);
+		const int32 X = Low & PositionMask;
+		const int32 Y = (Low >> CompactPositionBits | High << (32 - CompactPositionBits)) & PositionMask;
+		const int32 Z = High >> (CompactPositionBits * 2 - 32) & PositionMask;
+		const FVector Location = TileOrigin + FVector(X - CompactPositionBias, Y - CompactPositionBias,
+		                                              Z - CompactPositionBias) * PositionStep;
+
+		const uint32 PackedRotation = static_cast<uint32>(Values[2]);
+		const int32 LargestIndex = PackedRotation >> 30;
+		double Components[4];
+		double SquaredSum = 0;
+		for (int32 i = 0, Shift = 20; i < 4; ++i)
+		{
+			if (i != LargestIndex)
+			{
+				Components[i] = ((PackedRotation >> Shift & 1023) / 1023.0 - 0.5) * 2.0 / UE_DOUBLE_SQRT_2;
+				SquaredSum += Components[i] * Components[i];
+				Shift -= 10;
+			}
+		}
+		Components[LargestIndex] = FMath::Sqrt(FMath::Max(1.0 - SquaredSum, 0.0));
+		const FQuat Rotation = FQuat(Components[0], Components[1], Components[2], Components[3]).GetNormalized();
+
+		float Scale;
+		FMemory::Memcpy(&Scale, &Values[3], sizeof(float));
+
+		return FTransform(Rotation, Location, FVector(Scale));
+	}
+
 	template <typename TValue>
 	static FORCEINLINE_DEBUGGABLE void CheckArrayHasSize(TArray<TValue>& Array)
 	{
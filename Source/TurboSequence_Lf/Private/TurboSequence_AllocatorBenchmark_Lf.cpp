@@ -0,0 +1,85 @@
+// Copyright Lukas Fratzl, 2022-2024. All Rights Reserved.
+
+#include "TurboSequence_Data_Lf.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Churns the bone texture allocator with spawn and despawn cycles of mixed skeleton sizes,
+// like a crowd where characters with different rigs come and go
+static void RunBoneTextureAllocatorBenchmark_Lf(const TArray<FString>& Args)
+{
+	const int32 NumCycles = Args.Num() ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000000;
+
+	// GPU bones of typical rigs, times 3 rows for translation, rotation and scale
+	const int32 SkeletonSizes[] = {24 * 3, 55 * 3, 68 * 3, 120 * 3, 250 * 3};
+
+	using FBoneTextureAllocator_Lf = decltype(FSkinnedMeshGlobalLibrary_Lf::BoneTextureAllocator);
+	TUniquePtr<FBoneTextureAllocator_Lf> Allocator = MakeUnique<FBoneTextureAllocator_Lf>(512 * 512);
+
+	// Keeps the live crowd between the two sizes, so the texture runs mostly full
+	const int32 MinLiveInstances = 350;
+	const int32 MaxLiveInstances = 750;
+
+	FRandomStream RandomStream(NumCycles);
+	TArray<TPair<int32, int32>> LiveInstances;
+	LiveInstances.Reserve(MaxLiveInstances);
+
+	int32 NumFailedAllocations = 0;
+	float MaxFragmentation = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+	{
+		const bool bSpawn = LiveInstances.Num() < MinLiveInstances ||
+			(LiveInstances.Num() < MaxLiveInstances && RandomStream.FRand() < 0.5f);
+		if (bSpawn)
+		{
+			const int32 Size = SkeletonSizes[RandomStream.RandHelper(UE_ARRAY_COUNT(SkeletonSizes))];
+			const int32 Index = Allocator->Allocate(Size);
+			if (Index == INDEX_NONE)
+			{
+				NumFailedAllocations++;
+				continue;
+			}
+			LiveInstances.Add({Index, Size});
+		}
+		else
+		{
+			const int32 InstanceIndex = RandomStream.RandHelper(LiveInstances.Num());
+			Allocator->Free(LiveInstances[InstanceIndex].Key, LiveInstances[InstanceIndex].Value);
+			LiveInstances.RemoveAtSwap(InstanceIndex);
+		}
+
+		if (Cycle % 1024 == 0)
+		{
+			MaxFragmentation = FMath::Max(MaxFragmentation, Allocator->GetFragmentation());
+		}
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	const bool bValid = Allocator->Validate();
+
+	UE_LOG(LogTurboSequence_Lf, Display,
+	       TEXT("Bone Texture Allocator | %d Cycles in %.2f ms (%.1f ns per cycle) | %d failed | %d live | %d free in %d ranges, largest %d | Fragmentation %.1f %% (max %.1f %%) | %s"),
+	       NumCycles, ElapsedTime * 1000.0, ElapsedTime * 1e9 / NumCycles, NumFailedAllocations, LiveInstances.Num(),
+	       Allocator->GetFreeSize(), Allocator->GetNumFreeRanges(), Allocator->GetLargestFreeSize(),
+	       Allocator->GetFragmentation() * 100.0f, MaxFragmentation * 100.0f, bValid ? TEXT("Valid") : TEXT("CORRUPTED"));
+
+	// Everything freed has to coalesce back into one range
+	for (const TPair<int32, int32>& LiveInstance : LiveInstances)
+	{
+		Allocator->Free(LiveInstance.Key, LiveInstance.Value);
+	}
+	if (Allocator->GetNumFreeRanges() != 1 || !Allocator->Validate())
+	{
+		UE_LOG(LogTurboSequence_Lf, Error, TEXT("Bone Texture Allocator didn't coalesce back into a single range, %d ranges left"),
+		       Allocator->GetNumFreeRanges());
+	}
+}
+
+static FAutoConsoleCommand BoneTextureAllocatorBenchmarkCommand_Lf(
+	TEXT("TurboSequence.BenchmarkBoneTextureAllocator"),
+	TEXT("Runs spawn and despawn cycles with mixed skeleton sizes on the bone texture allocator and reports fragmentation. Optional argument: cycles"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunBoneTextureAllocatorBenchmark_Lf));
+
+#endif
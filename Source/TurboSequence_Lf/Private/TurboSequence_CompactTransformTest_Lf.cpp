@@ -0,0 +1,64 @@
+// Copyright Lukas Fratzl, 2022-2024. All Rights Reserved.
+
+#include "TurboSequence_Helper_Lf.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Encodes and decodes random transforms around a tile and reports the worst position, rotation and scale error
+static void RunCompactTransformRoundTrip_Lf(const TArray<FString>& Args)
+{
+	const int32 NumTransforms = Args.Num() ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000;
+	const double PositionStep = Args.Num() > 1 ? FMath::Max(FCString::Atod(*Args[1]), 0.01) : 0.1;
+
+	const double TileExtent = (FTurboSequence_Helper_Lf::CompactPositionBias - 1) * PositionStep;
+	const FVector TileOrigin = FVector(250000, -125000, 500).GridSnap(PositionStep);
+
+	FRandomStream RandomStream(NumTransforms);
+
+	double MaxPositionError = 0;
+	double MaxRotationErrorDegrees = 0;
+	double MaxScaleError = 0;
+	int32 NumOutOfRange = 0;
+	for (int32 TransformIndex = 0; TransformIndex < NumTransforms; ++TransformIndex)
+	{
+		const FVector Location = TileOrigin + FVector(RandomStream.FRandRange(-TileExtent, TileExtent),
+		                                              RandomStream.FRandRange(-TileExtent, TileExtent),
+		                                              RandomStream.FRandRange(-TileExtent, TileExtent));
+		const FQuat Rotation = FRotator(RandomStream.FRandRange(-90, 90), RandomStream.FRandRange(-180, 180),
+		                                RandomStream.FRandRange(-180, 180)).Quaternion();
+		const FTransform Transform(Rotation, Location, FVector(RandomStream.FRandRange(0.1, 10)));
+
+		int32 EncodedTransform[FTurboSequence_Helper_Lf::NumCompactTransformValues];
+		if (!FTurboSequence_Helper_Lf::EncodeCompactTransform(EncodedTransform, Transform, TileOrigin, PositionStep))
+		{
+			NumOutOfRange++;
+			continue;
+		}
+		const FTransform Decoded = FTurboSequence_Helper_Lf::DecodeCompactTransform(EncodedTransform, TileOrigin,
+		                                                                           PositionStep);
+
+		MaxPositionError = FMath::Max(MaxPositionError, FVector::Dist(Decoded.GetLocation(), Location));
+		MaxRotationErrorDegrees = FMath::Max(MaxRotationErrorDegrees,
+		                                     FMath::RadiansToDegrees(Decoded.GetRotation().AngularDistance(Rotation)));
+		MaxScaleError = FMath::Max(MaxScaleError, FMath::Abs(Decoded.GetScale3D().X - Transform.GetScale3D().X));
+	}
+
+	// Half a step per axis and the rotation quantization of 10 bits per component
+	const double MaxExpectedPositionError = PositionStep * 0.5 * UE_DOUBLE_SQRT_3 + UE_KINDA_SMALL_NUMBER;
+	const double MaxExpectedRotationErrorDegrees = 0.25;
+	const bool bPassed = !NumOutOfRange && MaxPositionError <= MaxExpectedPositionError &&
+		MaxRotationErrorDegrees <= MaxExpectedRotationErrorDegrees && MaxScaleError <= UE_KINDA_SMALL_NUMBER;
+
+	UE_LOG(LogTurboSequence_Lf, Display,
+	       TEXT("Compact Transform | %d Transforms, step %.3f cm | Max position error %.4f cm (limit %.4f) | Max rotation error %.4f deg (limit %.2f) | Max scale error %.6f | %d out of range | %s"),
+	       NumTransforms, PositionStep, MaxPositionError, MaxExpectedPositionError, MaxRotationErrorDegrees,
+	       MaxExpectedRotationErrorDegrees, MaxScaleError, NumOutOfRange, bPassed ? TEXT("Passed") : TEXT("FAILED"));
+}
+
+static FAutoConsoleCommand CompactTransformRoundTripCommand_Lf(
+	TEXT("TurboSequence.TestCompactTransforms"),
+	TEXT("Round trips random transforms through the compact instance transform encoding and checks the error. Optional arguments: transforms, position step"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunCompactTransformRoundTrip_Lf));
+
+#endif
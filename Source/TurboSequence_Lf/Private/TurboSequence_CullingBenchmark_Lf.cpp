@@ -0,0 +1,109 @@
+// Copyright Lukas Fratzl, 2022-2024. All Rights Reserved.
+
+#include "TurboSequence_Data_Lf.h"
+#include "TurboSequence_MeshAsset_Lf.h"
+#include "TurboSequence_Utility_Lf.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+// The per mesh box test the batched culling replaced, kept as the scalar reference
+static bool IsMeshVisible_Lf(const FSkinnedMeshRuntime_Lf& Runtime, const TArray<FCameraView_Lf>& PlayerViews)
+{
+	const FVector& MeshLocation = Runtime.WorldSpaceTransform.GetLocation();
+	const FBoxSphereBounds& Bounds = Runtime.DataAsset->StaticMesh->GetBounds();
+	const FBox Box(MeshLocation - Bounds.BoxExtent, MeshLocation + Bounds.BoxExtent);
+
+	bool bIsVisibleOnAnyCamera = false;
+	for (const FCameraView_Lf& View : PlayerViews)
+	{
+		if (FTurboSequence_Helper_Lf::Box_Intersects_With_Frustum(Box, View.Planes_Internal,
+		                                                          View.InterpolatedCameraTransform_Internal,
+		                                                          Bounds.SphereRadius))
+		{
+			bIsVisibleOnAnyCamera = true;
+			break;
+		}
+	}
+
+	return bIsVisibleOnAnyCamera;
+}
+
+// Compares the grid and batched SIMD culling with the per mesh box test on a random crowd around a single camera
+static void RunCullingBenchmark_Lf(const TArray<FString>& Args)
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!IsValid(CubeMesh))
+	{
+		UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't run the culling benchmark, the engine cube mesh is missing..."));
+		return;
+	}
+
+	UTurboSequence_MeshAsset_Lf* MeshAsset = NewObject<UTurboSequence_MeshAsset_Lf>();
+	MeshAsset->StaticMesh = CubeMesh;
+
+	FCameraView_Lf View;
+	View.ViewportSize = FVector2f(1920, 1080);
+	View.Fov = 90;
+	View.FarClipPlane = 50000;
+	View.InterpolatedCameraTransform_Internal = FTransform::Identity;
+	FTurboSequence_Helper_Lf::GetCameraFrustumPlanes_ObjectSpace(View.Planes_Internal, View.Fov, View.ViewportSize,
+	                                                             View.AspectRatioAxisConstraint, View.NearClipPlane,
+	                                                             View.FarClipPlane, !View.bIsPerspective, View.OrthoWidth);
+	FTurboSequence_Utility_Lf::UpdateCullingPlanes(View);
+
+	const TArray<FCameraView_Lf> Views = {View};
+
+	const int32 NumIterations = Args.Num() ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 20;
+	for (const int32 NumInstances : {1000, 10000, 100000})
+	{
+		FRandomStream RandomStream(NumInstances);
+
+		FSkinnedMeshRuntimeStore_Lf Store;
+		for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+		{
+			const FBaseSkeletalMeshHandle MeshID = Store.AllocateHandle();
+			FSkinnedMeshRuntime_Lf Runtime(MeshID, MeshAsset, FTurboSequenceRenderHandle(), INDEX_NONE);
+			Runtime.WorldSpaceTransform.SetLocation(RandomStream.VRand() * RandomStream.FRandRange(0, 60000));
+			Store.Add(MeshID, Runtime);
+		}
+
+		int32 NumVisibleScalar = 0;
+		const double ScalarStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			NumVisibleScalar = 0;
+			for (const FSkinnedMeshRuntime_Lf& Runtime : Store)
+			{
+				NumVisibleScalar += IsMeshVisible_Lf(Runtime, Views);
+			}
+		}
+		const double ScalarTime = (FPlatformTime::Seconds() - ScalarStartTime) / NumIterations;
+
+		const double BatchedStartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			FTurboSequence_Utility_Lf::CullSpatialCells(Store, Views);
+			FTurboSequence_Utility_Lf::CullMeshes(Store, Views, 0, Store.Num());
+		}
+		const double BatchedTime = (FPlatformTime::Seconds() - BatchedStartTime) / NumIterations;
+
+		int32 NumVisibleBatched = 0;
+		for (int32 DenseIndex = 0; DenseIndex < Store.Num(); ++DenseIndex)
+		{
+			NumVisibleBatched += Store.IsVisible(DenseIndex);
+		}
+
+		UE_LOG(LogTurboSequence_Lf, Display,
+		       TEXT("Culling %d Instances | Scalar %.3f ms (%d visible) | Batched %.3f ms (%d visible) | %.1fx"),
+		       NumInstances, ScalarTime * 1000.0, NumVisibleScalar, BatchedTime * 1000.0, NumVisibleBatched,
+		       ScalarTime / FMath::Max(BatchedTime, UE_SMALL_NUMBER));
+	}
+}
+
+static FAutoConsoleCommand CullingBenchmarkCommand_Lf(
+	TEXT("TurboSequence.BenchmarkCulling"),
+	TEXT("Compares the batched SIMD frustum culling against the per mesh box test at 1k, 10k and 100k instances. Optional argument: iterations"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunCullingBenchmark_Lf));
+
+#endif
@@ -4,15 +4,27 @@
 #include "TurboSequence_Data_Lf.h"
 
 #include "NiagaraComponent.h"
+#include "TurboSequence_MeshAsset_Lf.h"
 
 void UTurboSequenceRenderAttachmentData::PrintRenderData() const
 {
 	Super::PrintRenderData();
-	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow, FString::Printf(TEXT("Attachment Position %d, Rotation %d, Scale %d"),bChangedParticleAttachmentPosition, bChangedParticleAttachmentRotation, bChangedParticleAttachmentScale ));
+	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow, FString::Printf(TEXT("Attachment Position %d, Rotation %d, Scale %d"),DirtyAttachmentPositions.Num(), DirtyAttachmentRotations.Num(), DirtyAttachmentScales.Num()));
 }
 
 
 
+const FTurboSequence_BakedAnimation_Lf* FAnimationLibraryData_Lf::GetBakedAnimation() const
+{
+	if (BakedAnimationIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const UTurboSequence_MeshAsset_Lf* Asset = BakedAnimationAsset.Get();
+	return Asset ? Asset->GetBakedAnimation(BakedAnimationIndex, BakedAnimationSequence.Get(), MaxFrames, NumBones) : nullptr;
+}
+
 int32 FSkinnedMeshRuntime_Lf::GetAnimIndex(FAnimationMetaDataHandle AnimationMetaDataHandle) const
 {
 	return AnimationMetaData.IndexOfByPredicate([&](const FAnimationMetaData_Lf& MetaData) {
@@ -86,3 +98,316 @@ bool FSkinnedMeshRuntime_Lf::RemoveAttachedParticle(UNiagaraComponent* NiagaraCo
 	
 	return bRemoved;
 }
+
+
+FBaseSkeletalMeshHandle FSkinnedMeshRuntimeStore_Lf::AllocateHandle()
+{
+	int32 Slot = FreeSlotHead;
+	if (Slot != INDEX_NONE)
+	{
+		FreeSlotHead = Slots[Slot].NextFreeSlot;
+		if (FreeSlotHead == INDEX_NONE)
+		{
+			FreeSlotTail = INDEX_NONE;
+		}
+		Slots[Slot].NextFreeSlot = INDEX_NONE;
+	}
+	else
+	{
+		if (Slots.Num() >= MaxSlots)
+		{
+			UE_LOG(LogTurboSequence_Lf, Error, TEXT("Can't create Mesh Instance, all %d mesh slots are in use..."), MaxSlots);
+			return FBaseSkeletalMeshHandle();
+		}
+
+		Slot = Slots.AddDefaulted();
+	}
+
+	return FBaseSkeletalMeshHandle(Slot | Slots[Slot].Generation << NumSlotBits);
+}
+
+FSkinnedMeshRuntime_Lf& FSkinnedMeshRuntimeStore_Lf::Add(const FBaseSkeletalMeshHandle Handle,
+                                                         const FSkinnedMeshRuntime_Lf& Runtime)
+{
+	const int32 Slot = GetSlot(Handle);
+	check(Slots.IsValidIndex(Slot) && Slots[Slot].Generation == GetGeneration(Handle) && Slots[Slot].DenseIndex == INDEX_NONE);
+
+	const int32 DenseIndex = Runtimes.Add(Runtime);
+	DenseToSlot.Add(Slot);
+	VisibleFlags.Add(true);
+	CullingCentersX.AddUninitialized();
+	CullingCentersY.AddUninitialized();
+	CullingCentersZ.AddUninitialized();
+	CullingRadii.AddUninitialized();
+	SpatialCellIndices.Add(INDEX_NONE);
+	SpatialCellSlots.Add(INDEX_NONE);
+
+	Slots[Slot].DenseIndex = DenseIndex;
+
+	UpdateCullingBounds(DenseIndex);
+
+	return Runtimes[DenseIndex];
+}
+
+bool FSkinnedMeshRuntimeStore_Lf::Remove(const FBaseSkeletalMeshHandle Handle)
+{
+	const int32 DenseIndex = GetDenseIndex(Handle);
+	if (DenseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemoveFromSpatialCell(DenseIndex);
+
+	// Move the last runtime into the hole to keep the dense arrays packed
+	const int32 LastDenseIndex = Runtimes.Num() - 1;
+	if (DenseIndex != LastDenseIndex)
+	{
+		const int32 MovedSlot = DenseToSlot[LastDenseIndex];
+		Slots[MovedSlot].DenseIndex = DenseIndex;
+		DenseToSlot[DenseIndex] = MovedSlot;
+		VisibleFlags[DenseIndex] = VisibleFlags[LastDenseIndex];
+	}
+	Runtimes.RemoveAtSwap(DenseIndex);
+	DenseToSlot.RemoveAt(LastDenseIndex);
+	VisibleFlags.RemoveAt(LastDenseIndex);
+	CullingCentersX.RemoveAtSwap(DenseIndex);
+	CullingCentersY.RemoveAtSwap(DenseIndex);
+	CullingCentersZ.RemoveAtSwap(DenseIndex);
+	CullingRadii.RemoveAtSwap(DenseIndex);
+	SpatialCellIndices.RemoveAtSwap(DenseIndex);
+	SpatialCellSlots.RemoveAtSwap(DenseIndex);
+
+	const int32 Slot = GetSlot(Handle);
+	FSlot_Lf& FreedSlot = Slots[Slot];
+	FreedSlot.DenseIndex = INDEX_NONE;
+	FreedSlot.Generation = (FreedSlot.Generation + 1) & ((1 << NumGenerationBits) - 1);
+
+	if (FreeSlotTail != INDEX_NONE)
+	{
+		Slots[FreeSlotTail].NextFreeSlot = Slot;
+	}
+	else
+	{
+		FreeSlotHead = Slot;
+	}
+	FreeSlotTail = Slot;
+
+	return true;
+}
+
+void FSkinnedMeshRuntimeStore_Lf::Empty()
+{
+	Slots.Empty();
+	FreeSlotHead = INDEX_NONE;
+	FreeSlotTail = INDEX_NONE;
+	Runtimes.Empty();
+	DenseToSlot.Empty();
+	VisibleFlags.Empty();
+	CullingCentersX.Empty();
+	CullingCentersY.Empty();
+	CullingCentersZ.Empty();
+	CullingRadii.Empty();
+	SpatialCells.Empty();
+	SpatialCellLookup.Empty();
+	FreeSpatialCells.Empty();
+	SpatialCellVisibleFlags.Empty();
+	SpatialCellIndices.Empty();
+	SpatialCellSlots.Empty();
+}
+
+void FSkinnedMeshRuntimeStore_Lf::Reserve(const int32 NumRuntimes)
+{
+	Slots.Reserve(FMath::Min(NumRuntimes, MaxSlots));
+	Runtimes.Reserve(NumRuntimes);
+	DenseToSlot.Reserve(NumRuntimes);
+	VisibleFlags.Reserve(NumRuntimes);
+	CullingCentersX.Reserve(NumRuntimes);
+	CullingCentersY.Reserve(NumRuntimes);
+	CullingCentersZ.Reserve(NumRuntimes);
+	CullingRadii.Reserve(NumRuntimes);
+	SpatialCellIndices.Reserve(NumRuntimes);
+	SpatialCellSlots.Reserve(NumRuntimes);
+}
+
+void FSkinnedMeshRuntimeStore_Lf::UpdateCullingBounds(const int32 DenseIndex)
+{
+	const FSkinnedMeshRuntime_Lf& Runtime = Runtimes[DenseIndex];
+	const FVector& MeshLocation = Runtime.WorldSpaceTransform.GetLocation();
+
+	CullingCentersX[DenseIndex] = MeshLocation.X;
+	CullingCentersY[DenseIndex] = MeshLocation.Y;
+	CullingCentersZ[DenseIndex] = MeshLocation.Z;
+	CullingRadii[DenseIndex] = Runtime.DataAsset->GetCullingSphereRadius() * Runtime.WorldSpaceTransform.GetMaximumAxisScale();
+
+	const FIntVector Coordinates = GetSpatialCellCoordinates(MeshLocation);
+	if (SpatialCellIndices[DenseIndex] == INDEX_NONE)
+	{
+		AddToSpatialCell(DenseIndex, Coordinates);
+	}
+	else if (SpatialCells[SpatialCellIndices[DenseIndex]].Coordinates != Coordinates)
+	{
+		RemoveFromSpatialCell(DenseIndex);
+		AddToSpatialCell(DenseIndex, Coordinates);
+	}
+	else
+	{
+		FSpatialGridCell_Lf& Cell = SpatialCells[SpatialCellIndices[DenseIndex]];
+		Cell.MaxRadius = FMath::Max(Cell.MaxRadius, CullingRadii[DenseIndex]);
+	}
+}
+
+void FSkinnedMeshRuntimeStore_Lf::SetSpatialGridCellSize(const double InCellSize)
+{
+	if (!Runtimes.Num() && InCellSize > 0)
+	{
+		SpatialGridCellSize = InCellSize;
+	}
+}
+
+void FSkinnedMeshRuntimeStore_Lf::AddToSpatialCell(const int32 DenseIndex, const FIntVector& Coordinates)
+{
+	int32 CellIndex;
+	if (const int32* ExistingCellIndex = SpatialCellLookup.Find(Coordinates))
+	{
+		CellIndex = *ExistingCellIndex;
+	}
+	else
+	{
+		if (FreeSpatialCells.Num())
+		{
+			CellIndex = FreeSpatialCells.Pop();
+			// A recycled cell may still carry a culled flag from its previous coordinates
+			SpatialCellVisibleFlags[CellIndex] = true;
+		}
+		else
+		{
+			CellIndex = SpatialCells.AddDefaulted();
+			SpatialCellVisibleFlags.Add(true);
+		}
+		SpatialCells[CellIndex].Coordinates = Coordinates;
+		SpatialCellLookup.Add(Coordinates, CellIndex);
+	}
+
+	FSpatialGridCell_Lf& Cell = SpatialCells[CellIndex];
+	SpatialCellIndices[DenseIndex] = CellIndex;
+	SpatialCellSlots[DenseIndex] = Cell.Meshes.Add(Runtimes[DenseIndex].MeshID);
+	Cell.MaxRadius = FMath::Max(Cell.MaxRadius, CullingRadii[DenseIndex]);
+}
+
+void FSkinnedMeshRuntimeStore_Lf::RemoveFromSpatialCell(const int32 DenseIndex)
+{
+	const int32 CellIndex = SpatialCellIndices[DenseIndex];
+	if (CellIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FSpatialGridCell_Lf& Cell = SpatialCells[CellIndex];
+	const int32 CellSlot = SpatialCellSlots[DenseIndex];
+	Cell.Meshes.RemoveAtSwap(CellSlot);
+	if (Cell.Meshes.IsValidIndex(CellSlot))
+	{
+		SpatialCellSlots[GetDenseIndex(Cell.Meshes[CellSlot])] = CellSlot;
+	}
+
+	if (!Cell.Meshes.Num())
+	{
+		SpatialCellLookup.Remove(Cell.Coordinates);
+		FreeSpatialCells.Add(CellIndex);
+		// The loose radius only shrinks once a cell is empty
+		Cell.MaxRadius = 0;
+	}
+
+	SpatialCellIndices[DenseIndex] = INDEX_NONE;
+	SpatialCellSlots[DenseIndex] = INDEX_NONE;
+}
+
+template <typename Predicate>
+void FSkinnedMeshRuntimeStore_Lf::QueryMeshesInCellRange(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs,
+                                                         const FVector& Min, const FVector& Max,
+                                                         const Predicate& IsInside) const
+{
+	const FIntVector MinCoordinates = GetSpatialCellCoordinates(Min);
+	const FIntVector MaxCoordinates = GetSpatialCellCoordinates(Max);
+
+	// Huge queries visit the used cells instead of every coordinate of the range
+	const int64 NumRangeCells = (static_cast<int64>(MaxCoordinates.X) - MinCoordinates.X + 1) *
+		(static_cast<int64>(MaxCoordinates.Y) - MinCoordinates.Y + 1) *
+		(static_cast<int64>(MaxCoordinates.Z) - MinCoordinates.Z + 1);
+
+	auto GatherCell = [&](const FSpatialGridCell_Lf& Cell)
+	{
+		for (const FBaseSkeletalMeshHandle& MeshID : Cell.Meshes)
+		{
+			const int32 DenseIndex = GetDenseIndex(MeshID);
+			if (IsInside(FVector(CullingCentersX[DenseIndex], CullingCentersY[DenseIndex], CullingCentersZ[DenseIndex])))
+			{
+				OutMeshIDs.Add(MeshID);
+			}
+		}
+	};
+
+	if (NumRangeCells > SpatialCellLookup.Num())
+	{
+		for (const TTuple<FIntVector, int32>& CellLookup : SpatialCellLookup)
+		{
+			const FIntVector& Coordinates = CellLookup.Key;
+			if (Coordinates.X >= MinCoordinates.X && Coordinates.X <= MaxCoordinates.X &&
+				Coordinates.Y >= MinCoordinates.Y && Coordinates.Y <= MaxCoordinates.Y &&
+				Coordinates.Z >= MinCoordinates.Z && Coordinates.Z <= MaxCoordinates.Z)
+			{
+				GatherCell(SpatialCells[CellLookup.Value]);
+			}
+		}
+		return;
+	}
+
+	for (int32 Z = MinCoordinates.Z; Z <= MaxCoordinates.Z; ++Z)
+	{
+		for (int32 Y = MinCoordinates.Y; Y <= MaxCoordinates.Y; ++Y)
+		{
+			for (int32 X = MinCoordinates.X; X <= MaxCoordinates.X; ++X)
+			{
+				if (const int32* CellIndex = SpatialCellLookup.Find(FIntVector(X, Y, Z)))
+				{
+					GatherCell(SpatialCells[*CellIndex]);
+				}
+			}
+		}
+	}
+}
+
+void FSkinnedMeshRuntimeStore_Lf::QueryMeshesInRadius(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs,
+                                                      const FVector& Location, const double Radius) const
+{
+	const double RadiusSquared = Radius * Radius;
+	QueryMeshesInCellRange(OutMeshIDs, Location - Radius, Location + Radius, [&](const FVector& MeshLocation)
+	{
+		return FVector::DistSquared(MeshLocation, Location) <= RadiusSquared;
+	});
+}
+
+void FSkinnedMeshRuntimeStore_Lf::QueryMeshesInBox(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs, const FBox& Box) const
+{
+	QueryMeshesInCellRange(OutMeshIDs, Box.Min, Box.Max, [&](const FVector& MeshLocation)
+	{
+		return Box.IsInsideOrOn(MeshLocation);
+	});
+}
+
+int32 FSkinnedMeshRuntimeStore_Lf::GetDenseIndex(const FBaseSkeletalMeshHandle Handle) const
+{
+	if (!Handle.IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Slot = GetSlot(Handle);
+	if (!Slots.IsValidIndex(Slot) || Slots[Slot].Generation != GetGeneration(Handle))
+	{
+		return INDEX_NONE;
+	}
+
+	return Slots[Slot].DenseIndex;
+}
@@ -0,0 +1,109 @@
+// Copyright Lukas Fratzl, 2022-2024. All Rights Reserved.
+
+#include "TurboSequence_Data_Lf.h"
+#include "TurboSequence_Utility_Lf.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Largest difference between the rows the animation library stores of two bone matrices
+static double GetMaxKeyframeBoneError_Lf(const FMatrix& A, const FMatrix& B)
+{
+	double MaxError = 0;
+	for (uint8 Row = 0; Row < 4; ++Row)
+	{
+		for (uint8 M = 0; M < 3; ++M)
+		{
+			MaxError = FMath::Max(MaxError, FMath::Abs(A.M[Row][M] - B.M[Row][M]));
+		}
+	}
+	return MaxError;
+}
+
+// Writes random keyframe bones as library texels, decomposes them and compares the blend input with the matrix path
+// the blends used before, and the texels an evicted keyframe writes again with the texels of the original bone
+static void RunDecomposedKeyframeTest_Lf(const TArray<FString>& Args)
+{
+	const int32 NumKeyframes = Args.Num() ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+	constexpr uint16 NumBones = 3;
+	const TCHAR* ScaleNames[NumBones] = {TEXT("uniform"), TEXT("non uniform"), TEXT("negative axis")};
+
+	FAnimationLibraryData_Lf LibraryAnimData;
+	LibraryAnimData.NumBones = NumBones;
+	LibraryAnimData.MaxFrames = NumKeyframes;
+
+	FRandomStream RandomStream(NumKeyframes);
+
+	// One bone per kind of scale, so every keyframe covers all of them
+	double MaxBlendError[NumBones] = {};
+	double MaxRewriteError[NumBones] = {};
+	for (int32 CPUIndex = 0; CPUIndex < NumKeyframes; ++CPUIndex)
+	{
+		for (uint16 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			FVector Scale = FVector(RandomStream.FRandRange(0.1, 10));
+			if (BoneIndex > 0)
+			{
+				Scale = FVector(RandomStream.FRandRange(0.1, 10), RandomStream.FRandRange(0.1, 10), RandomStream.FRandRange(0.1, 10));
+			}
+			if (BoneIndex > 1)
+			{
+				Scale[RandomStream.RandHelper(3)] *= -1;
+			}
+			const FQuat Rotation = FRotator(RandomStream.FRandRange(-90, 90), RandomStream.FRandRange(-180, 180),
+			                                RandomStream.FRandRange(-180, 180)).Quaternion();
+			const FVector Translation = RandomStream.VRand() * RandomStream.FRandRange(0, 100);
+			const FMatrix BoneMatrix = FTransform(Rotation, Translation, Scale).ToMatrixWithScale();
+
+			// Same layout the library texels are written in
+			FVector4f Colums[3];
+			for (uint8 M = 0; M < 3; ++M)
+			{
+				Colums[M] = FVector4f(BoneMatrix.M[0][M], BoneMatrix.M[1][M], BoneMatrix.M[2][M], BoneMatrix.M[3][M]);
+			}
+			FTurboSequence_Utility_Lf::DecomposeKeyframeBone(LibraryAnimData, CPUIndex, BoneIndex, Colums);
+
+			// The matrix path read the texels back and let the blend decompose them on every query
+			FMatrix TexelMatrix = FMatrix::Identity;
+			for (uint8 M = 0; M < 3; ++M)
+			{
+				TexelMatrix.M[0][M] = Colums[M].X;
+				TexelMatrix.M[1][M] = Colums[M].Y;
+				TexelMatrix.M[2][M] = Colums[M].Z;
+				TexelMatrix.M[3][M] = Colums[M].W;
+			}
+			const FMatrix MatrixPath = FTransform(TexelMatrix).ToMatrixWithScale();
+
+			const int32 KeyframeBoneIndex = CPUIndex * NumBones + BoneIndex;
+			const FMatrix Decomposed = FTransform(FQuat(LibraryAnimData.KeyframeRotations[KeyframeBoneIndex]),
+			                                      FVector(LibraryAnimData.KeyframeTranslations[KeyframeBoneIndex]),
+			                                      FVector(LibraryAnimData.KeyframeScales[KeyframeBoneIndex])).ToMatrixWithScale();
+
+			MaxBlendError[BoneIndex] = FMath::Max(MaxBlendError[BoneIndex], GetMaxKeyframeBoneError_Lf(Decomposed, MatrixPath));
+			MaxRewriteError[BoneIndex] = FMath::Max(MaxRewriteError[BoneIndex], GetMaxKeyframeBoneError_Lf(Decomposed, TexelMatrix));
+		}
+	}
+
+	// Float texels of a scale up to 10 and a translation up to 100
+	constexpr double MaxExpectedError = 1e-3;
+	bool bPassed = true;
+	for (uint16 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+	{
+		const bool bScalePassed = MaxBlendError[BoneIndex] <= MaxExpectedError && MaxRewriteError[BoneIndex] <= MaxExpectedError;
+		bPassed &= bScalePassed;
+
+		UE_LOG(LogTurboSequence_Lf, Display,
+		       TEXT("Decomposed Keyframes | %d Keyframes, %s scale | Max error against the matrix path %.6f | Max error of the written texels %.6f (limit %.4f) | %s"),
+		       NumKeyframes, ScaleNames[BoneIndex], MaxBlendError[BoneIndex], MaxRewriteError[BoneIndex], MaxExpectedError,
+		       bScalePassed ? TEXT("Passed") : TEXT("FAILED"));
+	}
+
+	UE_LOG(LogTurboSequence_Lf, Display, TEXT("Decomposed Keyframes | %s"), bPassed ? TEXT("Passed") : TEXT("FAILED"));
+}
+
+static FAutoConsoleCommand DecomposedKeyframeTestCommand_Lf(
+	TEXT("TurboSequence.TestDecomposedKeyframes"),
+	TEXT("Round trips random keyframe bones with uniform, non uniform and negative axis scale through the decomposed keyframes and checks them against the matrix path. Optional argument: keyframes"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunDecomposedKeyframeTest_Lf));
+
+#endif
@@ -0,0 +1,78 @@
+// Copyright Lukas Fratzl, 2022-2024. All Rights Reserved.
+
+#include "TurboSequence_Data_Lf.h"
+#include "TurboSequence_MeshAsset_Lf.h"
+#include "TurboSequence_Utility_Lf.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Fills a small animation library, points a mesh at a stand in keyframe and lets it skip its solve,
+// the eviction for the next keyframe must not hand out the slot the mesh still samples
+static void RunKeyframeEvictionTest_Lf(const TArray<FString>& Args)
+{
+	constexpr uint16 NumBones = 4;
+	constexpr int32 KeyframeSize = NumBones * 3;
+	constexpr int32 NumKeyframes = 8;
+	constexpr int32 StandInCPUIndex = 4;
+	constexpr int32 MissingCPUIndex = 5;
+
+	TUniquePtr<FSkinnedMeshGlobalLibrary_Lf> Library = MakeUnique<FSkinnedMeshGlobalLibrary_Lf>();
+	Library->AnimationLibraryAllocator.Reset(KeyframeSize * NumKeyframes);
+
+	// Both entries exist before any reference into the map is taken, adding one can move the other
+	const FUintVector AnimationKey(1, 1, 1);
+	const FUintVector OtherAnimationKey(2, 2, 2);
+	Library->AnimationLibraryData.Add(AnimationKey);
+	Library->AnimationLibraryData.Add(OtherAnimationKey);
+
+	FAnimationLibraryData_Lf& LibraryAnimData = Library->AnimationLibraryData[AnimationKey];
+	LibraryAnimData.NumBones = NumBones;
+	LibraryAnimData.MaxFrames = NumKeyframes;
+	LibraryAnimData.KeyframesFilled.Init(INDEX_NONE, NumKeyframes);
+	LibraryAnimData.KeyframesLastUsedFrame.Init(1, NumKeyframes);
+	for (int32 CPUIndex = 0; CPUIndex < NumKeyframes; ++CPUIndex)
+	{
+		LibraryAnimData.KeyframesFilled[CPUIndex] = FTurboSequence_Utility_Lf::AllocateAnimationLibraryKeyframe(*Library, KeyframeSize);
+	}
+
+	// The missing keyframe got evicted and its slot went to another animation, so the library is full again
+	FAnimationLibraryData_Lf& OtherLibraryAnimData = Library->AnimationLibraryData[OtherAnimationKey];
+	OtherLibraryAnimData.NumBones = NumBones;
+	OtherLibraryAnimData.MaxFrames = 1;
+	OtherLibraryAnimData.KeyframesFilled.Init(LibraryAnimData.KeyframesFilled[MissingCPUIndex], 1);
+	OtherLibraryAnimData.KeyframesLastUsedFrame.Init(1, 1);
+	LibraryAnimData.KeyframesFilled[MissingCPUIndex] = INDEX_NONE;
+
+	// The stand in is the least recently used keyframe, without its GPU index in the mesh it would go first
+	const int32 StandInGPUIndex = LibraryAnimData.KeyframesFilled[StandInCPUIndex];
+	LibraryAnimData.KeyframesLastUsedFrame[StandInCPUIndex] = 0;
+
+	UTurboSequence_MeshAsset_Lf* MeshAsset = NewObject<UTurboSequence_MeshAsset_Lf>();
+	const FBaseSkeletalMeshHandle MeshID = Library->RuntimeSkinnedMeshes.AllocateHandle();
+	FSkinnedMeshRuntime_Lf& Runtime = Library->RuntimeSkinnedMeshes.Add(
+		MeshID, FSkinnedMeshRuntime_Lf(MeshID, MeshAsset, FTurboSequenceRenderHandle(), INDEX_NONE));
+	FAnimationMetaData_Lf& Animation = Runtime.AnimationMetaData.AddDefaulted_GetRef();
+	Animation.AnimationLibraryHash = AnimationKey;
+	Animation.CPUAnimationIndex_0 = Animation.CPUAnimationIndex_1 = MissingCPUIndex;
+	Animation.GPUAnimationIndex_0 = Animation.GPUAnimationIndex_1 = StandInGPUIndex;
+
+	// The mesh is deferred on the following frames, nothing stamps the stand in through a solve
+	Library->AnimationLibraryFrame = 10;
+	const int32 NewGPUIndex = FTurboSequence_Utility_Lf::AllocateAnimationLibraryKeyframe(*Library, KeyframeSize);
+
+	const bool bPassed = NewGPUIndex != INDEX_NONE && NewGPUIndex != StandInGPUIndex &&
+		LibraryAnimData.KeyframesFilled[StandInCPUIndex] == StandInGPUIndex;
+
+	UE_LOG(LogTurboSequence_Lf, Display,
+	       TEXT("Keyframe Eviction | Stand in slot %d | New keyframe slot %d | Stand in still resident %s | %s"),
+	       StandInGPUIndex, NewGPUIndex, LibraryAnimData.KeyframesFilled[StandInCPUIndex] == StandInGPUIndex ? TEXT("yes") : TEXT("no"),
+	       bPassed ? TEXT("Passed") : TEXT("FAILED"));
+}
+
+static FAutoConsoleCommand KeyframeEvictionTestCommand_Lf(
+	TEXT("TurboSequence.TestKeyframeEviction"),
+	TEXT("Fills a small animation library with a mesh deferred on a stand in keyframe and checks the eviction keeps the stand in resident"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunKeyframeEvictionTest_Lf));
+
+#endif
@@ -11,7 +11,9 @@
 #include "TurboSequence_Utility_Lf.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/SkeletalMeshSocket.h"
+#include "Engine/TextureRenderTarget2DArray.h"
 #include "NiagaraFunctionLibrary.h"
+#include "Async/ParallelFor.h"
 
 
 DECLARE_STATS_GROUP(TEXT("TurboSequenceManager_Lf"), STATGROUP_TurboSequenceManager_Lf, STATCAT_Advanced);
@@ -24,9 +26,56 @@ DECLARE_CYCLE_STAT(TEXT("Remove_TurboSequenceMeshInstances_Lf"), Remove_TurboSeq
 				   STATGROUP_TurboSequenceManager_Lf);
 DECLARE_CYCLE_STAT(TEXT("Solve_TurboSequenceMeshes_RT_Lf"), STAT_Solve_TurboSequenceMeshes_RT_Lf,
 				   STATGROUP_TurboSequenceManager_Lf);
+DECLARE_CYCLE_STAT(TEXT("BuildFrameSnapshot_TurboSequence_Lf"), STAT_BuildFrameSnapshot_TurboSequence_Lf,
+				   STATGROUP_TurboSequenceManager_Lf);
+DECLARE_CYCLE_STAT(TEXT("Solve_TurboSequenceMeshes_Worker_Lf"), STAT_Solve_TurboSequenceMeshes_Worker_Lf,
+				   STATGROUP_TurboSequenceManager_Lf);
+DECLARE_CYCLE_STAT(TEXT("Solve_TurboSequenceMeshes_Merge_Lf"), STAT_Solve_TurboSequenceMeshes_Merge_Lf,
+				   STATGROUP_TurboSequenceManager_Lf);
 
 DECLARE_DWORD_COUNTER_STAT(TEXT("Total Mesh Count"), STAT_TotalMeshCount, STATGROUP_TurboSequenceManager_Lf);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Visible Mesh Count"), STAT_VisibleMeshCount, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Solve Worker Count"), STAT_SolveWorkerCount, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Solve Worker Max Time (ms)"), STAT_SolveWorkerMaxTime, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Solve Worker Min Time (ms)"), STAT_SolveWorkerMinTime, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation LOD 0 Mesh Count"), STAT_AnimationLOD0MeshCount, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation LOD 1 Mesh Count"), STAT_AnimationLOD1MeshCount, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation LOD 2 Mesh Count"), STAT_AnimationLOD2MeshCount, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation LOD 3+ Mesh Count"), STAT_AnimationLOD3MeshCount, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skipped Animation Updates"), STAT_SkippedAnimationUpdates, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Reused Bone Texture Meshes"), STAT_ReusedBoneTextureMeshCount, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Budget Deferred Animation Updates"), STAT_BudgetDeferredAnimationUpdates, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Update Budget"), STAT_AnimationUpdateBudget, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bone Texture Free Size"), STAT_BoneTextureFreeSize, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bone Texture Largest Free Range"), STAT_BoneTextureLargestFreeRange, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bone Texture Free Ranges"), STAT_BoneTextureFreeRanges, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Bone Texture Fragmentation (%)"), STAT_BoneTextureFragmentation, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bone Texture Used Size"), STAT_BoneTextureUsedSize, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bone Texture High Water Mark"), STAT_BoneTextureHighWaterMark, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Transform Texture Slices"), STAT_TransformTextureSlices, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bone Texture Compactions"), STAT_BoneTextureCompactions, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Library Resident Keyframes"), STAT_AnimationLibraryResidentKeyframes, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Library Evicted Keyframes"), STAT_AnimationLibraryEvictedKeyframes, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Library Free Size"), STAT_AnimationLibraryFreeSize, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Keyframe Samples"), STAT_PendingKeyframeSamples, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Keyframe Sample Fallbacks"), STAT_KeyframeSampleFallbacks, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Group Meshes"), STAT_AnimationGroupMeshes, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Group Phases"), STAT_AnimationGroupPhases, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Niagara Array Written Bytes"), STAT_NiagaraArrayWrittenBytes, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Compacted Render Instances"), STAT_CompactedRenderInstances, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Notify Events"), STAT_AnimNotifyEvents, STATGROUP_TurboSequenceManager_Lf);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mesh Unit Upload Bytes"), STAT_MeshUnitUploadBytes, STATGROUP_TurboSequenceManager_Lf);
+
+static void IncAnimationLODStats_Lf(const FSkinnedMeshSolveShard_Lf& Shard)
+{
+	static_assert(FSkinnedMeshSolveShard_Lf::NumAnimationLODStats == 4, "One stat per animation LOD counter");
+
+	INC_DWORD_STAT_BY(STAT_AnimationLOD0MeshCount, Shard.NumMeshesPerAnimationLOD[0]);
+	INC_DWORD_STAT_BY(STAT_AnimationLOD1MeshCount, Shard.NumMeshesPerAnimationLOD[1]);
+	INC_DWORD_STAT_BY(STAT_AnimationLOD2MeshCount, Shard.NumMeshesPerAnimationLOD[2]);
+	INC_DWORD_STAT_BY(STAT_AnimationLOD3MeshCount, Shard.NumMeshesPerAnimationLOD[3]);
+	INC_DWORD_STAT_BY(STAT_SkippedAnimationUpdates, Shard.NumSkippedAnimationUpdates);
+}
 
 TObjectPtr<UTurboSequence_MeshAsset_Lf> ATurboSequence_Manager_Lf::AttachmentAsset;
 
@@ -102,13 +151,21 @@ void ATurboSequence_Manager_Lf::TickActor(float DeltaTime, ELevelTick TickType,
 
 	const float Time = TickType == LEVELTICK_All ? DeltaTime : 0.f;
 
-	SolveMeshes_GameThread(Time, World);
+	SolveMeshes_GameThread(Time, World, UKismetSystemLibrary::GetFrameCount());
 
 	for (const auto & PerReferenceData : GlobalLibrary.PerReferenceData)
 	{
 		//PerReferenceData.Value->PrintRenderData();
+
+		if (IsValid(GlobalData))
+		{
+			INC_DWORD_STAT_BY(STAT_CompactedRenderInstances,
+			                  PerReferenceData.Value->CompactRenderInstances(GlobalData->MaxRenderInstanceMovesPerFrame));
+		}
 			
 		PerReferenceData.Value->UpdateNiagaraEmitter();
+
+		INC_DWORD_STAT_BY(STAT_NiagaraArrayWrittenBytes, PerReferenceData.Value->GetWrittenBytesThisFrame());
 	}
 	
 	if (GlobalLibrary.RuntimeSkinnedMeshes.Num() && IsValid(GlobalData) && IsValid(GlobalData->AnimationLibraryTexture))
@@ -125,6 +182,7 @@ void ATurboSequence_Manager_Lf::TickActor(float DeltaTime, ELevelTick TickType,
 			[&Library_RenderThread](FRHICommandListImmediate& RHICmdList)
 			{
 				Library_RenderThread.AnimationLibraryParams.SettingsInput.Reset();
+				Library_RenderThread.AnimationLibraryParams.SettingsInputIndices.Reset();
 				Library_RenderThread.AnimationLibraryParams.AdditiveWriteBaseIndex = Library_RenderThread.
 					AnimationLibraryMaxNum;
 			});
@@ -133,6 +191,7 @@ void ATurboSequence_Manager_Lf::TickActor(float DeltaTime, ELevelTick TickType,
 		GlobalLibrary_RenderThread.BoneTransformParams.AnimationOutputTexturePrevious = GlobalData->
 			TransformTexture_PreviousFrame;
 
+		bFrameSnapshotAwaitsSolve = false;
 		FMeshUnit_Compute_Shader_Execute_Lf::Dispatch(
 			[&](FRHICommandListImmediate& RHICmdList)
 			{
@@ -155,6 +214,13 @@ void ATurboSequence_Manager_Lf::TickActor(float DeltaTime, ELevelTick TickType,
 				}
 #endif
 			});
+
+		ENQUEUE_RENDER_COMMAND(TurboSequence_MeshUnitUploadBytes_Lf)(
+			[&](FRHICommandListImmediate& RHICmdList)
+			{
+				INC_DWORD_STAT_BY(STAT_MeshUnitUploadBytes,
+				                  GlobalLibrary_RenderThread.BoneTransformParams.NumUploadedBytes);
+			});
 	}
 
 
@@ -174,11 +240,70 @@ FBaseSkeletalMeshHandle ATurboSequence_Manager_Lf::AddSkinnedMeshInstance(
 {
 	SCOPE_CYCLE_COUNTER(Add_TurboSequenceMeshInstances_Lf);
 
-	if (!IsValid(FromAsset))
+	FTurboSequenceRenderHandle RenderHandle;
+	UTurboSequence_RenderData* RenderData = PrepareSkinnedMeshInstances(RenderHandle, FromAsset, WorldContextObject, OverrideMaterials,
+	                                                                    LightingChannels, bNewReceivesDecals, bInRenderInCustomDepth,
+	                                                                    InStencilValue);
+	if (!RenderData)
 	{
 		return FBaseSkeletalMeshHandle();
 	}
 
+	return AddSkinnedMeshInstance_Internal(FromAsset, RenderHandle, RenderData, SpawnTransform);
+}
+
+int32 ATurboSequence_Manager_Lf::AddSkinnedMeshInstances(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs,
+                                                         UTurboSequence_MeshAsset_Lf* FromAsset,
+                                                         const TArray<FTransform>& SpawnTransforms,
+                                                         UObject* WorldContextObject,
+                                                         const TArray<UMaterialInterface*>& OverrideMaterials,
+                                                         FLightingChannels LightingChannels, bool bNewReceivesDecals,
+                                                         bool bInRenderInCustomDepth, int32 InStencilValue)
+{
+	SCOPE_CYCLE_COUNTER(Add_TurboSequenceMeshInstances_Lf);
+
+	OutMeshIDs.Reset(SpawnTransforms.Num());
+	if (!SpawnTransforms.Num())
+	{
+		return 0;
+	}
+
+	FTurboSequenceRenderHandle RenderHandle;
+	UTurboSequence_RenderData* RenderData = PrepareSkinnedMeshInstances(RenderHandle, FromAsset, WorldContextObject, OverrideMaterials,
+	                                                                    LightingChannels, bNewReceivesDecals, bInRenderInCustomDepth,
+	                                                                    InStencilValue);
+	if (!RenderData)
+	{
+		return 0;
+	}
+
+	Instance->GlobalLibrary.RuntimeSkinnedMeshes.Reserve(Instance->GlobalLibrary.RuntimeSkinnedMeshes.Num() + SpawnTransforms.Num());
+	RenderData->ReserveRenderInstances(SpawnTransforms.Num());
+
+	for (const FTransform& SpawnTransform : SpawnTransforms)
+	{
+		const FBaseSkeletalMeshHandle MeshID = AddSkinnedMeshInstance_Internal(FromAsset, RenderHandle, RenderData, SpawnTransform);
+		if (!MeshID.IsValid())
+		{
+			// Out of bone texture, the remaining ones won't fit either
+			break;
+		}
+		OutMeshIDs.Add(MeshID);
+	}
+
+	return OutMeshIDs.Num();
+}
+
+UTurboSequence_RenderData* ATurboSequence_Manager_Lf::PrepareSkinnedMeshInstances(FTurboSequenceRenderHandle& OutRenderHandle,
+	UTurboSequence_MeshAsset_Lf* FromAsset,
+	UObject* WorldContextObject,
+	const TArray<UMaterialInterface*>& OverrideMaterials, FLightingChannels LightingChannels, bool bNewReceivesDecals, bool bInRenderInCustomDepth, int32 InStencilValue)
+{
+	if (!IsValid(FromAsset))
+	{
+		return nullptr;
+	}
+
 	if (!IsValid(FromAsset->GlobalData))
 	{
 		const FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
@@ -202,7 +327,7 @@ FBaseSkeletalMeshHandle ATurboSequence_Manager_Lf::AddSkinnedMeshInstance(
 			       TEXT(
 				       "Can not find the Global Data asset -> This is really bad, without it Turbo Sequence does not work, you can recover it by creating an UTurboSequence_GlobalData_Lf Data Asset, Right click in the content browser anywhere in the Project, select Data Asset and choose UTurboSequence_GlobalData_Lf, save it and restart the editor"
 			       ));
-			return FBaseSkeletalMeshHandle();
+			return nullptr;
 		}
 	}
 
@@ -217,13 +342,13 @@ FBaseSkeletalMeshHandle ATurboSequence_Manager_Lf::AddSkinnedMeshInstance(
 		       TEXT(
 			       "Can not find Transform Texture ... "
 		       ));
-		return FBaseSkeletalMeshHandle();
+		return nullptr;
 	}
 
 	if (!IsValid(WorldContextObject))
 	{
 		UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't create Mesh Instance, the World is not valid..."));
-		return FBaseSkeletalMeshHandle();
+		return nullptr;
 	}
 
 	if (!IsValid(Instance))
@@ -242,7 +367,7 @@ FBaseSkeletalMeshHandle ATurboSequence_Manager_Lf::AddSkinnedMeshInstance(
 				       TEXT(
 					       "Can't create Mesh Instance because Instance is not valid, make sure to have a ATurboSequence_Manager_Lf in the map"
 				       ));
-				return FBaseSkeletalMeshHandle();
+				return nullptr;
 			}
 		}
 
@@ -255,19 +380,18 @@ FBaseSkeletalMeshHandle ATurboSequence_Manager_Lf::AddSkinnedMeshInstance(
 		       TEXT(
 			       "Can't create Mesh Instance, make sure to have ATurboSequence_Manager_Lf as a blueprint in the map"
 		       ));
-		return FBaseSkeletalMeshHandle();
+		return nullptr;
 	}
 
 	Instance->GlobalData = FromAsset->GlobalData;
 
 	if (!FromAsset->IsMeshAssetValid())
 	{
-		return FBaseSkeletalMeshHandle();
+		return nullptr;
 	}
 	
-	FScopeLock ScopeLock(&Instance->RenderThreadDataConsistency);
-
 	const FTurboSequenceRenderHandle RenderHandle(OverrideMaterials,FromAsset->RendererSystem, FromAsset->StaticMesh, bInRenderInCustomDepth, InStencilValue, bNewReceivesDecals, LightingChannels );
+	OutRenderHandle = RenderHandle;
 
 	UTurboSequence_RenderData** TurboSequenceRenderDataPtr = Instance->GlobalLibrary.PerReferenceData.Find(RenderHandle);
 
@@ -296,11 +420,43 @@ FBaseSkeletalMeshHandle ATurboSequence_Manager_Lf::AddSkinnedMeshInstance(
 		
 		Instance->GlobalLibrary.bRefreshAsyncChunkedMeshData = true;
 	}
-	
+
+	if (IsValid(Instance->GlobalData))
+	{
+		Instance->GlobalLibrary.RuntimeSkinnedMeshes.SetSpatialGridCellSize(Instance->GlobalData->SpatialGridCellSize);
+	}
+	if (!Instance->GlobalLibrary.AnimationLibraryAllocator.GetTotalSize() && IsValid(Instance->GlobalData->AnimationLibraryTexture))
+	{
+		const UTextureRenderTarget2DArray* AnimationLibraryTexture = Instance->GlobalData->AnimationLibraryTexture;
+		Instance->GlobalLibrary.AnimationLibraryAllocator.Reset(
+			AnimationLibraryTexture->SizeX * AnimationLibraryTexture->SizeY * AnimationLibraryTexture->Slices);
+	}
+
+	return RenderData;
+}
+
+FBaseSkeletalMeshHandle ATurboSequence_Manager_Lf::AddSkinnedMeshInstance_Internal(UTurboSequence_MeshAsset_Lf* FromAsset,
+                                                                                   const FTurboSequenceRenderHandle& RenderHandle,
+                                                                                   UTurboSequence_RenderData* RenderData,
+                                                                                   const FTransform& SpawnTransform)
+{
 	// Now it's time to add the actual instance
-	const FBaseSkeletalMeshHandle MeshID(Instance->GlobalLibrary.GlobalMeshCounter++);
 	const int32 SizeInBoneTexture = FromAsset->GetNumGPUBones() * 3; //Translation + Rotation + Scale
-	const int32 BoneTextureSkeletonIndex = Instance->GlobalLibrary.BoneTextureAllocator.Allocate(SizeInBoneTexture); 
+	const int32 BoneTextureSkeletonIndex = AllocateBoneTextureSkeleton(SizeInBoneTexture);
+	if (BoneTextureSkeletonIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTurboSequence_Lf, Error, TEXT("Can't create Mesh Instance, the bone texture has no free range of %d, %d free in %d ranges, raise MaxTransformTextureSlices in the Global Data..."),
+		       SizeInBoneTexture, Instance->GlobalLibrary.BoneTextureAllocator.GetFreeSize(),
+		       Instance->GlobalLibrary.BoneTextureAllocator.GetNumFreeRanges());
+		return FBaseSkeletalMeshHandle();
+	}
+
+	const FBaseSkeletalMeshHandle MeshID = Instance->GlobalLibrary.RuntimeSkinnedMeshes.AllocateHandle();
+	if (!MeshID.IsValid())
+	{
+		Instance->GlobalLibrary.BoneTextureAllocator.Free(BoneTextureSkeletonIndex, SizeInBoneTexture);
+		return FBaseSkeletalMeshHandle();
+	}
 
 	//UE_LOG(LogTurboSequence_Lf, Display, TEXT("Allocation %d in the bone texture at %d"), SizeInBoneTexture, BoneTextureSkeletonIndex);
 
@@ -367,8 +523,6 @@ void ATurboSequence_Manager_Lf::RemoveRenderHandle(const FTurboSequenceRenderHan
 
 bool ATurboSequence_Manager_Lf::RemoveSkinnedMeshInstance(FBaseSkeletalMeshHandle MeshID)
 {
-	FScopeLock ScopeLock(&Instance->RenderThreadDataConsistency);
-
 	SCOPE_CYCLE_COUNTER(Remove_TurboSequenceMeshInstances_Lf);
 	
 	if (!IsValid(Instance))
@@ -376,15 +530,69 @@ bool ATurboSequence_Manager_Lf::RemoveSkinnedMeshInstance(FBaseSkeletalMeshHandl
 		return false;
 	}
 
-	FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID);
+	ensure(Instance->GlobalLibrary.RuntimeSkinnedMeshes.Contains(MeshID));
 
-	ensure(Runtime);
-	
+	bool bRemovedAnySkeleton = false;
+	const bool bRemoved = RemoveSkinnedMeshInstance_Internal(MeshID, bRemovedAnySkeleton);
+
+	if(bRemovedAnySkeleton)
+	{
+		FTurboSequence_Utility_Lf::UpdateMaxBones(Instance->GlobalLibrary);
+		
+		Instance->GlobalLibrary.bRefreshAsyncChunkedMeshData = true;
+	}
+
+	return bRemoved;
+}
+
+int32 ATurboSequence_Manager_Lf::RemoveSkinnedMeshInstances(const TArray<FBaseSkeletalMeshHandle>& MeshIDs)
+{
+	SCOPE_CYCLE_COUNTER(Remove_TurboSequenceMeshInstances_Lf);
+
+	if (!IsValid(Instance))
+	{
+		return 0;
+	}
+
+	int32 NumRemoved = 0;
+	bool bRemovedAnySkeleton = false;
+	for (const FBaseSkeletalMeshHandle MeshID : MeshIDs)
+	{
+		bool bRemovedSkeleton = false;
+		NumRemoved += RemoveSkinnedMeshInstance_Internal(MeshID, bRemovedSkeleton);
+		bRemovedAnySkeleton |= bRemovedSkeleton;
+	}
+
+	// Batches often carry handles of meshes removed earlier, those are skipped
+	if (NumRemoved != MeshIDs.Num())
+	{
+		UE_LOG(LogTurboSequence_Lf, Verbose, TEXT("RemoveSkinnedMeshInstances removed %d of %d meshes, the other handles were stale or invalid"),
+		       NumRemoved, MeshIDs.Num());
+	}
+
+	// The bone counts and reference data get rebuilt once for the whole batch
+	if(bRemovedAnySkeleton)
+	{
+		FTurboSequence_Utility_Lf::UpdateMaxBones(Instance->GlobalLibrary);
+		
+		Instance->GlobalLibrary.bRefreshAsyncChunkedMeshData = true;
+	}
+
+	return NumRemoved;
+}
+
+bool ATurboSequence_Manager_Lf::RemoveSkinnedMeshInstance_Internal(FBaseSkeletalMeshHandle MeshID, bool& bRemovedAnySkeleton)
+{
+	FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID);
 	if (!Runtime)
 	{
 		return false;
 	}
 	
+	RemoveMeshFromAnimationGroup(MeshID);
+
+	Instance->GlobalLibrary.NumAutoRootMotionMeshes -= Runtime->bAutoRootMotion;
+
 	FTurboSequence_Utility_Lf::ClearAnimations(*Runtime, Instance->GlobalLibrary, ETurboSequence_AnimationForceMode_Lf::AllLayers, TArray<FTurboSequence_BoneLayer_Lf>(),
 	                                           [](const FAnimationMetaData_Lf& Animation)
 	                                           {
@@ -394,7 +602,7 @@ bool ATurboSequence_Manager_Lf::RemoveSkinnedMeshInstance(FBaseSkeletalMeshHandl
 	FTurboSequence_Utility_Lf::RemoveAnimation(*Runtime, Instance->GlobalLibrary, 0);
 	
 	bool bRemovedASkeleton;
-	bool bRemovedAnySkeleton = false;
+	bRemovedAnySkeleton = false;
 
 	//Remove Attachments
 	for (const FSkinnedMeshAttachmentRuntime &Attachment : Runtime->Attachments)
@@ -418,13 +626,6 @@ bool ATurboSequence_Manager_Lf::RemoveSkinnedMeshInstance(FBaseSkeletalMeshHandl
 	Instance->GlobalLibrary.BoneTextureAllocator.Free(Runtime->BoneTextureSkeletonIndex, SizeInBoneTexture);
 	
 	Instance->GlobalLibrary.RuntimeSkinnedMeshes.Remove(MeshID); Runtime = nullptr;
-	
-	if(bRemovedAnySkeleton)
-	{
-		FTurboSequence_Utility_Lf::UpdateMaxBones(Instance->GlobalLibrary);
-		
-		Instance->GlobalLibrary.bRefreshAsyncChunkedMeshData = true;
-	}
 
 	return true;
 }
@@ -710,11 +911,10 @@ bool ATurboSequence_Manager_Lf::RemoveParticle(const FBaseSkeletalMeshHandle Mes
  * @brief Solves all meshes at once, call it only in the game thread
  * @param DeltaTime The DeltaTime in seconds
  * @param InWorld The world, we need it for the cameras and culling
+ * @param CurrentFrameCount The frame animation LOD, keyframe residency and compaction are keyed on
  */
-void ATurboSequence_Manager_Lf::SolveMeshes_GameThread(float DeltaTime, UWorld* InWorld)
+void ATurboSequence_Manager_Lf::SolveMeshes_GameThread(float DeltaTime, UWorld* InWorld, int64 CurrentFrameCount)
 {
-	FScopeLock ScopeLock(&Instance->RenderThreadDataConsistency);
-	
 	SCOPE_CYCLE_COUNTER(STAT_Solve_TurboSequenceMeshes_Lf);
 	const int32 SkinnedMeshCount = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Num();
 	
@@ -736,8 +936,6 @@ void ATurboSequence_Manager_Lf::SolveMeshes_GameThread(float DeltaTime, UWorld*
 	{
 		return;
 	}
-	
-	const int64 CurrentFrameCount = UKismetSystemLibrary::GetFrameCount();
 
 	//Reset bounds
 	for (auto& PerReferenceData : Instance->GlobalLibrary.PerReferenceData)
@@ -747,40 +945,110 @@ void ATurboSequence_Manager_Lf::SolveMeshes_GameThread(float DeltaTime, UWorld*
 
 	INC_DWORD_STAT_BY(STAT_TotalMeshCount, Instance->GlobalLibrary.RuntimeSkinnedMeshes.Num());
 
+	const auto& BoneTextureAllocator = Instance->GlobalLibrary.BoneTextureAllocator;
+	INC_DWORD_STAT_BY(STAT_BoneTextureFreeSize, BoneTextureAllocator.GetFreeSize());
+	INC_DWORD_STAT_BY(STAT_BoneTextureLargestFreeRange, BoneTextureAllocator.GetLargestFreeSize());
+	INC_DWORD_STAT_BY(STAT_BoneTextureFreeRanges, BoneTextureAllocator.GetNumFreeRanges());
+	INC_FLOAT_STAT_BY(STAT_BoneTextureFragmentation, BoneTextureAllocator.GetFragmentation() * 100.0f);
+	INC_DWORD_STAT_BY(STAT_BoneTextureUsedSize, BoneTextureAllocator.GetUsedSize());
+	INC_DWORD_STAT_BY(STAT_BoneTextureHighWaterMark, BoneTextureAllocator.GetHighWaterMark());
+	if (IsValid(Instance->GlobalData->TransformTexture_CurrentFrame))
+	{
+		INC_DWORD_STAT_BY(STAT_TransformTextureSlices, Instance->GlobalData->TransformTexture_CurrentFrame->Slices);
+	}
+
+	CompactBoneTexture_GameThread(DeltaTime);
+
+	INC_DWORD_STAT_BY(STAT_AnimationLibraryResidentKeyframes, Instance->GlobalLibrary.NumResidentAnimationKeyframes);
+	INC_DWORD_STAT_BY(STAT_AnimationLibraryEvictedKeyframes, Instance->GlobalLibrary.NumEvictedAnimationKeyframes);
+	INC_DWORD_STAT_BY(STAT_AnimationLibraryFreeSize, Instance->GlobalLibrary.AnimationLibraryAllocator.GetFreeSize());
+	INC_DWORD_STAT_BY(STAT_KeyframeSampleFallbacks, Instance->GlobalLibrary.NumKeyframeSampleFallbacks);
+
 	Instance->GlobalLibrary.AnimationLibraryDataAllocatedThisFrame.Empty();
-	
-	for (auto & RuntimeSkinnedMesh : Instance->GlobalLibrary.RuntimeSkinnedMeshes)
+	Instance->GlobalLibrary.AnimationLibraryIndicesAllocatedThisFrame.Empty();
+	Instance->GlobalLibrary.AnimationLibraryFrame = CurrentFrameCount;
+
+	// Poses sampled on worker threads since last frame, the solve below reads them from the library
+	Instance->GlobalLibrary.MaxPendingKeyframeSamples = Instance->GlobalData->bAsyncKeyframeSampling
+		                                                    ? Instance->GlobalData->MaxPendingKeyframeSamples
+		                                                    : 0;
+	Instance->GlobalLibrary.KeyframePrefetchTime = Instance->GlobalData->KeyframePrefetchTime;
+	FTurboSequence_Utility_Lf::CommitKeyframeSamples(Instance->GlobalLibrary);
+	INC_DWORD_STAT_BY(STAT_PendingKeyframeSamples, Instance->GlobalLibrary.PendingKeyframeSamples.Num());
+
+	const double CullingStartTime = FPlatformTime::Seconds();
+	FTurboSequence_Utility_Lf::CullSpatialCells(Instance->GlobalLibrary.RuntimeSkinnedMeshes, Instance->GlobalLibrary.CameraViews);
+	Instance->GlobalLibrary.CullingTimeSeconds = FPlatformTime::Seconds() - CullingStartTime;
+
+	SolveAnimationGroups_GameThread(DeltaTime, CurrentFrameCount);
+
+	const double SolveStartTime = FPlatformTime::Seconds();
+	Instance->GlobalLibrary.bAnimationUpdatesScheduled = ScheduleAnimationUpdates_GameThread(DeltaTime, CurrentFrameCount);
+
+	const int32 NumSolveWorkers = GetNumSolveWorkers(SkinnedMeshCount);
+	if (NumSolveWorkers > 1)
 	{
-		FSkinnedMeshRuntime_Lf& Runtime = RuntimeSkinnedMesh.Value;
+		SolveMeshesParallel_GameThread(DeltaTime, CurrentFrameCount, NumSolveWorkers);
+	}
+	else
+	{
+		const double MeshCullingStartTime = FPlatformTime::Seconds();
+		FTurboSequence_Utility_Lf::CullMeshes(Instance->GlobalLibrary.RuntimeSkinnedMeshes, Instance->GlobalLibrary.CameraViews, 0, SkinnedMeshCount);
+		Instance->GlobalLibrary.CullingTimeSeconds += FPlatformTime::Seconds() - MeshCullingStartTime;
+
+		FSkinnedMeshSolveShard_Lf AnimationLODCounter;
+		for (int32 DenseIndex = 0; DenseIndex < SkinnedMeshCount; ++DenseIndex)
+		{
+			FSkinnedMeshRuntime_Lf& Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.GetDense(DenseIndex);
 		
-		// Need to get always updated
-		FTurboSequence_Utility_Lf::SolveAnimations(Runtime,
-		                                           Instance->GlobalLibrary,
-		                                           DeltaTime,
-		                                           CurrentFrameCount);
+			// Need to get always updated, unless the animation LOD or the update budget skips this frame
+			double CameraDistance;
+			const bool bUpdateAnimations = Instance->GlobalLibrary.bAnimationUpdatesScheduled
+				                               ? Instance->GlobalLibrary.ScheduledAnimationUpdates[DenseIndex]
+				                               : FTurboSequence_Utility_Lf::UpdateAnimationLOD(Runtime, Instance->GlobalLibrary.CameraViews,
+				                                                                               DeltaTime, CurrentFrameCount, CameraDistance);
+			AnimationLODCounter.CountAnimationLOD(Runtime.AnimationLODBand, !bUpdateAnimations);
+			if (bUpdateAnimations)
+			{
+				FTurboSequence_Utility_Lf::SolveAnimations(Runtime,
+				                                           Instance->GlobalLibrary,
+				                                           Runtime.ConsumePendingAnimationDeltaTime(),
+				                                           CurrentFrameCount);
+			}
 			
-		Runtime.bIsVisible = Runtime.DataAsset->bIsFrustumCullingEnabled ? FTurboSequence_Utility_Lf::IsMeshVisible(Runtime, Instance->GlobalLibrary.CameraViews) : true;
-
+			const bool bIsVisible = Instance->GlobalLibrary.RuntimeSkinnedMeshes.IsVisible(DenseIndex);
 		
-		//DrawDebugString(InWorld,Runtime.WorldSpaceTransform.GetLocation(), FString::Printf(TEXT("CPU %d Viz %d"),Runtime.BoneTextureSkeletonIndex, Runtime.bIsVisible),nullptr, FColor::Cyan,0 );
+			//DrawDebugString(InWorld,Runtime.WorldSpaceTransform.GetLocation(), FString::Printf(TEXT("CPU %d Viz %d"),Runtime.BoneTextureSkeletonIndex, bIsVisible),nullptr, FColor::Cyan,0 );
 
-		if (Runtime.bIsVisible)
-		{
-			INC_DWORD_STAT(STAT_VisibleMeshCount);
-		}
+			if (bIsVisible)
+			{
+				INC_DWORD_STAT(STAT_VisibleMeshCount);
+			}
 		
-		UTurboSequence_RenderData* RenderData = Instance->GlobalLibrary.PerReferenceData[Runtime.RenderHandle];
+			UTurboSequence_RenderData* RenderData = Instance->GlobalLibrary.PerReferenceData[Runtime.RenderHandle];
 			
-		RenderData->UpdateRendererBounds(Runtime.WorldSpaceTransform);
+			RenderData->UpdateRendererBounds(Runtime.WorldSpaceTransform);
 
-		for (const FSkinnedMeshAttachmentRuntime& Attachment : Runtime.Attachments)
-		{
-			UTurboSequence_RenderData* AttachmentRenderData = Instance->GlobalLibrary.PerReferenceData[Attachment.RenderHandle];
+			for (const FSkinnedMeshAttachmentRuntime& Attachment : Runtime.Attachments)
+			{
+				UTurboSequence_RenderData* AttachmentRenderData = Instance->GlobalLibrary.PerReferenceData[Attachment.RenderHandle];
 
-			AttachmentRenderData->UpdateRendererBounds(Runtime.WorldSpaceTransform);
+				AttachmentRenderData->UpdateRendererBounds(Runtime.WorldSpaceTransform);
+			}
 		}
+
+		IncAnimationLODStats_Lf(AnimationLODCounter);
+	}
+
+	if (Instance->GlobalLibrary.bAnimationUpdatesScheduled)
+	{
+		UpdateAnimationUpdateBudget(FPlatformTime::Seconds() - SolveStartTime);
 	}
 
+	ApplyAutoRootMotion_GameThread(CurrentFrameCount);
+
+	CollectAnimNotifies_GameThread(CurrentFrameCount);
+
 	if (Instance->GlobalLibrary.PerReferenceData.Num() && IsValid(Instance->GlobalData) && IsValid(
 		Instance->GlobalData->TransformTexture_CurrentFrame))
 	{
@@ -794,23 +1062,25 @@ void ATurboSequence_Manager_Lf::SolveMeshes_GameThread(float DeltaTime, UWorld*
 		if (Instance->GlobalLibrary.AnimationLibraryDataAllocatedThisFrame.Num())
 		{
 			TArray<FVector4f> AnimationData = Instance->GlobalLibrary.AnimationLibraryDataAllocatedThisFrame;
+			TArray<int32> AnimationIndices = Instance->GlobalLibrary.AnimationLibraryIndicesAllocatedThisFrame;
 
 			FSkinnedMeshGlobalLibrary_RenderThread_Lf& Library_RenderThread = GlobalLibrary_RenderThread;
 			
 			ENQUEUE_RENDER_COMMAND(TurboSequence_AddLibraryAnimationChunked_Lf)(
-				[&Library_RenderThread, AnimationData, AnimationMaxNum](FRHICommandListImmediate& RHICmdList)
+				[&Library_RenderThread, AnimationData, AnimationIndices, AnimationMaxNum](FRHICommandListImmediate& RHICmdList)
 				{
 					Library_RenderThread.AnimationLibraryParams.SettingsInput.Append(AnimationData);
+					Library_RenderThread.AnimationLibraryParams.SettingsInputIndices.Append(AnimationIndices);
 
 					Library_RenderThread.AnimationLibraryMaxNum = AnimationMaxNum;
 				});
 		}
 
-		// for (auto & RuntimeSkinnedMesh : Instance->GlobalLibrary.RuntimeSkinnedMeshes)
+		BuildFrameSnapshot_GameThread();
+
+		// for (const FSkinnedMeshRuntime_Lf& Runtime : Instance->GlobalLibrary.RuntimeSkinnedMeshes)
 		// {
-		// 	const FSkinnedMeshRuntime_Lf& Runtime = RuntimeSkinnedMesh.Value;
-		//
-		// 	FColor LineColor(FColor::MakeRandomSeededColor(GetTypeHash(RuntimeSkinnedMesh.Key)));
+		// 	FColor LineColor(FColor::MakeRandomSeededColor(GetTypeHash(Runtime.MeshID)));
 		// 	LineColor.A = 255; 
 		// 	FTurboSequence_Utility_Lf::DebugDrawSkeleton(Runtime, Instance->GlobalLibrary, LineColor,InWorld);
 		//
@@ -821,170 +1091,723 @@ void ATurboSequence_Manager_Lf::SolveMeshes_GameThread(float DeltaTime, UWorld*
 	FTurboSequence_Utility_Lf::UpdateCameras_2(LastFrameCameraTransforms, Instance->GlobalLibrary.CameraViews);
 }
 
-void ATurboSequence_Manager_Lf::SolveMeshes_RenderThread(FRHICommandListImmediate& RHICmdList)
+int32 ATurboSequence_Manager_Lf::GetNumSolveWorkers(const int32 NumMeshes)
 {
-	SCOPE_CYCLE_COUNTER(STAT_Solve_TurboSequenceMeshes_RT_Lf);
-	
-	if (!IsValid(Instance))
+	if (!IsValid(Instance->GlobalData) || !Instance->GlobalData->bUseParallelMeshSolve || !FApp::ShouldUseThreadingForPerformance())
 	{
-		return;
+		return 1;
 	}
 
-	FScopeLock ScopeLock(&Instance->RenderThreadDataConsistency);
+	const int32 MinBatchSize = FMath::Max(Instance->GlobalData->ParallelMeshSolveMinBatchSize, 1);
+
+	return FMath::Clamp(NumMeshes / MinBatchSize, 1, static_cast<int32>(FTurboSequence_Helper_Lf::NumCPUThreads()));
+}
 
-	if (!Instance->GlobalLibrary.RuntimeSkinnedMeshes.Num())
+void ATurboSequence_Manager_Lf::CollectAnimNotifies_GameThread(int64 CurrentFrameCount)
+{
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	Library.AnimNotifyEvents.Reset();
+	if (!IsValid(Instance->GlobalData) || !Instance->GlobalData->bCollectAnimNotifies)
 	{
 		return;
 	}
-	
-	FMeshUnitComputeShader_Params_Lf& MeshParams = GlobalLibrary_RenderThread.BoneTransformParams;
 
-	if(Instance->GlobalLibrary.bMasksNeedRebuilding || Instance->GlobalLibrary.MasksBuiltBoneCount != Instance->GlobalLibrary.MaxNumCPUBones)
+	const int32 NumMeshes = Library.RuntimeSkinnedMeshes.Num();
+	const int32 NumWorkers = GetNumSolveWorkers(NumMeshes);
+	const int32 MeshesPerWorker = FMath::DivideAndRoundUp(NumMeshes, NumWorkers);
+	if (Library.AnimNotifyEventShards.Num() < NumWorkers)
 	{
-		Instance->GlobalLibrary.ProxyToIndex.Reset();
-
-		int32 MaskCount = 0;
+		Library.AnimNotifyEventShards.SetNum(NumWorkers);
+	}
 
-		const int32 NumCPUBones = Instance->GlobalLibrary.MaxNumCPUBones;
+	ParallelFor(NumWorkers, [&Library, NumMeshes, MeshesPerWorker, CurrentFrameCount](int32 WorkerIndex)
+	{
+		const int32 StartIndex = WorkerIndex * MeshesPerWorker;
+		const int32 EndIndex = FMath::Min(StartIndex + MeshesPerWorker, NumMeshes);
 
-		const int32 NumLayers = Instance->GlobalLibrary.AnimationBlendLayerMasks.Num() * NumCPUBones;
-		//MeshParams.AnimationLayers_RenderThread.SetNumUninitialized(NumLayers);
+		TArray<FTurboSequence_AnimNotifyEvent_Lf>& Shard = Library.AnimNotifyEventShards[WorkerIndex];
+		Shard.Reset();
 
-		MeshParams.AnimationLayers_RenderThread.Reset(NumLayers);
-		
-		for (const auto & AnimationBlendLayerMask : Instance->GlobalLibrary.AnimationBlendLayerMasks)
+		FRandomStream RandomStream(HashCombine(GetTypeHash(CurrentFrameCount), GetTypeHash(WorkerIndex)));
+		for (int32 DenseIndex = StartIndex; DenseIndex < EndIndex; ++DenseIndex)
 		{
-			Instance->GlobalLibrary.ProxyToIndex.Add(AnimationBlendLayerMask.Key, MaskCount++);
-
-			for (uint16 RawAnimationLayer : AnimationBlendLayerMask.Value.RawAnimationLayers)
-			{
-				MeshParams.AnimationLayers_RenderThread.Add(RawAnimationLayer);
-			}
-
-			//Pad to NumCPUBones
-			for(int32 BoneIndex = AnimationBlendLayerMask.Value.RawAnimationLayers.Num(); BoneIndex < NumCPUBones; ++BoneIndex)
-			{
-				MeshParams.AnimationLayers_RenderThread.Add(0);
-			}
+			FTurboSequence_Utility_Lf::CollectAnimNotifies(Shard, Library.RuntimeSkinnedMeshes.GetDense(DenseIndex),
+			                                               Library, CurrentFrameCount, RandomStream);
 		}
-		
-		Instance->GlobalLibrary.bMasksNeedRebuilding = false;
-		Instance->GlobalLibrary.MasksBuiltBoneCount = Instance->GlobalLibrary.MaxNumCPUBones;
+	}, NumWorkers > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	// Merged in shard order, which keeps the events ordered by mesh
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		Library.AnimNotifyEvents.Append(Library.AnimNotifyEventShards[WorkerIndex]);
 	}
+	INC_DWORD_STAT_BY(STAT_AnimNotifyEvents, Library.AnimNotifyEvents.Num());
+}
 
-	if(Instance->GlobalLibrary.bRefreshAsyncChunkedMeshData)
+bool ATurboSequence_Manager_Lf::ScheduleAnimationUpdates_GameThread(float DeltaTime, int64 CurrentFrameCount)
+{
+	if (!IsValid(Instance->GlobalData) ||
+		(Instance->GlobalData->MaxAnimationUpdatesPerFrame <= 0 && Instance->GlobalData->AnimationUpdateBudgetMs <= 0))
 	{
-		FTurboSequence_Utility_Lf::RefreshAsyncChunkedMeshData(Instance->GlobalLibrary, GlobalLibrary_RenderThread);
-		
-		Instance->GlobalLibrary.bRefreshAsyncChunkedMeshData = false;
+		Instance->GlobalLibrary.TimedAnimationUpdateBudget = 0;
+		return false;
 	}
 
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	const int32 NumMeshes = Library.RuntimeSkinnedMeshes.Num();
 
+	int32 Budget = Instance->GlobalData->MaxAnimationUpdatesPerFrame > 0 ? Instance->GlobalData->MaxAnimationUpdatesPerFrame : MAX_int32;
+	if (Instance->GlobalData->AnimationUpdateBudgetMs > 0 && Library.TimedAnimationUpdateBudget > 0)
+	{
+		Budget = FMath::Min(Budget, Library.TimedAnimationUpdateBudget);
+	}
 
-	int32 NumMeshesVisibleCurrentFrame = 0;
+	Library.ScheduledAnimationUpdates.Init(false, NumMeshes);
+	Library.AnimationUpdateCandidates.Reset();
 
-	MeshParams.PerMeshCustomDataIndex_Global_RenderThread.Reset();
-	MeshParams.PerMeshCustomDataCollectionIndex_RenderThread.Reset();
-	MeshParams.AnimationStartIndex_RenderThread.Reset();
-	MeshParams.AnimationFramePose0_RenderThread.Reset();
-	MeshParams.AnimationFramePose1_RenderThread.Reset();
-	MeshParams.AnimationFrameAlpha_RenderThread.Reset();
-	MeshParams.AnimationWeights_RenderThread.Reset();
-	MeshParams.AnimationLayerIndex_RenderThread.Reset();
-	MeshParams.AnimationEndIndex_RenderThread.Reset();
-	MeshParams.BoneSpaceAnimationIKData_RenderThread.Reset();
-	MeshParams.BoneSpaceAnimationIKInput_RenderThread.Reset();
-	MeshParams.BoneSpaceAnimationIKStartIndex_RenderThread.Reset();
-	MeshParams.BoneSpaceAnimationIKEndIndex_RenderThread.Reset();
-	
-	for (auto & RuntimeSkinnedMesh : Instance->GlobalLibrary.RuntimeSkinnedMeshes)
+	// Without a camera every distance is the same huge value and would flatten the priorities, only staleness orders them then
+	const bool bHasCameraViews = Library.CameraViews.Num() > 0;
+
+	for (int32 DenseIndex = 0; DenseIndex < NumMeshes; ++DenseIndex)
 	{
-		FSkinnedMeshRuntime_Lf& Runtime = RuntimeSkinnedMesh.Value;
-		
-		if (!Runtime.bIsVisible)
+		FSkinnedMeshRuntime_Lf& Runtime = Library.RuntimeSkinnedMeshes.GetDense(DenseIndex);
+
+		double CameraDistance;
+		if (!FTurboSequence_Utility_Lf::UpdateAnimationLOD(Runtime, Library.CameraViews, DeltaTime, CurrentFrameCount, CameraDistance))
 		{
 			continue;
 		}
-		
-		NumMeshesVisibleCurrentFrame++;
-		
-		//Mesh to skeleton reference
-		MeshParams.PerMeshCustomDataIndex_Global_RenderThread.Add(Runtime.BoneTextureSkeletonIndex);
 
-		int32 SkeletonIndex = Instance->GlobalLibrary.PerReferenceDataKeys.Find(Runtime.DataAsset);
-		
-		ensure(SkeletonIndex != INDEX_NONE);
-		
-		MeshParams.PerMeshCustomDataCollectionIndex_RenderThread.Add(SkeletonIndex);
-		
-		//Animations
-		int32 LastAnimationIndex = MeshParams.AnimationFramePose0_RenderThread.Num();
-		
-		MeshParams.AnimationStartIndex_RenderThread.Add(LastAnimationIndex);
+		// Nothing to solve, don't spend budget on it
+		if (!Runtime.bAnimTickEnabled)
+		{
+			Library.ScheduledAnimationUpdates[DenseIndex] = true;
+			continue;
+		}
 
-		for (const FAnimationMetaData_Lf& Animation : Runtime.AnimationMetaData)
+		// The visibility is the one of the last frame, the culling of this frame runs inside the solve.
+		// Staleness keeps growing while a mesh gets deferred, so in the end every mesh gets its turn
+		const float Staleness = CurrentFrameCount - Runtime.LastFrameAnimationSolved;
+		float Priority = Staleness;
+		if (bHasCameraViews)
 		{
-			MeshParams.AnimationFramePose0_RenderThread.Add(Animation.GPUAnimationIndex_0);
-			MeshParams.AnimationFramePose1_RenderThread.Add(Animation.GPUAnimationIndex_1);
-			MeshParams.AnimationFrameAlpha_RenderThread.Add(Animation.FrameAlpha * 0x7FFF);
-			MeshParams.AnimationWeights_RenderThread.Add(Animation.FinalAnimationWeight * 0x7FFF);
+			const float VisibilityPriority = Library.RuntimeSkinnedMeshes.IsVisible(DenseIndex) ? 8 : 1;
+			Priority *= VisibilityPriority / (1 + CameraDistance * 0.001);
+		}
 
-			FBoneMaskBuiltProxyHandle BoneMaskBuiltProxyHandle = Animation.Settings.MaskDefinition.GetBuiltProxyHandle(Runtime.DataAsset);
+		Library.AnimationUpdateCandidates.Add({Priority, DenseIndex});
+	}
 
-			int* LayerMaskIndex = Instance->GlobalLibrary.ProxyToIndex.Find(BoneMaskBuiltProxyHandle);
+	if (Library.AnimationUpdateCandidates.Num() > Budget)
+	{
+		Library.AnimationUpdateCandidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+		{
+			return A.Key > B.Key || (A.Key == B.Key && A.Value < B.Value);
+		});
 
-			MeshParams.AnimationLayerIndex_RenderThread.Add(*LayerMaskIndex);
-		}
+		INC_DWORD_STAT_BY(STAT_BudgetDeferredAnimationUpdates, Library.AnimationUpdateCandidates.Num() - Budget);
+		Library.AnimationUpdateCandidates.SetNum(Budget);
+	}
 
-		int32 AnimationCount = Runtime.AnimationMetaData.Num();
-		MeshParams.AnimationEndIndex_RenderThread.Add(AnimationCount);
+	for (const TPair<float, int32>& Candidate : Library.AnimationUpdateCandidates)
+	{
+		Library.ScheduledAnimationUpdates[Candidate.Value] = true;
+	}
 
-		//ID data
-		int32 NumIKBones = 0;
-		int32 LastIKDataIndex = MeshParams.BoneSpaceAnimationIKData_RenderThread.Num();
+	Library.NumScheduledAnimationUpdates = Library.AnimationUpdateCandidates.Num();
+	INC_DWORD_STAT_BY(STAT_AnimationUpdateBudget, Budget == MAX_int32 ? NumMeshes : Budget);
 
-		for (auto & IKData : Runtime.OverrideBoneTransforms)
-		{
-			const int32 CPUBoneIndex = IKData.Key;
-			
-			if(const int* GPUBoneIndex = Runtime.DataAsset->CPUBoneToGPUBoneIndicesMap.Find(CPUBoneIndex))
-			{
-				MeshParams.BoneSpaceAnimationIKData_RenderThread.Add(*GPUBoneIndex);
+	return true;
+}
 
-				const FMatrix& BoneMatrix = IKData.Value.OverrideTransform.ToMatrixWithScale();
+void ATurboSequence_Manager_Lf::UpdateAnimationUpdateBudget(double SolveSeconds)
+{
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	const double BudgetSeconds = Instance->GlobalData->AnimationUpdateBudgetMs / 1000.0;
+	if (BudgetSeconds <= 0 || Library.NumScheduledAnimationUpdates <= 0)
+	{
+		return;
+	}
 
-				for (int32 M = 0; M < 3; ++M)
-				{
-					FVector4f BoneData;
-					BoneData.X = BoneMatrix.M[0][M];
-					BoneData.Y = BoneMatrix.M[1][M];
-					BoneData.Z = BoneMatrix.M[2][M];
-					BoneData.W = BoneMatrix.M[3][M];
+	// Scale the updates by how far the solve missed the budget, smoothed to not oscillate,
+	// the floor keeps the crowd moving when the fixed per mesh cost alone exceeds the budget
+	constexpr int32 MinTimedAnimationUpdateBudget = 32;
+	const double FittingUpdates = Library.NumScheduledAnimationUpdates * BudgetSeconds / FMath::Max(SolveSeconds, UE_SMALL_NUMBER);
+	const double PreviousBudget = Library.TimedAnimationUpdateBudget > 0 ? Library.TimedAnimationUpdateBudget : FittingUpdates;
+	Library.TimedAnimationUpdateBudget = FMath::Clamp(FMath::RoundToInt32(FMath::Lerp(PreviousBudget, FittingUpdates, 0.5)),
+	                                                  MinTimedAnimationUpdateBudget,
+	                                                  FMath::Max(Library.RuntimeSkinnedMeshes.Num(), MinTimedAnimationUpdateBudget));
+}
 
-					MeshParams.BoneSpaceAnimationIKInput_RenderThread.Add(BoneData);
-				}
-						
-				NumIKBones++;
-			}
+int32 ATurboSequence_Manager_Lf::AllocateBoneTextureSkeleton(const int32 Size)
+{
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	const UTextureRenderTarget2DArray* TransformTexture = Instance->GlobalData->TransformTexture_CurrentFrame;
+	if (!IsValid(TransformTexture))
+	{
+		UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't allocate a skeleton, the Global Data has no Transform Texture"));
+		return INDEX_NONE;
+	}
+
+	const int32 SliceSize = TransformTexture->SizeX * TransformTexture->SizeY;
+	if (!Library.BoneTextureAllocator.GetTotalSize())
+	{
+		Library.InitialTransformTextureSlices = TransformTexture->Slices;
+		Library.BoneTextureAllocator.Reset(SliceSize * TransformTexture->Slices);
+	}
+
+	int32 SkeletonIndex = Library.BoneTextureAllocator.Allocate(Size);
+	const int32 MaxSlices = Instance->GlobalData->MaxTransformTextureSlices;
+	while (SkeletonIndex == INDEX_NONE && SliceSize > 0 && static_cast<int32>(TransformTexture->Slices) < MaxSlices)
+	{
+		// Grow by a quarter at least, a crowd spawning over some frames would reallocate the textures on every few instances
+		const int32 NumSlices = TransformTexture->Slices;
+		const int32 NewNumSlices = FMath::Min(FMath::Max(NumSlices + FMath::DivideAndRoundUp(Size, SliceSize), NumSlices * 5 / 4), MaxSlices);
+		if (!ResizeTransformTextures(NewNumSlices))
+		{
+			break;
 		}
 
-		MeshParams.BoneSpaceAnimationIKStartIndex_RenderThread.Add(LastIKDataIndex);
-		MeshParams.BoneSpaceAnimationIKEndIndex_RenderThread.Add(NumIKBones);
+		SkeletonIndex = Library.BoneTextureAllocator.Allocate(Size);
 	}
 
-	MeshParams.ReferenceNumCPUBones_RenderThread.Reset();
-	
-	for (int32 i = 0; i < MeshParams.ReferenceNumCPUBones.Num(); ++i)
+	return SkeletonIndex;
+}
+
+bool ATurboSequence_Manager_Lf::ResizeTransformTextures(const int32 NumSlices)
+{
+	UTextureRenderTarget2DArray* CurrentFrame = Instance->GlobalData->TransformTexture_CurrentFrame;
+	UTextureRenderTarget2DArray* PreviousFrame = Instance->GlobalData->TransformTexture_PreviousFrame;
+	if (NumSlices < 1 || !IsValid(CurrentFrame) || !IsValid(PreviousFrame))
 	{
-		MeshParams.ReferenceNumCPUBones_RenderThread.Add(MeshParams.ReferenceNumCPUBones[i]);
+		return false;
 	}
 
-	MeshParams.NumMeshes = NumMeshesVisibleCurrentFrame;
+	UE_LOG(LogTurboSequence_Lf, Display, TEXT("Resizing the transform textures from %d to %d slices"), CurrentFrame->Slices, NumSlices);
+
+	// Init releases the texture resources, the solves and draws already enqueued still read them
+	FlushRenderingCommands();
+
+	CurrentFrame->Init(CurrentFrame->SizeX, CurrentFrame->SizeY, NumSlices, CurrentFrame->GetFormat());
+	PreviousFrame->Init(PreviousFrame->SizeX, PreviousFrame->SizeY, NumSlices, PreviousFrame->GetFormat());
+
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	Library.BoneTextureAllocator.Grow(CurrentFrame->SizeX * CurrentFrame->SizeY * NumSlices);
+
+	// The new textures start empty, every skeleton has to be written again
+	for (FSkinnedMeshRuntime_Lf& Runtime : Library.RuntimeSkinnedMeshes)
+	{
+		Runtime.bBoneTextureDirty = true;
+		Runtime.bPreviousBoneRowsInvalid = true;
+	}
+
+	return true;
+}
+
+void ATurboSequence_Manager_Lf::CompactBoneTexture_GameThread(const float DeltaTime)
+{
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	const UTextureRenderTarget2DArray* TransformTexture = Instance->GlobalData->TransformTexture_CurrentFrame;
+	const float CompactionInterval = Instance->GlobalData->BoneTextureCompactionInterval;
+	if (CompactionInterval <= 0 || !Library.BoneTextureAllocator.GetTotalSize() || !IsValid(TransformTexture))
+	{
+		return;
+	}
+
+	Library.TimeSinceBoneTextureCompaction += DeltaTime;
+	if (Library.TimeSinceBoneTextureCompaction < CompactionInterval)
+	{
+		return;
+	}
+	Library.TimeSinceBoneTextureCompaction = 0;
+
+	TSegregatedFitAllocator<8>& Allocator = Library.BoneTextureAllocator;
+	const int32 SliceSize = TransformTexture->SizeX * TransformTexture->SizeY;
+	const int32 NumSlices = TransformTexture->Slices;
+
+	// Packed, the skeletons need this many slices, one spare slice keeps spawning from growing the textures right away
+	const int32 PackedSize = Allocator.GetTotalSize() - Allocator.GetFreeSize();
+	const int32 NumPackedSlices = FMath::Clamp(FMath::DivideAndRoundUp(PackedSize, SliceSize) + 1,
+	                                           Library.InitialTransformTextureSlices, NumSlices);
+	const bool bShrink = NumPackedSlices < NumSlices;
+	if (!bShrink && Allocator.GetFragmentation() <= Instance->GlobalData->BoneTextureCompactionThreshold)
+	{
+		return;
+	}
+
+	// Sorted by the current index the skeletons keep their order and only move towards the front
+	TArray<TPair<int32, int32>> Skeletons; // < Skeleton Index | Dense Index >
+	Skeletons.Reserve(Library.RuntimeSkinnedMeshes.Num());
+	for (int32 DenseIndex = 0; DenseIndex < Library.RuntimeSkinnedMeshes.Num(); ++DenseIndex)
+	{
+		Skeletons.Add({Library.RuntimeSkinnedMeshes.GetDense(DenseIndex).BoneTextureSkeletonIndex, DenseIndex});
+	}
+	Skeletons.Sort();
+
+	// A single free range hands out the allocations back to back
+	Allocator.Reset(NumPackedSlices * SliceSize);
+	for (const TPair<int32, int32>& Skeleton : Skeletons)
+	{
+		FSkinnedMeshRuntime_Lf& Runtime = Library.RuntimeSkinnedMeshes.GetDense(Skeleton.Value);
+		const int32 SkeletonIndex = Allocator.Allocate(Runtime.DataAsset->GetNumGPUBones() * 3);
+		ensure(SkeletonIndex != INDEX_NONE);
+		if (SkeletonIndex == Runtime.BoneTextureSkeletonIndex)
+		{
+			continue;
+		}
+
+		// The texels stay behind, the solve of this frame writes the new range before it gets drawn,
+		// both textures at once as the previous rows there belong to another skeleton
+		Runtime.BoneTextureSkeletonIndex = SkeletonIndex;
+		Runtime.bBoneTextureDirty = true;
+		Runtime.bPreviousBoneRowsInvalid = true;
+
+		if (UTurboSequence_RenderData* const* RenderData = Library.PerReferenceData.Find(Runtime.RenderHandle))
+		{
+			(*RenderData)->SetSkeletonIndex(Runtime.MeshID, SkeletonIndex);
+		}
+		for (const FSkinnedMeshAttachmentRuntime& Attachment : Runtime.Attachments)
+		{
+			if (UTurboSequence_RenderData* const* RenderData = Library.PerReferenceData.Find(Attachment.RenderHandle))
+			{
+				(*RenderData)->SetSkeletonIndex(Attachment.AttachmentHandle, SkeletonIndex);
+			}
+		}
+		for (UNiagaraComponent* NiagaraComponent : Runtime.AttachedParticles)
+		{
+			if (IsValid(NiagaraComponent))
+			{
+				NiagaraComponent->SetIntParameter("User.SkeletonIndex", SkeletonIndex);
+			}
+		}
+	}
+
+	if (bShrink)
+	{
+		ResizeTransformTextures(NumPackedSlices);
+	}
+
+	INC_DWORD_STAT(STAT_BoneTextureCompactions);
+}
+
+void ATurboSequence_Manager_Lf::SolveMeshesParallel_GameThread(float DeltaTime, int64 CurrentFrameCount, int32 NumWorkers)
+{
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+
+	if (Library.SolveShards.Num() < NumWorkers)
+	{
+		Library.SolveShards.SetNum(NumWorkers);
+	}
+
+	// Every worker gets a contiguous dense range, merged back in the same order as the serial loop.
+	// Ranges are aligned to whole words of the visibility bits, so no two workers write the same word
+	const int32 NumMeshes = Library.RuntimeSkinnedMeshes.Num();
+	const int32 MeshesPerWorker = Align(FMath::DivideAndRoundUp(NumMeshes, NumWorkers), NumBitsPerDWORD);
+
+	// Workers only read the library, everything writing shared state is collected in their shard
+	const FSkinnedMeshGlobalLibrary_Lf& ConstLibrary = Library;
+	ParallelFor(NumWorkers, [&](int32 WorkerIndex)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Solve_TurboSequenceMeshes_Worker_Lf);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		FSkinnedMeshSolveShard_Lf& Shard = Library.SolveShards[WorkerIndex];
+		Shard.Reset();
+
+		const int32 StartIndex = WorkerIndex * MeshesPerWorker;
+		const int32 EndIndex = FMath::Min(StartIndex + MeshesPerWorker, NumMeshes);
+
+		FTurboSequence_Utility_Lf::CullMeshes(Library.RuntimeSkinnedMeshes, ConstLibrary.CameraViews, StartIndex, EndIndex);
+		Shard.CullingTimeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		for (int32 MeshIndex = StartIndex; MeshIndex < EndIndex; ++MeshIndex)
+		{
+			FSkinnedMeshRuntime_Lf& Runtime = Library.RuntimeSkinnedMeshes.GetDense(MeshIndex);
+
+			double CameraDistance;
+			const bool bUpdateAnimations = ConstLibrary.bAnimationUpdatesScheduled
+				                               ? ConstLibrary.ScheduledAnimationUpdates[MeshIndex]
+				                               : FTurboSequence_Utility_Lf::UpdateAnimationLOD(Runtime, ConstLibrary.CameraViews,
+				                                                                               DeltaTime, CurrentFrameCount, CameraDistance);
+			Shard.CountAnimationLOD(Runtime.AnimationLODBand, !bUpdateAnimations);
+
+			const float AnimationDeltaTime = bUpdateAnimations ? Runtime.ConsumePendingAnimationDeltaTime() : 0;
+			if (bUpdateAnimations && Runtime.AnimationBlendSpaceMetaData.Num())
+			{
+				Shard.DeferredMeshes.Add({&Runtime, true, AnimationDeltaTime});
+			}
+			else if (bUpdateAnimations && FTurboSequence_Utility_Lf::SolveAnimations_Concurrent(Runtime, ConstLibrary, AnimationDeltaTime,
+			                                                                                    CurrentFrameCount, Shard.ReleasedMasks))
+			{
+				Shard.DeferredMeshes.Add({&Runtime, false, AnimationDeltaTime});
+			}
+
+			if (ConstLibrary.RuntimeSkinnedMeshes.IsVisible(MeshIndex))
+			{
+				Shard.NumVisibleMeshes++;
+			}
+
+			Shard.RendererBounds.FindOrAdd(ConstLibrary.PerReferenceData[Runtime.RenderHandle]).Add(Runtime.WorldSpaceTransform);
+
+			for (const FSkinnedMeshAttachmentRuntime& Attachment : Runtime.Attachments)
+			{
+				Shard.RendererBounds.FindOrAdd(ConstLibrary.PerReferenceData[Attachment.RenderHandle]).Add(Runtime.WorldSpaceTransform);
+			}
+		}
+
+		Shard.SolveTimeSeconds = FPlatformTime::Seconds() - StartTime;
+	});
+
+	SCOPE_CYCLE_COUNTER(STAT_Solve_TurboSequenceMeshes_Merge_Lf);
+
+	double MaxWorkerTime = 0;
+	double MinWorkerTime = TNumericLimits<double>::Max();
+	double MaxWorkerCullingTime = 0;
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		const FSkinnedMeshSolveShard_Lf& Shard = Library.SolveShards[WorkerIndex];
+
+		for (const FBoneMaskBuiltProxyHandle& ReleasedMask : Shard.ReleasedMasks)
+		{
+			FTurboSequence_Utility_Lf::ReleaseAnimationMask(Library, ReleasedMask);
+		}
+
+		// Keyframes get their GPU index here, in shard order, so the library layout matches the serial solve
+		for (const FSkinnedMeshDeferredSolve_Lf& DeferredMesh : Shard.DeferredMeshes)
+		{
+			if (DeferredMesh.bNeedsFullSolve)
+			{
+				FTurboSequence_Utility_Lf::SolveAnimations(*DeferredMesh.Runtime, Library, DeferredMesh.DeltaTime, CurrentFrameCount);
+			}
+			else
+			{
+				FTurboSequence_Utility_Lf::ResolveAnimationsInLibrary(*DeferredMesh.Runtime, Library);
+			}
+		}
+
+		for (const TTuple<UTurboSequence_RenderData*, FRendererBoundsPartial_Lf>& RendererBounds : Shard.RendererBounds)
+		{
+			RendererBounds.Key->MergeRendererBounds(RendererBounds.Value);
+		}
+
+		INC_DWORD_STAT_BY(STAT_VisibleMeshCount, Shard.NumVisibleMeshes);
+		IncAnimationLODStats_Lf(Shard);
+
+		MaxWorkerTime = FMath::Max(MaxWorkerTime, Shard.SolveTimeSeconds);
+		MinWorkerTime = FMath::Min(MinWorkerTime, Shard.SolveTimeSeconds);
+		MaxWorkerCullingTime = FMath::Max(MaxWorkerCullingTime, Shard.CullingTimeSeconds);
+	}
+	Library.CullingTimeSeconds += MaxWorkerCullingTime;
+
+	INC_DWORD_STAT_BY(STAT_SolveWorkerCount, NumWorkers);
+	INC_FLOAT_STAT_BY(STAT_SolveWorkerMaxTime, MaxWorkerTime * 1000.0);
+	INC_FLOAT_STAT_BY(STAT_SolveWorkerMinTime, MinWorkerTime * 1000.0);
+}
+
+void ATurboSequence_Manager_Lf::SolveAnimationGroups_GameThread(float DeltaTime, int64 CurrentFrameCount)
+{
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+
+	for (TPair<FTurboSequence_AnimationGroupHandle_Lf, FSkinnedMeshAnimationGroup_Lf>& Group : Library.AnimationGroups)
+	{
+		if (!Group.Value.NumMeshes)
+		{
+			continue;
+		}
+
+		FTurboSequence_Utility_Lf::SolveAnimations(Group.Value.Timeline, Library, DeltaTime, CurrentFrameCount);
+
+		for (FSkinnedMeshAnimationGroupPhase_Lf& Phase : Group.Value.Phases)
+		{
+			if (Phase.PhaseOffset)
+			{
+				FTurboSequence_Utility_Lf::ResolveAnimationGroupPhase(Group.Value, Phase, Library);
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_AnimationGroupMeshes, Group.Value.NumMeshes);
+		INC_DWORD_STAT_BY(STAT_AnimationGroupPhases, Group.Value.Phases.Num());
+	}
+}
+
+void ATurboSequence_Manager_Lf::BuildFrameSnapshot_GameThread()
+{
+	SCOPE_CYCLE_COUNTER(STAT_BuildFrameSnapshot_TurboSequence_Lf);
+
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+
+	if(Library.bMasksNeedRebuilding || Library.MasksBuiltBoneCount != Library.MaxNumCPUBones)
+	{
+		Library.ProxyToIndex.Reset();
+
+		int32 MaskCount = 0;
+
+		const int32 NumCPUBones = Library.MaxNumCPUBones;
+
+		const int32 NumLayers = Library.AnimationBlendLayerMasks.Num() * NumCPUBones;
+
+		TArray<int32>& AnimationLayers = Library.ReferenceData.AnimationLayers;
+		AnimationLayers.Reset(NumLayers);
+		
+		for (const auto & AnimationBlendLayerMask : Library.AnimationBlendLayerMasks)
+		{
+			Library.ProxyToIndex.Add(AnimationBlendLayerMask.Key, MaskCount++);
+
+			for (uint16 RawAnimationLayer : AnimationBlendLayerMask.Value.RawAnimationLayers)
+			{
+				AnimationLayers.Add(RawAnimationLayer);
+			}
+
+			//Pad to NumCPUBones
+			for(int32 BoneIndex = AnimationBlendLayerMask.Value.RawAnimationLayers.Num(); BoneIndex < NumCPUBones; ++BoneIndex)
+			{
+				AnimationLayers.Add(0);
+			}
+		}
+		
+		Library.bMasksNeedRebuilding = false;
+		Library.MasksBuiltBoneCount = Library.MaxNumCPUBones;
+		Library.ReferenceData.AnimationLayersVersion++;
+	}
+
+	if(Library.bRefreshAsyncChunkedMeshData)
+	{
+		FTurboSequence_Utility_Lf::RefreshAsyncChunkedMeshData(Library);
+		
+		Library.bRefreshAsyncChunkedMeshData = false;
+
+		// The reference data changed, no bone texture row can be reused
+		for (FSkinnedMeshRuntime_Lf& Runtime : Library.RuntimeSkinnedMeshes)
+		{
+			Runtime.bBoneTextureDirty = true;
+		}
+	}
+
+	// When no solve consumed the last snapshot this one replaces it,
+	// the meshes it solved are not in the texture yet and can't be skipped
+	const bool bReplacesUnreadSnapshot = bFrameSnapshotAwaitsSolve;
+
+	FSkinnedMeshFrameSnapshot_Lf Snapshot;
+	{
+		FScopeLock Lock(&FrameSnapshotPoolLock);
+		if (FrameSnapshotPool.Num())
+		{
+			Snapshot = FrameSnapshotPool.Pop();
+		}
+	}
+	Snapshot.ResetFrameData();
+	Snapshot.ReferenceData.CopyChanged(Library.ReferenceData);
+
+	// Appends the blended animations of a mesh or group timeline and returns how many
+	auto AddSnapshotAnimations = [&Library, &Snapshot](const FSkinnedMeshRuntime_Lf& AnimationRuntime,
+	                                                   TArray<FAnimationMetaData_Lf>& AnimationMetaData)
+	{
+		TArray<int32, TInlineAllocator<8>> BlendedAnimations;
+		float WeightScale;
+		FTurboSequence_Utility_Lf::GetBlendedAnimations(AnimationRuntime, BlendedAnimations, WeightScale);
+
+		for (const int32 AnimIdx : BlendedAnimations)
+		{
+			FAnimationMetaData_Lf& Animation = AnimationMetaData[AnimIdx];
+
+			Snapshot.AnimationFramePose0.Add(Animation.GPUAnimationIndex_0);
+			Snapshot.AnimationFramePose1.Add(Animation.GPUAnimationIndex_1);
+			Snapshot.AnimationFrameAlpha.Add(Animation.FrameAlpha * 0x7FFF);
+			Snapshot.AnimationWeights.Add(FMath::Min(Animation.FinalAnimationWeight * WeightScale, 1.0f) * 0x7FFF);
+
+			// The layer order only changes with a mask rebuild
+			if (Animation.MaskLayerVersion != Library.ReferenceData.AnimationLayersVersion)
+			{
+				const int32* LayerMaskIndex = Library.ProxyToIndex.Find(Animation.MaskProxyHandle);
+				ensure(LayerMaskIndex);
+
+				Animation.MaskLayerIndex = LayerMaskIndex ? *LayerMaskIndex : 0;
+				Animation.MaskLayerVersion = Library.ReferenceData.AnimationLayersVersion;
+			}
+
+			Snapshot.AnimationLayerIndex.Add(Animation.MaskLayerIndex);
+		}
+
+		return BlendedAnimations.Num();
+	};
+
+	// Every phase of a group writes its animations once, its meshes all point to the same range
+	for (TPair<FTurboSequence_AnimationGroupHandle_Lf, FSkinnedMeshAnimationGroup_Lf>& Group : Library.AnimationGroups)
+	{
+		for (FSkinnedMeshAnimationGroupPhase_Lf& Phase : Group.Value.Phases)
+		{
+			Phase.SnapshotAnimationStartIndex = INDEX_NONE;
+		}
+	}
+
+	const int32 NumMeshes = Library.RuntimeSkinnedMeshes.Num();
+	for (int32 DenseIndex = 0; DenseIndex < NumMeshes; ++DenseIndex)
+	{
+		if (!Library.RuntimeSkinnedMeshes.IsVisible(DenseIndex))
+		{
+			continue;
+		}
+
+		FSkinnedMeshRuntime_Lf& Runtime = Library.RuntimeSkinnedMeshes.GetDense(DenseIndex);
+
+		if (Runtime.ReferenceIndexVersion != Library.ReferenceData.ReferenceDataVersion)
+		{
+			Runtime.ReferenceIndex = Library.PerReferenceDataKeys.Find(Runtime.DataAsset);
+			Runtime.ReferenceIndexVersion = Library.ReferenceData.ReferenceDataVersion;
+		}
+		
+		ensure(Runtime.ReferenceIndex != INDEX_NONE);
+
+		// Meshes skipped by the animation LOD keep the rows written by their last GPU solve
+		if (Runtime.AnimationLODBand != INDEX_NONE && !Runtime.bBoneTextureDirty && !bReplacesUnreadSnapshot)
+		{
+			INC_DWORD_STAT(STAT_ReusedBoneTextureMeshCount);
+			if (Runtime.bPreviousBoneRowsStale)
+			{
+				Runtime.bPreviousBoneRowsStale = false;
+				Snapshot.NumCopyOnlyMeshes++;
+				Snapshot.CopyOnlyCustomDataIndex.Add(Runtime.BoneTextureSkeletonIndex);
+				Snapshot.CopyOnlyCustomDataCollectionIndex.Add(Runtime.ReferenceIndex);
+			}
+			continue;
+		}
+		Runtime.bBoneTextureDirty = false;
+		Runtime.bPreviousBoneRowsStale = true;
+		
+		Snapshot.NumMeshes++;
+		
+		//Mesh to skeleton reference
+		Snapshot.PerMeshCustomDataIndex.Add(Runtime.BoneTextureSkeletonIndex);
+		Snapshot.PerMeshCustomDataCollectionIndex.Add(Runtime.ReferenceIndex);
+
+		// The replaced snapshot may have carried the reset of this mesh
+		Snapshot.PerMeshResetPreviousRows.Add(Runtime.bPreviousBoneRowsInvalid || bReplacesUnreadSnapshot);
+		Runtime.bPreviousBoneRowsInvalid = false;
+		
+		//Animations
+		FSkinnedMeshAnimationGroup_Lf* Group = Runtime.AnimationGroup.IsValid() ? Library.AnimationGroups.Find(Runtime.AnimationGroup) : nullptr;
+		FSkinnedMeshAnimationGroupPhase_Lf* Phase = Group ? Group->FindPhase(Runtime.AnimationGroupPhaseOffset) : nullptr;
+		if (Phase)
+		{
+			if (Phase->SnapshotAnimationStartIndex == INDEX_NONE)
+			{
+				Phase->SnapshotAnimationStartIndex = Snapshot.AnimationFramePose0.Num();
+				Phase->SnapshotNumAnimations = AddSnapshotAnimations(Group->Timeline, Phase->PhaseOffset
+					                                                                      ? Phase->AnimationMetaData
+					                                                                      : Group->Timeline.AnimationMetaData);
+			}
+
+			Snapshot.AnimationStartIndex.Add(Phase->SnapshotAnimationStartIndex);
+			Snapshot.AnimationEndIndex.Add(Phase->SnapshotNumAnimations);
+		}
+		else
+		{
+			Snapshot.AnimationStartIndex.Add(Snapshot.AnimationFramePose0.Num());
+			Snapshot.AnimationEndIndex.Add(AddSnapshotAnimations(Runtime, Runtime.AnimationMetaData));
+		}
+
+		//ID data
+		int32 NumIKBones = 0;
+		int32 LastIKDataIndex = Snapshot.BoneSpaceAnimationIKData.Num();
+
+		for (auto & IKData : Runtime.OverrideBoneTransforms)
+		{
+			const int32 CPUBoneIndex = IKData.Key;
+			
+			if(const int* GPUBoneIndex = Runtime.DataAsset->CPUBoneToGPUBoneIndicesMap.Find(CPUBoneIndex))
+			{
+				Snapshot.BoneSpaceAnimationIKData.Add(*GPUBoneIndex);
+
+				const FMatrix& BoneMatrix = IKData.Value.OverrideTransform.ToMatrixWithScale();
+
+				for (int32 M = 0; M < 3; ++M)
+				{
+					FVector4f BoneData;
+					BoneData.X = BoneMatrix.M[0][M];
+					BoneData.Y = BoneMatrix.M[1][M];
+					BoneData.Z = BoneMatrix.M[2][M];
+					BoneData.W = BoneMatrix.M[3][M];
+
+					Snapshot.BoneSpaceAnimationIKInput.Add(BoneData);
+				}
+						
+				NumIKBones++;
+			}
+		}
+
+		Snapshot.BoneSpaceAnimationIKStartIndex.Add(LastIKDataIndex);
+		Snapshot.BoneSpaceAnimationIKEndIndex.Add(NumIKBones);
+	}
+
+	Snapshot.PerMeshCustomDataIndex.Append(Snapshot.CopyOnlyCustomDataIndex);
+	Snapshot.PerMeshCustomDataCollectionIndex.Append(Snapshot.CopyOnlyCustomDataCollectionIndex);
+
+	// By value, a snapshot published before the render thread ran the commands of the last frame must not be solved
+	// against the library uploads and bone texture slots of that frame
+	bFrameSnapshotAwaitsSolve = true;
+	ENQUEUE_RENDER_COMMAND(TurboSequence_PublishFrameSnapshot_Lf)(
+		[Snapshot = MoveTemp(Snapshot)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			PendingFrameSnapshot_RenderThread = MoveTemp(Snapshot);
+		});
+}
+
+void ATurboSequence_Manager_Lf::SolveMeshes_RenderThread(FRHICommandListImmediate& RHICmdList)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Solve_TurboSequenceMeshes_RT_Lf);
+
+	FMeshUnitComputeShader_Params_Lf& MeshParams = GlobalLibrary_RenderThread.BoneTransformParams;
+
+	// Without a new snapshot the meshes of the last one are solved again
+	if (PendingFrameSnapshot_RenderThread.IsSet())
+	{
+		FSkinnedMeshFrameSnapshot_Lf& Snapshot = PendingFrameSnapshot_RenderThread.GetValue();
+
+		// Swapping hands the arrays of the last frame back to the snapshot, which the game thread reuses
+		Swap(MeshParams.PerMeshCustomDataIndex_Global_RenderThread, Snapshot.PerMeshCustomDataIndex);
+		Swap(MeshParams.PerMeshCustomDataCollectionIndex_RenderThread, Snapshot.PerMeshCustomDataCollectionIndex);
+		Swap(MeshParams.PerMeshResetPreviousRows_RenderThread, Snapshot.PerMeshResetPreviousRows);
+		Swap(MeshParams.AnimationStartIndex_RenderThread, Snapshot.AnimationStartIndex);
+		Swap(MeshParams.AnimationEndIndex_RenderThread, Snapshot.AnimationEndIndex);
+		Swap(MeshParams.AnimationFramePose0_RenderThread, Snapshot.AnimationFramePose0);
+		Swap(MeshParams.AnimationFramePose1_RenderThread, Snapshot.AnimationFramePose1);
+		Swap(MeshParams.AnimationFrameAlpha_RenderThread, Snapshot.AnimationFrameAlpha);
+		Swap(MeshParams.AnimationWeights_RenderThread, Snapshot.AnimationWeights);
+		Swap(MeshParams.AnimationLayerIndex_RenderThread, Snapshot.AnimationLayerIndex);
+		Swap(MeshParams.BoneSpaceAnimationIKStartIndex_RenderThread, Snapshot.BoneSpaceAnimationIKStartIndex);
+		Swap(MeshParams.BoneSpaceAnimationIKEndIndex_RenderThread, Snapshot.BoneSpaceAnimationIKEndIndex);
+		Swap(MeshParams.BoneSpaceAnimationIKInput_RenderThread, Snapshot.BoneSpaceAnimationIKInput);
+		Swap(MeshParams.BoneSpaceAnimationIKData_RenderThread, Snapshot.BoneSpaceAnimationIKData);
+
+		MeshParams.NumMeshes = Snapshot.NumMeshes;
+		MeshParams.NumCopyOnlyMeshes = Snapshot.NumCopyOnlyMeshes;
+
+		const FSkinnedMeshReferenceData_Lf& ReferenceData = Snapshot.ReferenceData;
+		if (MeshParams.ReferenceDataVersion != ReferenceData.ReferenceDataVersion)
+		{
+			MeshParams.ReferenceDataVersion = ReferenceData.ReferenceDataVersion;
+			MeshParams.NumMaxCPUBones = ReferenceData.NumMaxCPUBones;
+			MeshParams.ReferenceNumCPUBones_RenderThread = ReferenceData.ReferenceNumCPUBones;
+			MeshParams.Indices = ReferenceData.Indices;
+			MeshParams.CPUInverseReferencePose = ReferenceData.CPUInverseReferencePose;
+		}
+		if (MeshParams.AnimationLayersVersion != ReferenceData.AnimationLayersVersion)
+		{
+			MeshParams.AnimationLayersVersion = ReferenceData.AnimationLayersVersion;
+			MeshParams.AnimationLayers_RenderThread = ReferenceData.AnimationLayers;
+		}
+
+		FScopeLock Lock(&FrameSnapshotPoolLock);
+		FrameSnapshotPool.Add(MoveTemp(Snapshot));
+		PendingFrameSnapshot_RenderThread.Reset();
+	}
 
 	//Need elements in all arrays (seems to be a compute requirement)
 	FTurboSequence_Helper_Lf::CheckArrayHasSize(MeshParams.ReferenceNumCPUBones_RenderThread);
 	FTurboSequence_Helper_Lf::CheckArrayHasSize(MeshParams.PerMeshCustomDataIndex_Global_RenderThread);
 	FTurboSequence_Helper_Lf::CheckArrayHasSize(MeshParams.PerMeshCustomDataCollectionIndex_RenderThread);
+	FTurboSequence_Helper_Lf::CheckArrayHasSize(MeshParams.PerMeshResetPreviousRows_RenderThread);
 	FTurboSequence_Helper_Lf::CheckArrayHasSize(MeshParams.AnimationStartIndex_RenderThread);
 	FTurboSequence_Helper_Lf::CheckArrayHasSize(MeshParams.AnimationEndIndex_RenderThread);
 	FTurboSequence_Helper_Lf::CheckArrayHasSize(MeshParams.AnimationFrameAlpha_RenderThread);
@@ -1005,6 +1828,21 @@ void ATurboSequence_Manager_Lf::CleanManager_GameThread(bool bIsEndPlay)
 {
 	if (bIsEndPlay && IsValid(Instance))
 	{
+		// The transform textures are assets, hand them back in the size they were loaded with
+		const int32 InitialSlices = Instance->GlobalLibrary.InitialTransformTextureSlices;
+		if (InitialSlices > 0 && IsValid(Instance->GlobalData) && IsValid(Instance->GlobalData->TransformTexture_CurrentFrame) &&
+			static_cast<int32>(Instance->GlobalData->TransformTexture_CurrentFrame->Slices) != InitialSlices)
+		{
+			ResizeTransformTextures(InitialSlices);
+		}
+
+		// The workers still reference the animations
+		for (FAnimationKeyframeSample_Lf& Sample : Instance->GlobalLibrary.PendingKeyframeSamples)
+		{
+			Sample.Task.Wait();
+		}
+		Instance->GlobalLibrary.PendingKeyframeSamples.Empty();
+
 		ENQUEUE_RENDER_COMMAND(TurboSequence_EndPlayBufferClear_Lf)(
 			[&](FRHICommandListImmediate& RHICmdList)
 			{
@@ -1029,14 +1867,78 @@ FTransform ATurboSequence_Manager_Lf::GetMeshWorldSpaceTransform(FBaseSkeletalMe
 	return FTransform::Identity;
 }
 
+int32 ATurboSequence_Manager_Lf::QueryMeshesInRadius(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs,
+                                                     const FVector& Location, float Radius)
+{
+	OutMeshIDs.Reset();
+	Instance->GlobalLibrary.RuntimeSkinnedMeshes.QueryMeshesInRadius(OutMeshIDs, Location, FMath::Max(Radius, 0.0f));
+	return OutMeshIDs.Num();
+}
+
+int32 ATurboSequence_Manager_Lf::QueryMeshesInBox(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs, const FBox& Box)
+{
+	OutMeshIDs.Reset();
+	if (Box.IsValid)
+	{
+		Instance->GlobalLibrary.RuntimeSkinnedMeshes.QueryMeshesInBox(OutMeshIDs, Box);
+	}
+	return OutMeshIDs.Num();
+}
+
+// Consecutive meshes of a batch mostly share their renderer, skips the renderer lookup for those
+struct FRenderDataLookupCache_Lf
+{
+	UTurboSequence_RenderData* Find(const TMap<FTurboSequenceRenderHandle, UTurboSequence_RenderData*>& PerReferenceData,
+	                                const FTurboSequenceRenderHandle& Handle)
+	{
+		if (!RenderData || RenderHandle != Handle)
+		{
+			RenderHandle = Handle;
+			RenderData = PerReferenceData[Handle];
+		}
+		return RenderData;
+	}
+
+	FTurboSequenceRenderHandle RenderHandle;
+	UTurboSequence_RenderData* RenderData = nullptr;
+};
+
 void ATurboSequence_Manager_Lf::SetMeshWorldSpaceTransform(
 	const FBaseSkeletalMeshHandle MeshID, const FTransform& Transform)
 {
-	if(FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID))
+	FRenderDataLookupCache_Lf RenderDataCache;
+	SetMeshWorldSpaceTransform_Internal(MeshID, Transform, RenderDataCache);
+}
+
+int32 ATurboSequence_Manager_Lf::SetMeshWorldSpaceTransforms(const TArray<FBaseSkeletalMeshHandle>& MeshIDs,
+                                                              const TArray<FTransform>& Transforms)
+{
+	if (MeshIDs.Num() != Transforms.Num())
+	{
+		UE_LOG(LogTurboSequence_Lf, Warning, TEXT("SetMeshWorldSpaceTransforms needs a transform per mesh, got %d meshes and %d transforms..."),
+		       MeshIDs.Num(), Transforms.Num());
+		return 0;
+	}
+
+	int32 NumUpdated = 0;
+	FRenderDataLookupCache_Lf RenderDataCache;
+	for (int32 MeshIndex = 0; MeshIndex < MeshIDs.Num(); ++MeshIndex)
+	{
+		NumUpdated += SetMeshWorldSpaceTransform_Internal(MeshIDs[MeshIndex], Transforms[MeshIndex], RenderDataCache);
+	}
+	return NumUpdated;
+}
+
+bool ATurboSequence_Manager_Lf::SetMeshWorldSpaceTransform_Internal(const FBaseSkeletalMeshHandle MeshID, const FTransform& Transform,
+                                                                    FRenderDataLookupCache_Lf& RenderDataCache)
+{
+	if(const int32 DenseIndex = Instance->GlobalLibrary.RuntimeSkinnedMeshes.GetDenseIndex(MeshID); DenseIndex != INDEX_NONE)
 	{
+		FSkinnedMeshRuntime_Lf* Runtime = &Instance->GlobalLibrary.RuntimeSkinnedMeshes.GetDense(DenseIndex);
 		Runtime->WorldSpaceTransform = Transform;
+		Instance->GlobalLibrary.RuntimeSkinnedMeshes.UpdateCullingBounds(DenseIndex);
 
-		UTurboSequence_RenderData* RenderData = Instance->GlobalLibrary.PerReferenceData[Runtime->RenderHandle];
+		UTurboSequence_RenderData* RenderData = RenderDataCache.Find(Instance->GlobalLibrary.PerReferenceData, Runtime->RenderHandle);
 
 		RenderData->UpdateInstanceTransform(MeshID, Transform);
 
@@ -1052,6 +1954,85 @@ void ATurboSequence_Manager_Lf::SetMeshWorldSpaceTransform(
 		{
 			NiagaraComponent->SetWorldTransform(Transform);
 		}
+		return true;
+	}
+	return false;
+}
+
+void ATurboSequence_Manager_Lf::ApplyAutoRootMotion_GameThread(int64 CurrentFrameCount)
+{
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	if (!Library.NumAutoRootMotionMeshes)
+	{
+		return;
+	}
+
+	const int32 NumMeshes = Library.RuntimeSkinnedMeshes.Num();
+	const int32 NumWorkers = GetNumSolveWorkers(NumMeshes);
+	const int32 MeshesPerWorker = FMath::DivideAndRoundUp(NumMeshes, NumWorkers);
+	if (Library.AutoRootMotionShards.Num() < NumWorkers)
+	{
+		Library.AutoRootMotionShards.SetNum(NumWorkers);
+	}
+
+	// Workers only write the transform of their own meshes, everything shared is written in the merge
+	ParallelFor(NumWorkers, [&Library, NumMeshes, MeshesPerWorker, CurrentFrameCount](int32 WorkerIndex)
+	{
+		const int32 StartIndex = WorkerIndex * MeshesPerWorker;
+		const int32 EndIndex = FMath::Min(StartIndex + MeshesPerWorker, NumMeshes);
+
+		TArray<int32>& Shard = Library.AutoRootMotionShards[WorkerIndex];
+		Shard.Reset();
+
+		for (int32 DenseIndex = StartIndex; DenseIndex < EndIndex; ++DenseIndex)
+		{
+			FSkinnedMeshRuntime_Lf& Runtime = Library.RuntimeSkinnedMeshes.GetDense(DenseIndex);
+
+			FTransform Atom;
+			if (!Runtime.bAutoRootMotion ||
+				!FTurboSequence_Utility_Lf::GetSolvedRootMotion(Atom, Runtime, Library, CurrentFrameCount))
+			{
+				continue;
+			}
+
+			// Same as MoveMeshWithRootMotion
+			if (Runtime.bAutoRootMotionZeroZAxis)
+			{
+				FVector AtomLocation = Atom.GetLocation();
+				AtomLocation.Z = 0;
+				Atom.SetLocation(AtomLocation);
+			}
+
+			Atom *= Runtime.WorldSpaceTransform;
+			if (Runtime.bAutoRootMotionIncludeScale)
+			{
+				Runtime.WorldSpaceTransform.SetScale3D(Atom.GetScale3D());
+			}
+			Runtime.WorldSpaceTransform.SetRotation(Atom.GetRotation());
+			Runtime.WorldSpaceTransform.SetLocation(Atom.GetLocation());
+
+			Shard.Add(DenseIndex);
+		}
+	}, NumWorkers > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	FRenderDataLookupCache_Lf RenderDataCache;
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		for (const int32 DenseIndex : Library.AutoRootMotionShards[WorkerIndex])
+		{
+			const FSkinnedMeshRuntime_Lf& Runtime = Library.RuntimeSkinnedMeshes.GetDense(DenseIndex);
+			SetMeshWorldSpaceTransform_Internal(Runtime.MeshID, Runtime.WorldSpaceTransform, RenderDataCache);
+
+			// The culling ran before the solve moved the mesh, test the refreshed sphere again
+			FTurboSequence_Utility_Lf::CullMeshes(Library.RuntimeSkinnedMeshes, Library.CameraViews, DenseIndex, DenseIndex + 1);
+
+			// The solve grew the renderer bounds by the transform before the move
+			RenderDataCache.Find(Library.PerReferenceData, Runtime.RenderHandle)->UpdateRendererBounds(Runtime.WorldSpaceTransform);
+			for (const FSkinnedMeshAttachmentRuntime& Attachment : Runtime.Attachments)
+			{
+				Library.PerReferenceData[Attachment.RenderHandle]->UpdateRendererBounds(Runtime.WorldSpaceTransform);
+			}
+		}
 	}
 }
 
@@ -1064,7 +2045,7 @@ bool ATurboSequence_Manager_Lf::GetRootMotionTransform(FTransform& OutRootMotion
 	}
 
 	const FSkinnedMeshRuntime_Lf& Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes[MeshID];
-	FTurboSequence_Utility_Lf::ExtractRootMotionFromAnimations(OutRootMotion, Runtime, DeltaTime);
+	FTurboSequence_Utility_Lf::ExtractRootMotionFromAnimations(OutRootMotion, Runtime, Instance->GlobalLibrary, DeltaTime);
 
 	if (Space == EBoneSpaces::ComponentSpace)
 	{
@@ -1098,6 +2079,7 @@ void ATurboSequence_Manager_Lf::MoveMeshWithRootMotion(FBaseSkeletalMeshHandle M
 		}
 		Runtime.WorldSpaceTransform.SetRotation(Atom.GetRotation());
 		Runtime.WorldSpaceTransform.SetLocation(Atom.GetLocation());
+		Instance->GlobalLibrary.RuntimeSkinnedMeshes.UpdateCullingBounds(Instance->GlobalLibrary.RuntimeSkinnedMeshes.GetDenseIndex(MeshID));
 
 		UTurboSequence_RenderData* RenderData = Instance->GlobalLibrary.PerReferenceData[Runtime.RenderHandle];
 		
@@ -1111,8 +2093,6 @@ FTurboSequence_AnimMinimalData_Lf ATurboSequence_Manager_Lf::PlayAnimation(const
                                                                                             UAnimSequence* Animation, const FTurboSequence_AnimPlaySettings_Lf& AnimSettings, const bool bForceLoop, const bool
                                                                                             bForceFront)
 {
-	FScopeLock ScopeLock(&Instance->RenderThreadDataConsistency);
-	
 	FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID);
 
 	if (!Runtime)
@@ -1134,6 +2114,40 @@ FTurboSequence_AnimMinimalData_Lf ATurboSequence_Manager_Lf::PlayAnimation(const
 	return MinimalAnimation;
 }
 
+int32 ATurboSequence_Manager_Lf::PlayAnimationBatch(TArray<FTurboSequence_AnimMinimalData_Lf>& OutAnimations,
+                                                    const TArray<FBaseSkeletalMeshHandle>& MeshIDs,
+                                                    UAnimSequence* Animation,
+                                                    const FTurboSequence_AnimPlaySettings_Lf& AnimSettings,
+                                                    const bool bForceLoop, const bool bForceFront)
+{
+	OutAnimations.Reset(MeshIDs.Num());
+
+	bool bLoop = true;
+	if (IsValid(Animation)) // Cause of rest pose will pass here
+	{
+		bLoop = Animation->bLoop || bForceLoop;
+	}
+
+	int32 NumPlayed = 0;
+	for (const FBaseSkeletalMeshHandle MeshID : MeshIDs)
+	{
+		FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID);
+		if (!Runtime)
+		{
+			OutAnimations.Add(FTurboSequence_AnimMinimalData_Lf(false));
+			continue;
+		}
+
+		FTurboSequence_AnimMinimalData_Lf& MinimalAnimation = OutAnimations.Add_GetRef(FTurboSequence_AnimMinimalData_Lf(true));
+		MinimalAnimation.BelongsToMeshID = MeshID;
+		MinimalAnimation.AnimationID = FTurboSequence_Utility_Lf::PlayAnimation(
+			Instance->GlobalLibrary, *Runtime, Animation, AnimSettings,
+			bLoop, INDEX_NONE, INDEX_NONE, INDEX_NONE, bForceFront);
+		NumPlayed++;
+	}
+	return NumPlayed;
+}
+
 FTurboSequence_AnimMinimalBlendSpace_Lf ATurboSequence_Manager_Lf::PlayBlendSpace(FBaseSkeletalMeshHandle MeshID,
 	UBlendSpace* BlendSpace, const FTurboSequence_AnimPlaySettings_Lf& AnimSettings)
 {
@@ -1169,10 +2183,17 @@ void ATurboSequence_Manager_Lf::GetAnimNotifies(FBaseSkeletalMeshHandle MeshID,
 {
 	if (const FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID))
 	{
-		FTurboSequence_Utility_Lf::GetAnimNotifies(*Runtime, NotifyQueue);
+		FTurboSequence_Utility_Lf::GetAnimNotifies(*Runtime, Instance->GlobalLibrary, NotifyQueue);
 	}
 }
 
+int32 ATurboSequence_Manager_Lf::ConsumeAnimNotifies(TArray<FTurboSequence_AnimNotifyEvent_Lf>& OutEvents)
+{
+	OutEvents = MoveTemp(Instance->GlobalLibrary.AnimNotifyEvents);
+	Instance->GlobalLibrary.AnimNotifyEvents.Reset();
+	return OutEvents.Num();
+}
+
 bool ATurboSequence_Manager_Lf::TweakAnimation(const FTurboSequence_AnimPlaySettings_Lf& TweakSettings,
                                                           const FTurboSequence_AnimMinimalData_Lf& AnimationData)
 {
@@ -1249,6 +2270,214 @@ void ATurboSequence_Manager_Lf::SetAnimationTick(FBaseSkeletalMeshHandle MeshID,
 	}
 }
 
+void ATurboSequence_Manager_Lf::SetAutoRootMotion(FBaseSkeletalMeshHandle MeshID, const bool bInAutoRootMotion,
+                                                  const bool ZeroZAxis, const bool bIncludeScale)
+{
+	if(FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID))
+	{
+		Instance->GlobalLibrary.NumAutoRootMotionMeshes += bInAutoRootMotion - Runtime->bAutoRootMotion;
+		Runtime->bAutoRootMotion = bInAutoRootMotion;
+		Runtime->bAutoRootMotionZeroZAxis = ZeroZAxis;
+		Runtime->bAutoRootMotionIncludeScale = bIncludeScale;
+	}
+}
+
+void ATurboSequence_Manager_Lf::SetPoseCacheEnabled(FBaseSkeletalMeshHandle MeshID, const bool bInPoseCacheEnabled)
+{
+	if(FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID))
+	{
+		Runtime->bPoseCacheEnabled = bInPoseCacheEnabled;
+		if (!bInPoseCacheEnabled)
+		{
+			Runtime->PoseCache = FSkinnedMeshPoseCache_Lf();
+		}
+	}
+}
+
+FTurboSequence_AnimationGroupHandle_Lf ATurboSequence_Manager_Lf::CreateAnimationGroup(UTurboSequence_MeshAsset_Lf* FromAsset)
+{
+	if (!IsValid(Instance) || !IsValid(FromAsset) || !FromAsset->IsMeshAssetValid())
+	{
+		return FTurboSequence_AnimationGroupHandle_Lf();
+	}
+
+	// The animation library gets sized with the first mesh instance, the timeline has no keyframes to play before
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	if (!Library.AnimationLibraryAllocator.GetTotalSize())
+	{
+		UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't create an Animation Group before the first Mesh Instance is added..."));
+		return FTurboSequence_AnimationGroupHandle_Lf();
+	}
+
+	const FTurboSequence_AnimationGroupHandle_Lf GroupHandle(Library.LastAnimationGroupID++);
+
+	FSkinnedMeshAnimationGroup_Lf& Group = Library.AnimationGroups.Add(GroupHandle);
+	Group.Timeline.DataAsset = FromAsset;
+
+	// Same rest pose a mesh instance starts with
+	FTurboSequence_AnimPlaySettings_Lf PlaySetting = FTurboSequence_AnimPlaySettings_Lf();
+	PlaySetting.ForceMode = ETurboSequence_AnimationForceMode_Lf::AllLayers;
+	PlaySetting.RootMotionMode = ETurboSequence_RootMotionMode_Lf::None;
+
+	PlayGroupAnimation(GroupHandle, FromAsset->OverrideDefaultAnimation, PlaySetting);
+
+	return GroupHandle;
+}
+
+bool ATurboSequence_Manager_Lf::RemoveAnimationGroup(FTurboSequence_AnimationGroupHandle_Lf GroupHandle)
+{
+	if (!IsValid(Instance))
+	{
+		return false;
+	}
+
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	FSkinnedMeshAnimationGroup_Lf* Group = Library.AnimationGroups.Find(GroupHandle);
+	if (!Group)
+	{
+		return false;
+	}
+
+	if (Group->NumMeshes)
+	{
+		for (FSkinnedMeshRuntime_Lf& Runtime : Library.RuntimeSkinnedMeshes)
+		{
+			if (Runtime.AnimationGroup == GroupHandle)
+			{
+				Runtime.AnimationGroup = FTurboSequence_AnimationGroupHandle_Lf();
+				Runtime.AnimationGroupPhaseOffset = 0;
+				Runtime.bBoneTextureDirty = true;
+			}
+		}
+	}
+
+	FTurboSequence_Utility_Lf::ClearAnimations(Group->Timeline, Library, ETurboSequence_AnimationForceMode_Lf::AllLayers,
+	                                           TArray<FTurboSequence_BoneLayer_Lf>(),
+	                                           [](const FAnimationMetaData_Lf& Animation)
+	                                           {
+		                                           return true;
+	                                           });
+	if (Group->Timeline.AnimationMetaData.Num())
+	{
+		FTurboSequence_Utility_Lf::RemoveAnimation(Group->Timeline, Library, 0);
+	}
+
+	Library.AnimationGroups.Remove(GroupHandle);
+	return true;
+}
+
+bool ATurboSequence_Manager_Lf::AddMeshToAnimationGroup(FBaseSkeletalMeshHandle MeshID,
+                                                        FTurboSequence_AnimationGroupHandle_Lf GroupHandle, int32 PhaseOffset)
+{
+	if (!IsValid(Instance))
+	{
+		return false;
+	}
+
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	FSkinnedMeshRuntime_Lf* Runtime = Library.RuntimeSkinnedMeshes.Find(MeshID);
+	FSkinnedMeshAnimationGroup_Lf* Group = Library.AnimationGroups.Find(GroupHandle);
+	if (!Runtime || !Group)
+	{
+		return false;
+	}
+
+	// The group timeline is resolved against the reference skeleton of its asset
+	if (Runtime->DataAsset != Group->Timeline.DataAsset)
+	{
+		UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't add the mesh to the animation group, it uses a different mesh asset..."));
+		return false;
+	}
+
+	RemoveMeshFromAnimationGroup(MeshID);
+
+	FSkinnedMeshAnimationGroupPhase_Lf* Phase = Group->FindPhase(PhaseOffset);
+	if (!Phase)
+	{
+		Phase = &Group->Phases.AddDefaulted_GetRef();
+		Phase->PhaseOffset = PhaseOffset;
+	}
+	Phase->NumMeshes++;
+	Group->NumMeshes++;
+
+	Runtime->AnimationGroup = GroupHandle;
+	Runtime->AnimationGroupPhaseOffset = PhaseOffset;
+	Runtime->bBoneTextureDirty = true;
+
+	return true;
+}
+
+bool ATurboSequence_Manager_Lf::RemoveMeshFromAnimationGroup(FBaseSkeletalMeshHandle MeshID)
+{
+	if (!IsValid(Instance))
+	{
+		return false;
+	}
+
+	FSkinnedMeshGlobalLibrary_Lf& Library = Instance->GlobalLibrary;
+	FSkinnedMeshRuntime_Lf* Runtime = Library.RuntimeSkinnedMeshes.Find(MeshID);
+	if (!Runtime || !Runtime->AnimationGroup.IsValid())
+	{
+		return false;
+	}
+
+	if (FSkinnedMeshAnimationGroup_Lf* Group = Library.AnimationGroups.Find(Runtime->AnimationGroup))
+	{
+		const int32 PhaseIndex = Group->Phases.IndexOfByPredicate([Runtime](const FSkinnedMeshAnimationGroupPhase_Lf& Phase)
+		{
+			return Phase.PhaseOffset == Runtime->AnimationGroupPhaseOffset;
+		});
+		if (PhaseIndex != INDEX_NONE && !--Group->Phases[PhaseIndex].NumMeshes)
+		{
+			Group->Phases.RemoveAtSwap(PhaseIndex);
+		}
+		Group->NumMeshes--;
+	}
+
+	Runtime->AnimationGroup = FTurboSequence_AnimationGroupHandle_Lf();
+	Runtime->AnimationGroupPhaseOffset = 0;
+	Runtime->bBoneTextureDirty = true;
+
+	return true;
+}
+
+FTurboSequence_AnimMinimalData_Lf ATurboSequence_Manager_Lf::PlayGroupAnimation(FTurboSequence_AnimationGroupHandle_Lf GroupHandle,
+                                                                                UAnimSequence* Animation,
+                                                                                const FTurboSequence_AnimPlaySettings_Lf& AnimSettings,
+                                                                                const bool bForceLoop, const bool bForceFront)
+{
+	FSkinnedMeshAnimationGroup_Lf* Group = IsValid(Instance) ? Instance->GlobalLibrary.AnimationGroups.Find(GroupHandle) : nullptr;
+	if (!Group)
+	{
+		return FTurboSequence_AnimMinimalData_Lf(false);
+	}
+
+	bool bLoop = true;
+	if (IsValid(Animation)) // Cause of rest pose will pass here
+	{
+		bLoop = Animation->bLoop || bForceLoop;
+	}
+
+	FTurboSequence_AnimMinimalData_Lf MinimalAnimation = FTurboSequence_AnimMinimalData_Lf(true);
+	MinimalAnimation.AnimationID = FTurboSequence_Utility_Lf::PlayAnimation(
+		Instance->GlobalLibrary, Group->Timeline, Animation, AnimSettings,
+		bLoop, INDEX_NONE, INDEX_NONE, INDEX_NONE, bForceFront);
+	return MinimalAnimation;
+}
+
+bool ATurboSequence_Manager_Lf::TweakGroupAnimation(FTurboSequence_AnimationGroupHandle_Lf GroupHandle,
+                                                    const FTurboSequence_AnimPlaySettings_Lf& TweakSettings,
+                                                    const FTurboSequence_AnimMinimalData_Lf& AnimationData)
+{
+	if (FSkinnedMeshAnimationGroup_Lf* Group = IsValid(Instance) ? Instance->GlobalLibrary.AnimationGroups.Find(GroupHandle) : nullptr)
+	{
+		return FTurboSequence_Utility_Lf::TweakAnimation(Group->Timeline, Instance->GlobalLibrary,
+		                                                 TweakSettings, AnimationData.AnimationID);
+	}
+
+	return false;
+}
+
 bool ATurboSequence_Manager_Lf::GetBoneTransform(FTransform& OutIKTransform, const FBaseSkeletalMeshHandle MeshID,
                                                  const FName& BoneName,
                                                  const EBoneSpaces::Type Space)
@@ -1279,8 +2508,6 @@ bool ATurboSequence_Manager_Lf::UpdateOverrideBoneTransform(FBaseSkeletalMeshHan
                                                                 const FTransform& Transform,
                                                                 const EBoneSpaces::Type Space)
 {
-	FScopeLock ScopeLock(&Instance->RenderThreadDataConsistency);
-	
 	if(FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID))
 	{
 		if (!IsValid(Runtime->DataAsset))
@@ -1304,8 +2531,6 @@ bool ATurboSequence_Manager_Lf::UpdateOverrideBoneTransform(FBaseSkeletalMeshHan
 
 bool ATurboSequence_Manager_Lf::RemoveOverrideBoneTransform(FBaseSkeletalMeshHandle MeshID, const FName& BoneName)
 {
-	FScopeLock ScopeLock(&Instance->RenderThreadDataConsistency);
-	
 	if(FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshID))
 	{
 		if (!IsValid(Runtime->DataAsset))
@@ -1402,6 +2627,30 @@ FTurboSequence_PoseCurveData_Lf ATurboSequence_Manager_Lf::GetAnimationCurveValu
 	return FTurboSequence_Utility_Lf::GetAnimationCurveByAnimation(AnimationMetaData, Instance->GlobalLibrary, CurveName);
 }
 
+int32 ATurboSequence_Manager_Lf::GetAnimationCurveId(const FName& CurveName)
+{
+	return FTurboSequence_Utility_Lf::GetAnimationCurveId(Instance->GlobalLibrary, CurveName);
+}
+
+int32 ATurboSequence_Manager_Lf::GetCurveValues(TArray<float>& OutValues, const TArray<FBaseSkeletalMeshHandle>& MeshIDs,
+                                                int32 CurveId)
+{
+	OutValues.SetNumUninitialized(MeshIDs.Num());
+
+	int32 NumFound = 0;
+	for (int32 MeshIndex = 0; MeshIndex < MeshIDs.Num(); ++MeshIndex)
+	{
+		OutValues[MeshIndex] = 0;
+		if (const FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshIDs[MeshIndex]))
+		{
+			NumFound += FTurboSequence_Utility_Lf::GetAnimationCurveValue(OutValues[MeshIndex], *Runtime,
+			                                                              Instance->GlobalLibrary, CurveId);
+		}
+	}
+
+	return NumFound;
+}
+
 bool ATurboSequence_Manager_Lf::SetInstanceCustomData(
 	const FBaseSkeletalMeshHandle MeshID, const int Index,
 	const float Value, const bool bSetAttachments) 
@@ -1450,6 +2699,41 @@ bool ATurboSequence_Manager_Lf::SetInstanceCustomDataArray(
 	return false;
 }
 
+int32 ATurboSequence_Manager_Lf::SetInstanceCustomDataBatch(const TArray<FBaseSkeletalMeshHandle>& MeshIDs, const int Index,
+                                                             const TArray<float>& Values, const bool bSetAttachments)
+{
+	if (MeshIDs.Num() != Values.Num())
+	{
+		UE_LOG(LogTurboSequence_Lf, Warning, TEXT("SetInstanceCustomDataBatch needs a value per mesh, got %d meshes and %d values..."),
+		       MeshIDs.Num(), Values.Num());
+		return 0;
+	}
+
+	int32 NumSet = 0;
+	FRenderDataLookupCache_Lf RenderDataCache;
+	for (int32 MeshIndex = 0; MeshIndex < MeshIDs.Num(); ++MeshIndex)
+	{
+		const FSkinnedMeshRuntime_Lf* Runtime = Instance->GlobalLibrary.RuntimeSkinnedMeshes.Find(MeshIDs[MeshIndex]);
+		if (!Runtime)
+		{
+			continue;
+		}
+
+		if (bSetAttachments)
+		{
+			for (const FSkinnedMeshAttachmentRuntime& Attachment : Runtime->Attachments)
+			{
+				Instance->GlobalLibrary.PerReferenceData[Attachment.RenderHandle]->SetCustomDataForInstance(
+					Attachment.AttachmentHandle, Index, Values[MeshIndex]);
+			}
+		}
+
+		UTurboSequence_RenderData* RenderData = RenderDataCache.Find(Instance->GlobalLibrary.PerReferenceData, Runtime->RenderHandle);
+		NumSet += RenderData->SetCustomDataForInstance(MeshIDs[MeshIndex], Index, Values[MeshIndex]);
+	}
+	return NumSet;
+}
+
 bool ATurboSequence_Manager_Lf::SetTransitionTsMeshToUEMesh(const FBaseSkeletalMeshHandle TsMeshID, USkinnedMeshComponent* UEMesh,
                                                             const float UEMeshPercentage,
                                                             const float AnimationDeltaTime)
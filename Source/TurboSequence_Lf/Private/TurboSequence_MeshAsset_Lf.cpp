@@ -46,6 +46,35 @@ bool UTurboSequence_MeshAsset_Lf::IsMeshAssetValid() const
 	return true;
 }
 
+int32 UTurboSequence_MeshAsset_Lf::FindBakedAnimation(const UAnimSequence* Animation,
+	const int32 NumFrames, const int32 NumBones) const
+{
+	const int32 BakedAnimationIndex = BakedAnimationLibrary.IndexOfByPredicate(
+		[Animation](const FTurboSequence_BakedAnimation_Lf& BakedAnimation)
+		{
+			return BakedAnimation.Animation == Animation;
+		});
+	return GetBakedAnimation(BakedAnimationIndex, Animation, NumFrames, NumBones) ? BakedAnimationIndex : INDEX_NONE;
+}
+
+const FTurboSequence_BakedAnimation_Lf* UTurboSequence_MeshAsset_Lf::GetBakedAnimation(const int32 BakedAnimationIndex,
+	const UAnimSequence* Animation, const int32 NumFrames, const int32 NumBones) const
+{
+	if (!Animation || !BakedAnimationLibrary.IsValidIndex(BakedAnimationIndex))
+	{
+		return nullptr;
+	}
+
+	// Another animation after a re-bake, or the keyframe interval or the skeleton changed since the bake
+	const FTurboSequence_BakedAnimation_Lf& BakedAnimation = BakedAnimationLibrary[BakedAnimationIndex];
+	if (BakedAnimation.Animation != Animation || BakedAnimation.NumFrames != NumFrames || BakedAnimation.NumBones != NumBones ||
+		BakedAnimation.Keyframes.Num() != NumFrames * NumBones * 3)
+	{
+		return nullptr;
+	}
+	return &BakedAnimation;
+}
+
 TArray<FString> UTurboSequence_MeshAsset_Lf::GetSocketNames() const
 {
 	TArray<FString> SocketNames;
@@ -106,3 +135,13 @@ void UTurboSequence_MeshAsset_Lf::PostLoad()
 	
 	Super::PostLoad();
 }
+
+#if WITH_EDITOR
+void UTurboSequence_MeshAsset_Lf::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Static mesh or culling toggle might have changed, instances pick it up on their next transform update
+	CachedCullingSphereRadius = -1;
+}
+#endif
@@ -4,7 +4,8 @@
 #include "TurboSequence_RenderData.h"
 
 #include "NiagaraComponent.h"
-#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "NiagaraDataInterfaceArrayFloat.h"
+#include "NiagaraDataInterfaceArrayInt.h"
 #include "NiagaraFunctionLibrary.h"
 #include "TurboSequence_Data_Lf.h"
 #include "TurboSequence_GlobalData_Lf.h"
@@ -41,6 +42,21 @@ FString& UTurboSequence_RenderData::GetMaterialsName() const
 	return DataAsset->GlobalData->NameNiagaraMaterialObject;
 }
 
+FName& UTurboSequence_RenderData::GetCompactTransformsName() const
+{
+	return DataAsset->GlobalData->NameNiagaraCompactTransforms;
+}
+
+FName& UTurboSequence_RenderData::GetCompactTileOriginName() const
+{
+	return DataAsset->GlobalData->NameNiagaraCompactTileOrigin;
+}
+
+FName& UTurboSequence_RenderData::GetCompactPositionStepName() const
+{
+	return DataAsset->GlobalData->NameNiagaraCompactPositionStep;
+}
+
 FName& UTurboSequence_RenderData::GetFlagsName() const
 {
 	return DataAsset->GlobalData->NameNiagaraFlags;
@@ -57,7 +73,7 @@ void UTurboSequence_RenderData::PrintRenderData() const
 	FBox RenderBounds = GetRenderBounds();
 
 	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow, FString::Printf(TEXT("Active Count %d"),GetActiveNum()));
-	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow, FString::Printf(TEXT("Count %d, Position %d, Rotation %d, Scale %d, Flags %d, Custom %d"),bChangedCollectionSizeThisFrame, bChangedPositionCollectionThisFrame, bChangedRotationCollectionThisFrame, bChangedScaleCollectionThisFrame, bChangedFlagsCollectionThisFrame,bChangedCustomDataCollectionThisFrame));
+	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow, FString::Printf(TEXT("Count %d, Position %d, Rotation %d, Scale %d, Flags %d, Custom %d, Uploaded Bytes %d"),bChangedCollectionSizeThisFrame, DirtyPositions.Num(), DirtyRotations.Num(), DirtyScales.Num(), DirtyFlags.Num(), DirtyCustomData.Num(), WrittenBytesThisFrame));
 	GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::Yellow, FString::Printf(TEXT("Bounds Min %s Max %s"),*RenderBounds.Min.ToString(), *RenderBounds.Max.ToString()));
 }
 
@@ -78,50 +94,50 @@ void UTurboSequence_RenderData::UpdateNiagaraBounds() const
 	SetEmitterBounds(GetRenderBounds());
 }
 
+UNiagaraDataInterface* UTurboSequence_RenderData::FindNiagaraArrayInterface(UClass* ArrayInterfaceClass, const FName& ArrayName) const
+{
+	return UNiagaraFunctionLibrary::GetDataInterface(ArrayInterfaceClass, NiagaraComponent, ArrayName);
+}
+
 void UTurboSequence_RenderData::UpdateNiagaraEmitter() 
 {
-	if (bChangedFlagsCollectionThisFrame || bChangedCollectionSizeThisFrame)
-	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayUInt8(
-			NiagaraComponent, GetFlagsName(), ParticleFlags);
-	}
+	WrittenBytesThisFrame = 0;
 
-	if (bChangedCustomDataCollectionThisFrame || bChangedCollectionSizeThisFrame)
-	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(
-			NiagaraComponent, GetCustomDataName(), ParticleCustomData);
-	}
+	WrittenBytesThisFrame += UploadNiagaraArray<UNiagaraDataInterfaceArrayUInt8>(DirtyFlags, ParticleFlags, GetFlagsName(),
+		bChangedCollectionSizeThisFrame, sizeof(uint8));
 
-	if (bChangedPositionCollectionThisFrame || bChangedCollectionSizeThisFrame)
-	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayPosition(
-			NiagaraComponent, GetPositionName(), ParticlePositions);
-	}
+	WrittenBytesThisFrame += UploadNiagaraArray<UNiagaraDataInterfaceArrayFloat>(DirtyCustomData, ParticleCustomData,
+		GetCustomDataName(), bChangedCollectionSizeThisFrame, sizeof(float));
 
-	if (bChangedRotationCollectionThisFrame || bChangedCollectionSizeThisFrame)
+	if (bUseCompactTransforms)
 	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4(
-			NiagaraComponent, GetRotationName(), ParticleRotations);
-	}
+		if (bChangedCompactTileThisFrame || bChangedCollectionSizeThisFrame)
+		{
+			NiagaraComponent->SetVariablePosition(GetCompactTileOriginName(), CompactTileOrigin);
+			NiagaraComponent->SetVariableFloat(GetCompactPositionStepName(), static_cast<float>(CompactPositionStep));
+		}
 
-	if (bChangedScaleCollectionThisFrame || bChangedCollectionSizeThisFrame)
-	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(
-			NiagaraComponent, GetScaleName(), ParticleScales);
-	}
+		WrittenBytesThisFrame += UploadNiagaraArray<UNiagaraDataInterfaceArrayInt32>(DirtyCompactTransforms, CompactTransforms,
+			GetCompactTransformsName(), bChangedCollectionSizeThisFrame || bChangedCompactTileThisFrame, sizeof(int32));
 
-	if (bChangedSkeletonIndexesThisFrame || bChangedCollectionSizeThisFrame)
+		bChangedCompactTileThisFrame = false;
+	}
+	else
 	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayInt32(
-			NiagaraComponent, TEXT("User.Particle_SkeletonIndex"), SkeletonIndexes);
+		// Niagara keeps positions as floats relative to the LWC tile
+		WrittenBytesThisFrame += UploadNiagaraArray<UNiagaraDataInterfaceArrayPosition>(DirtyPositions, ParticlePositions,
+			GetPositionName(), bChangedCollectionSizeThisFrame, sizeof(FVector3f));
+
+		WrittenBytesThisFrame += UploadNiagaraArray<UNiagaraDataInterfaceArrayFloat4>(DirtyRotations, ParticleRotations,
+			GetRotationName(), bChangedCollectionSizeThisFrame, sizeof(FVector4f));
+
+		WrittenBytesThisFrame += UploadNiagaraArray<UNiagaraDataInterfaceArrayFloat3>(DirtyScales, ParticleScales,
+			GetScaleName(), bChangedCollectionSizeThisFrame, sizeof(FVector3f));
 	}
-		
-	bChangedFlagsCollectionThisFrame = false;
-	bChangedCustomDataCollectionThisFrame = false;
-	bChangedPositionCollectionThisFrame = false;
-	bChangedRotationCollectionThisFrame = false;
-	bChangedScaleCollectionThisFrame = false;
-	bChangedSkeletonIndexesThisFrame = false;
+
+	static const FName SkeletonIndexName = TEXT("User.Particle_SkeletonIndex");
+	WrittenBytesThisFrame += UploadNiagaraArray<UNiagaraDataInterfaceArrayInt32>(DirtySkeletonIndexes, SkeletonIndexes,
+		SkeletonIndexName, bChangedCollectionSizeThisFrame, sizeof(int32));
 
 	bChangedCollectionSizeThisFrame = false;
 	
@@ -191,10 +207,16 @@ void UTurboSequence_RenderData::DestroyNiagaraComponent()
 
 void UTurboSequence_RenderData::UpdateInstanceTransformInternal(const int32 InstanceIndex, const FTransform& WorldSpaceTransform, bool bForceUpdate)
 {
+	if (bUseCompactTransforms)
+	{
+		UpdateCompactTransformInternal(InstanceIndex, WorldSpaceTransform, bForceUpdate);
+		return;
+	}
+
 	const FVector& Position = WorldSpaceTransform.GetLocation();
 	if (bForceUpdate || !Position.Equals(ParticlePositions[InstanceIndex]))
 	{
-		bChangedPositionCollectionThisFrame = true;
+		DirtyPositions.MarkDirty(InstanceIndex);
 		ParticlePositions[InstanceIndex] = Position;
 	}
 
@@ -202,18 +224,107 @@ void UTurboSequence_RenderData::UpdateInstanceTransformInternal(const int32 Inst
 		WorldSpaceTransform.GetRotation());
 	if (bForceUpdate || !Rotation.Equals(ParticleRotations[InstanceIndex]))
 	{
-		bChangedRotationCollectionThisFrame = true;
+		DirtyRotations.MarkDirty(InstanceIndex);
 		ParticleRotations[InstanceIndex] = Rotation;
 	}
 	
 	const FVector3f& Scale = FTurboSequence_Helper_Lf::ConvertVectorToVector3F(WorldSpaceTransform.GetScale3D());
 	if (bForceUpdate || !Scale.Equals(ParticleScales[InstanceIndex]))
 	{
-		bChangedScaleCollectionThisFrame = true;
+		DirtyScales.MarkDirty(InstanceIndex);
 		ParticleScales[InstanceIndex] = Scale;
 	}
 }
 
+void UTurboSequence_RenderData::UpdateCompactTransformInternal(const int32 InstanceIndex,
+                                                               const FTransform& WorldSpaceTransform, const bool bForceUpdate)
+{
+	int32 EncodedTransform[FTurboSequence_Helper_Lf::NumCompactTransformValues];
+	if (!FTurboSequence_Helper_Lf::EncodeCompactTransform(EncodedTransform, WorldSpaceTransform, CompactTileOrigin,
+	                                                      CompactPositionStep))
+	{
+		// Out of range once the instances spread wider than the tile, the instance gets clamped then
+		RecenterCompactTile(WorldSpaceTransform.GetLocation());
+		EncodeCompactTransformClamped(EncodedTransform, WorldSpaceTransform);
+	}
+
+	// Movement below the precision doesn't upload anything
+	const int32 BaseIndex = InstanceIndex * FTurboSequence_Helper_Lf::NumCompactTransformValues;
+	for (int32 i = 0; i < FTurboSequence_Helper_Lf::NumCompactTransformValues; ++i)
+	{
+		if (bForceUpdate || CompactTransforms[BaseIndex + i] != EncodedTransform[i])
+		{
+			CompactTransforms[BaseIndex + i] = EncodedTransform[i];
+			DirtyCompactTransforms.MarkDirty(BaseIndex + i);
+		}
+	}
+}
+
+void UTurboSequence_RenderData::EncodeCompactTransformClamped(int32* OutValues, const FTransform& WorldSpaceTransform)
+{
+	if (FTurboSequence_Helper_Lf::EncodeCompactTransform(OutValues, WorldSpaceTransform, CompactTileOrigin,
+	                                                     CompactPositionStep))
+	{
+		return;
+	}
+
+	// The instances are spread wider than the tile, keeps the instance on the border of the tile
+	if (!bWarnedCompactTileRange)
+	{
+		bWarnedCompactTileRange = true;
+		UE_LOG(LogTurboSequence_Lf, Warning,
+		       TEXT("Instances of %s are spread wider than the compact transform tile, raise the Compact Position Precision..."),
+		       *DataAsset->GetName());
+	}
+	const double TileExtent = (FTurboSequence_Helper_Lf::CompactPositionBias - 1) * CompactPositionStep;
+	FTransform ClampedTransform = WorldSpaceTransform;
+	ClampedTransform.SetLocation(CompactTileOrigin + (WorldSpaceTransform.GetLocation() - CompactTileOrigin).BoundToCube(TileExtent));
+	FTurboSequence_Helper_Lf::EncodeCompactTransform(OutValues, ClampedTransform, CompactTileOrigin, CompactPositionStep);
+}
+
+bool UTurboSequence_RenderData::RecenterCompactTile(const FVector& Location)
+{
+	if (LastFailedCompactTileRecenterFrame == GFrameCounter)
+	{
+		return false;
+	}
+
+	TArray<FTransform> DecodedTransforms;
+	DecodedTransforms.SetNum(InstanceHandles.Num());
+
+	FBox TileBounds(Location, Location);
+	for (int32 InstanceIndex = 0; InstanceIndex < InstanceHandles.Num(); ++InstanceIndex)
+	{
+		DecodedTransforms[InstanceIndex] = FTurboSequence_Helper_Lf::DecodeCompactTransform(
+			&CompactTransforms[InstanceIndex * FTurboSequence_Helper_Lf::NumCompactTransformValues], CompactTileOrigin,
+			CompactPositionStep);
+		if (InstanceHandles[InstanceIndex].IsValid())
+		{
+			TileBounds += DecodedTransforms[InstanceIndex].GetLocation();
+		}
+	}
+
+	// Moving the tile would only push other instances out of range
+	const double TileExtent = (FTurboSequence_Helper_Lf::CompactPositionBias - 1) * CompactPositionStep;
+	if (TileBounds.GetExtent().GetMax() > TileExtent)
+	{
+		LastFailedCompactTileRecenterFrame = GFrameCounter;
+		return false;
+	}
+
+	// Snapped to whole steps, so the positions stay exact when they get encoded again
+	CompactTileOrigin = TileBounds.GetCenter().GridSnap(CompactPositionStep);
+	for (int32 InstanceIndex = 0; InstanceIndex < InstanceHandles.Num(); ++InstanceIndex)
+	{
+		EncodeCompactTransformClamped(
+			&CompactTransforms[InstanceIndex * FTurboSequence_Helper_Lf::NumCompactTransformValues],
+			DecodedTransforms[InstanceIndex]);
+	}
+
+	bChangedCompactTileThisFrame = true;
+	return true;
+}
+
 void UTurboSequence_RenderData::UpdateInstanceTransform(
 	FAttachmentMeshHandle AttachmentMeshHandle,
 	const FTransform& WorldSpaceTransform)
@@ -236,20 +347,30 @@ int32 UTurboSequence_RenderData::AllocateRenderInstanceInternal(const FAttachmen
 		
 	if(bReuse)
 	{
+		InstanceHandles[InstanceIndex] = MeshHandle;
 		ParticleFlags[InstanceIndex] = AliveFlags.Val;
 
-		bChangedFlagsCollectionThisFrame = true;
+		DirtyFlags.MarkDirty(InstanceIndex);
 		
 		for(int i = 0; i < FTurboSequence_Helper_Lf::NumInstanceCustomData; ++i)
 		{
 			ParticleCustomData[ InstanceIndex * FTurboSequence_Helper_Lf::NumInstanceCustomData + i] = float();
+			DirtyCustomData.MarkDirty(InstanceIndex * FTurboSequence_Helper_Lf::NumInstanceCustomData + i);
 		}
 	}
 	else
 	{
-		ParticlePositions.AddDefaulted(1);
-		ParticleRotations.AddDefaulted(1);
-		ParticleScales.AddDefaulted(1);
+		InstanceHandles.Add(MeshHandle);
+		if (bUseCompactTransforms)
+		{
+			CompactTransforms.AddZeroed(FTurboSequence_Helper_Lf::NumCompactTransformValues);
+		}
+		else
+		{
+			ParticlePositions.AddDefaulted(1);
+			ParticleRotations.AddDefaulted(1);
+			ParticleScales.AddDefaulted(1);
+		}
 		ParticleFlags.Add(AliveFlags.Val);
 		SkeletonIndexes.AddDefaulted(1);
 		ParticleCustomData.AddDefaulted(FTurboSequence_Helper_Lf::NumInstanceCustomData);
@@ -265,7 +386,7 @@ void UTurboSequence_RenderData::SetSkeletonIndexInternal(const int32 InstanceInd
 	if(SkeletonIndexes[InstanceIndex] != SkeletonIndex)
 	{
 		SkeletonIndexes[InstanceIndex] = SkeletonIndex;
-		bChangedSkeletonIndexesThisFrame = true;
+		DirtySkeletonIndexes.MarkDirty(InstanceIndex);
 	}
 }
 
@@ -280,6 +401,37 @@ void UTurboSequence_RenderData::AddRenderInstance(const FAttachmentMeshHandle Me
 	SetSkeletonIndexInternal(InstanceIndex, SkeletonIndex);
 }
 
+void UTurboSequence_RenderData::ReserveRenderInstances(const int32 NumAddedInstances)
+{
+	InstanceMap.Reserve(InstanceMap.Num() + NumAddedInstances);
+
+	const int32 NumInstances = InstanceHandles.Num() + FMath::Max(NumAddedInstances - FreeList.Num(), 0);
+	InstanceHandles.Reserve(NumInstances);
+	if (bUseCompactTransforms)
+	{
+		CompactTransforms.Reserve(NumInstances * FTurboSequence_Helper_Lf::NumCompactTransformValues);
+	}
+	else
+	{
+		ParticlePositions.Reserve(NumInstances);
+		ParticleRotations.Reserve(NumInstances);
+		ParticleScales.Reserve(NumInstances);
+	}
+	ParticleFlags.Reserve(NumInstances);
+	SkeletonIndexes.Reserve(NumInstances);
+	ParticleCustomData.Reserve(NumInstances * FTurboSequence_Helper_Lf::NumInstanceCustomData);
+}
+
+bool UTurboSequence_RenderData::SetSkeletonIndex(const FAttachmentMeshHandle MeshHandle, const int32 SkeletonIndex)
+{
+	if(const int32* InstanceIndex = InstanceMap.Find(MeshHandle))
+	{
+		SetSkeletonIndexInternal(*InstanceIndex, SkeletonIndex);
+		return true;
+	}
+	return false;
+}
+
 
 void UTurboSequence_RenderData::RemoveRenderInstance(
 	const FAttachmentMeshHandle Handle)
@@ -290,11 +442,120 @@ void UTurboSequence_RenderData::RemoveRenderInstance(
 	if(InstanceMap.RemoveAndCopyValue(Handle,InstanceIndex))
 	{
 		FreeList.Add(InstanceIndex);
+		InstanceHandles[InstanceIndex] = FAttachmentMeshHandle();
 		ParticleFlags[InstanceIndex] = DeadFlags.Val;
-		bChangedFlagsCollectionThisFrame = true;	
+		DirtyFlags.MarkDirty(InstanceIndex);
 	}
 }
 
+int32 UTurboSequence_RenderData::CompactRenderInstances(const int32 MaxMoves)
+{
+	// A few dead instances aren't worth the moves and the full upload after shrinking
+	if (MaxMoves <= 0 || FreeList.Num() * 8 < InstanceHandles.Num())
+	{
+		return 0;
+	}
+
+	const int32 NumLiveInstances = InstanceMap.Num();
+	int32 NumMoves = 0;
+	int32 TailIndex = InstanceHandles.Num() - 1;
+	bool bHasHoles = false;
+	for (int32 FreeListIndex = FreeList.Num() - 1; FreeListIndex >= 0; --FreeListIndex)
+	{
+		const int32 HoleIndex = FreeList[FreeListIndex];
+		if (HoleIndex >= NumLiveInstances)
+		{
+			continue;
+		}
+		if (NumMoves >= MaxMoves)
+		{
+			bHasHoles = true;
+			break;
+		}
+
+		// Every hole below the live count has a live instance above it
+		while (!InstanceHandles[TailIndex].IsValid())
+		{
+			TailIndex--;
+		}
+
+		MoveRenderInstanceInternal(TailIndex, HoleIndex);
+		FreeList[FreeListIndex] = TailIndex;
+		TailIndex--;
+		NumMoves++;
+	}
+
+	if (!bHasHoles)
+	{
+		ShrinkRenderInstancesInternal(NumLiveInstances);
+		FreeList.Reset();
+		bChangedCollectionSizeThisFrame = true;
+	}
+
+	return NumMoves;
+}
+
+void UTurboSequence_RenderData::MoveRenderInstanceInternal(const int32 FromIndex, const int32 ToIndex)
+{
+	const FAttachmentMeshHandle MeshHandle = InstanceHandles[FromIndex];
+	InstanceMap[MeshHandle] = ToIndex;
+	InstanceHandles[ToIndex] = MeshHandle;
+	InstanceHandles[FromIndex] = FAttachmentMeshHandle();
+
+	if (bUseCompactTransforms)
+	{
+		for (int32 i = 0; i < FTurboSequence_Helper_Lf::NumCompactTransformValues; ++i)
+		{
+			const int32 ToCompactIndex = ToIndex * FTurboSequence_Helper_Lf::NumCompactTransformValues + i;
+			CompactTransforms[ToCompactIndex] = CompactTransforms[FromIndex * FTurboSequence_Helper_Lf::NumCompactTransformValues + i];
+			DirtyCompactTransforms.MarkDirty(ToCompactIndex);
+		}
+	}
+	else
+	{
+		ParticlePositions[ToIndex] = ParticlePositions[FromIndex];
+		DirtyPositions.MarkDirty(ToIndex);
+		ParticleRotations[ToIndex] = ParticleRotations[FromIndex];
+		DirtyRotations.MarkDirty(ToIndex);
+		ParticleScales[ToIndex] = ParticleScales[FromIndex];
+		DirtyScales.MarkDirty(ToIndex);
+	}
+	SkeletonIndexes[ToIndex] = SkeletonIndexes[FromIndex];
+	DirtySkeletonIndexes.MarkDirty(ToIndex);
+
+	// The old slot stays dead until the arrays shrink
+	const FParticleFlags DeadFlags(false, 0);
+	ParticleFlags[ToIndex] = ParticleFlags[FromIndex];
+	DirtyFlags.MarkDirty(ToIndex);
+	ParticleFlags[FromIndex] = DeadFlags.Val;
+	DirtyFlags.MarkDirty(FromIndex);
+
+	for (int32 i = 0; i < FTurboSequence_Helper_Lf::NumInstanceCustomData; ++i)
+	{
+		const int32 ToCustomDataIndex = ToIndex * FTurboSequence_Helper_Lf::NumInstanceCustomData + i;
+		ParticleCustomData[ToCustomDataIndex] = ParticleCustomData[FromIndex * FTurboSequence_Helper_Lf::NumInstanceCustomData + i];
+		DirtyCustomData.MarkDirty(ToCustomDataIndex);
+	}
+}
+
+void UTurboSequence_RenderData::ShrinkRenderInstancesInternal(const int32 NumInstances)
+{
+	InstanceHandles.SetNum(NumInstances);
+	if (bUseCompactTransforms)
+	{
+		CompactTransforms.SetNum(NumInstances * FTurboSequence_Helper_Lf::NumCompactTransformValues);
+	}
+	else
+	{
+		ParticlePositions.SetNum(NumInstances);
+		ParticleRotations.SetNum(NumInstances);
+		ParticleScales.SetNum(NumInstances);
+	}
+	SkeletonIndexes.SetNum(NumInstances);
+	ParticleFlags.SetNum(NumInstances);
+	ParticleCustomData.SetNum(NumInstances * FTurboSequence_Helper_Lf::NumInstanceCustomData);
+}
+
 void UTurboSequence_RenderData::SetGPUBoneIndexForInstanceInternal(const uint8 BoneIndex, const int Index)
 {
 	FParticleFlags Flags;
@@ -304,7 +565,7 @@ void UTurboSequence_RenderData::SetGPUBoneIndexForInstanceInternal(const uint8 B
 	if(Flags.BoneIndex != BoneIndex)
 	{
 		Flags.BoneIndex = BoneIndex;
-		bChangedFlagsCollectionThisFrame = true;
+		DirtyFlags.MarkDirty(Index);
 
 		ParticleFlags[Index] = Flags.Val;
 	}
@@ -317,6 +578,9 @@ void UTurboSequence_RenderData::Init(UTurboSequence_MeshAsset_Lf* InMeshAsset, U
 
 	TurboSequenceRenderData->MeshMinBounds = MeshMinBounds;
 	TurboSequenceRenderData->MeshMaxBounds = MaxMaxBounds;
+
+	TurboSequenceRenderData->bUseCompactTransforms = InMeshAsset->bUseCompactInstanceTransforms;
+	TurboSequenceRenderData->CompactPositionStep = InMeshAsset->CompactPositionPrecision;
 }
 
 UTurboSequence_RenderData* UTurboSequence_RenderData::CreateObject(UObject* Outer,
@@ -356,12 +620,11 @@ bool UTurboSequence_RenderData::GetInstanceCustomDataBaseIndex(const FAttachment
 
 void UTurboSequence_RenderData::SetCustomDataIndex(const float CustomDataValue, const uint32 CustomDataIndex)
 {
-	if (!bChangedCustomDataCollectionThisFrame && ParticleCustomData[CustomDataIndex] != CustomDataValue)
+	if (ParticleCustomData[CustomDataIndex] != CustomDataValue)
 	{
-		bChangedCustomDataCollectionThisFrame = true;
+		DirtyCustomData.MarkDirty(CustomDataIndex);
+		ParticleCustomData[CustomDataIndex] = CustomDataValue;
 	}
-	
-	ParticleCustomData[CustomDataIndex] = CustomDataValue;
 }
 
 bool UTurboSequence_RenderData::SetCustomDataForInstance(
@@ -406,9 +669,16 @@ void UTurboSequence_RenderData::UpdateRendererBounds(
 {
 	// We assume it's called already inside bIsVisible
 	const FVector& MeshLocation = WorldSpaceTransform.GetLocation();
-	const float Scale = WorldSpaceTransform.GetScale3D().GetMax();
+	const float Scale = WorldSpaceTransform.GetScale3D().GetAbsMax();
 
 	MinBounds = MinBounds.ComponentMin(MeshLocation);
 	MaxBounds = MaxBounds.ComponentMax(MeshLocation);
 	MaxScale = FMath::Max(MaxScale, Scale);
 }
+
+void UTurboSequence_RenderData::MergeRendererBounds(const FRendererBoundsPartial_Lf& PartialBounds)
+{
+	MinBounds = MinBounds.ComponentMin(PartialBounds.MinBounds);
+	MaxBounds = MaxBounds.ComponentMax(PartialBounds.MaxBounds);
+	MaxScale = FMath::Max(MaxScale, PartialBounds.MaxScale);
+}
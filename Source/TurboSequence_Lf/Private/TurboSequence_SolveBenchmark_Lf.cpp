@@ -0,0 +1,246 @@
+// Copyright Lukas Fratzl, 2022-2024. All Rights Reserved.
+
+#include "TurboSequence_Manager_Lf.h"
+#include "TurboSequence_GlobalData_Lf.h"
+#include "TurboSequence_RenderData.h"
+#include "TurboSequence_Utility_Lf.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Drives the manager pipeline stage by stage for a fixed amount of ticks, works with -nullrhi since no GPU work is timed
+// It measures and does not verify anything, so it stays a console command and not an automation test with pass/fail checks
+struct FTurboSequence_SolveBenchmark_Lf
+{
+	struct FTickTimings
+	{
+		double CullingSeconds = 0;
+		double SolveSeconds = 0;
+		double RenderThreadSeconds = 0;
+		double NiagaraUploadSeconds = 0;
+		int32 NiagaraWrittenBytes = 0;
+		int32 NumVisibleMeshes = 0;
+	};
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogTurboSequence_Lf, Warning,
+			       TEXT("Usage: TurboSequence.BenchmarkSolve <MeshAssetPath> [Meshes] [Animations] [Attachments] [Ticks] [OutputFile]"));
+			return;
+		}
+
+		UTurboSequence_MeshAsset_Lf* MeshAsset = LoadObject<UTurboSequence_MeshAsset_Lf>(nullptr, *Args[0]);
+		if (!IsValid(MeshAsset) || !IsValid(MeshAsset->ReferenceMeshNative) || !IsValid(World))
+		{
+			UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't run the solve benchmark, %s is not a valid mesh asset..."), *Args[0]);
+			return;
+		}
+
+		const int32 NumMeshes = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 1000;
+		const int32 NumAnimations = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 0) : 1;
+		const int32 NumAttachments = Args.Num() > 3 ? FMath::Max(FCString::Atoi(*Args[3]), 0) : 0;
+		const int32 NumTicks = Args.Num() > 4 ? FMath::Max(FCString::Atoi(*Args[4]), 1) : 300;
+		const FString OutputFile = Args.Num() > 5
+			                           ? Args[5]
+			                           : FPaths::ProfilingDir() / TEXT("TurboSequence") / FString::Printf(
+				                           TEXT("SolveBenchmark_%d_%d_%d-%s.csv"), NumMeshes, NumAnimations,
+				                           NumAttachments, *FDateTime::Now().ToString());
+
+		TArray<UAnimSequence*> Animations;
+		for (const TObjectPtr<UAnimSequence>& Animation : MeshAsset->AnimationsToBake)
+		{
+			if (IsValid(Animation))
+			{
+				Animations.Add(Animation);
+			}
+		}
+		if (NumAnimations && !Animations.Num())
+		{
+			UE_LOG(LogTurboSequence_Lf, Warning,
+			       TEXT("Can't run the solve benchmark, %s has no animations to bake to play..."), *Args[0]);
+			return;
+		}
+
+		const uint64 StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+		// Square grid around the world origin, close enough that most of the crowd is in view
+		const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumMeshes)));
+		TArray<FTransform> SpawnTransforms;
+		SpawnTransforms.Reserve(NumMeshes);
+		for (int32 MeshIndex = 0; MeshIndex < NumMeshes; ++MeshIndex)
+		{
+			SpawnTransforms.Add(FTransform(FVector((MeshIndex % GridSize - GridSize / 2) * 200.0,
+			                                       (MeshIndex / GridSize - GridSize / 2) * 200.0, 0)));
+		}
+
+		const double SpawnStartTime = FPlatformTime::Seconds();
+		TArray<FBaseSkeletalMeshHandle> MeshIDs;
+		ATurboSequence_Manager_Lf::AddSkinnedMeshInstances(MeshIDs, MeshAsset, SpawnTransforms, World,
+		                                                   TArray<UMaterialInterface*>(), FLightingChannels());
+		const double SpawnSeconds = FPlatformTime::Seconds() - SpawnStartTime;
+
+		if (!MeshIDs.Num() || !IsValid(ATurboSequence_Manager_Lf::Instance))
+		{
+			UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't run the solve benchmark, no mesh could be added..."));
+			return;
+		}
+
+		// Layered with an even weight, so every mesh blends all of its animations every tick
+		FTurboSequence_AnimPlaySettings_Lf AnimSettings;
+		AnimSettings.AnimationWeight = 1.0f / FMath::Max(NumAnimations, 1);
+		TArray<FTurboSequence_AnimMinimalData_Lf> PlayedAnimations;
+		for (int32 AnimationIndex = 0; AnimationIndex < NumAnimations; ++AnimationIndex)
+		{
+			ATurboSequence_Manager_Lf::PlayAnimationBatch(PlayedAnimations, MeshIDs,
+			                                              Animations[AnimationIndex % Animations.Num()], AnimSettings,
+			                                              true, false);
+		}
+
+		UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		const FReferenceSkeleton& ReferenceSkeleton = MeshAsset->ReferenceMeshNative->GetRefSkeleton();
+		TArray<FAttachmentMeshHandle> AttachmentHandles;
+		if (IsValid(CubeMesh) && ReferenceSkeleton.GetNum())
+		{
+			AttachmentHandles.Reserve(MeshIDs.Num() * NumAttachments);
+			for (const FBaseSkeletalMeshHandle& MeshID : MeshIDs)
+			{
+				for (int32 AttachmentIndex = 0; AttachmentIndex < NumAttachments; ++AttachmentIndex)
+				{
+					const FName BoneName = ReferenceSkeleton.GetBoneName(AttachmentIndex % ReferenceSkeleton.GetNum());
+					AttachmentHandles.Add(ATurboSequence_Manager_Lf::AddInstanceAttachment(
+						MeshID, CubeMesh, BoneName, FTransform(FVector(0, 0, 10)), TArray<UMaterialInterface*>()));
+				}
+			}
+		}
+
+		const uint64 SpawnedUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+		FSkinnedMeshGlobalLibrary_Lf& Library = ATurboSequence_Manager_Lf::Instance->GlobalLibrary;
+		constexpr float DeltaTime = 1.0f / 60.0f;
+
+		FString Csv = TEXT("Tick,CullingMs,SolveMs,RenderThreadMs,NiagaraUploadMs,NiagaraWrittenBytes,VisibleMeshes,")
+			TEXT("BoneTextureUsed,BoneTextureTotal,BoneTextureFragmentation,AnimationLibraryFree,AnimationLibraryTotal,")
+			TEXT("ResidentKeyframes,UsedPhysicalMB\n");
+
+		FTickTimings TotalTimings;
+		int32 NumSolvedTicks = 0;
+		// The solve keys animation LOD, keyframe residency and compaction on the frame count, advanced here without
+		// touching the engine frame counter
+		int64 FrameCount = GFrameCounter;
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			FTickTimings Timings;
+			RunTick(Timings, DeltaTime, World, ++FrameCount);
+			if (!Library.CameraViews.Num())
+			{
+				UE_LOG(LogTurboSequence_Lf, Warning, TEXT("Can't run the solve benchmark, the world has no camera to cull against..."));
+				break;
+			}
+
+			++NumSolvedTicks;
+			TotalTimings.CullingSeconds += Timings.CullingSeconds;
+			TotalTimings.SolveSeconds += Timings.SolveSeconds;
+			TotalTimings.RenderThreadSeconds += Timings.RenderThreadSeconds;
+			TotalTimings.NiagaraUploadSeconds += Timings.NiagaraUploadSeconds;
+			TotalTimings.NiagaraWrittenBytes += Timings.NiagaraWrittenBytes;
+
+			Csv += FString::Printf(TEXT("%d,%.4f,%.4f,%.4f,%.4f,%d,%d,%d,%d,%.4f,%d,%d,%d,%.1f\n"), Tick,
+			                       Timings.CullingSeconds * 1000.0, Timings.SolveSeconds * 1000.0,
+			                       Timings.RenderThreadSeconds * 1000.0, Timings.NiagaraUploadSeconds * 1000.0,
+			                       Timings.NiagaraWrittenBytes, Timings.NumVisibleMeshes,
+			                       Library.BoneTextureAllocator.GetUsedSize(), Library.BoneTextureAllocator.GetTotalSize(),
+			                       Library.BoneTextureAllocator.GetFragmentation(),
+			                       Library.AnimationLibraryAllocator.GetFreeSize(),
+			                       Library.AnimationLibraryAllocator.GetTotalSize(),
+			                       Library.NumResidentAnimationKeyframes,
+			                       FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0));
+		}
+
+		const double InvNumTicks = 1000.0 / FMath::Max(NumSolvedTicks, 1);
+		UE_LOG(LogTurboSequence_Lf, Display,
+		       TEXT("Solve Benchmark %d Meshes x %d Animations x %d Attachments | Spawn %.2f ms | Culling %.3f ms | Solve %.3f ms | Render Thread %.3f ms | Niagara Upload %.3f ms (%d bytes written) per tick"),
+		       MeshIDs.Num(), NumAnimations, NumAttachments, SpawnSeconds * 1000.0,
+		       TotalTimings.CullingSeconds * InvNumTicks, TotalTimings.SolveSeconds * InvNumTicks,
+		       TotalTimings.RenderThreadSeconds * InvNumTicks, TotalTimings.NiagaraUploadSeconds * InvNumTicks,
+		       TotalTimings.NiagaraWrittenBytes / FMath::Max(NumSolvedTicks, 1));
+		UE_LOG(LogTurboSequence_Lf, Display,
+		       TEXT("Solve Benchmark Memory | Crowd %.1f MB | Bone Texture %d / %d (%.1f%% fragmented) | Animation Library %d / %d free"),
+		       (static_cast<int64>(SpawnedUsedPhysical) - static_cast<int64>(StartUsedPhysical)) / (1024.0 * 1024.0),
+		       Library.BoneTextureAllocator.GetUsedSize(), Library.BoneTextureAllocator.GetTotalSize(),
+		       Library.BoneTextureAllocator.GetFragmentation() * 100.0f,
+		       Library.AnimationLibraryAllocator.GetFreeSize(), Library.AnimationLibraryAllocator.GetTotalSize());
+
+		if (FFileHelper::SaveStringToFile(Csv, *OutputFile))
+		{
+			UE_LOG(LogTurboSequence_Lf, Display, TEXT("Solve Benchmark written to %s"), *OutputFile);
+		}
+
+		for (const FAttachmentMeshHandle& AttachmentHandle : AttachmentHandles)
+		{
+			ATurboSequence_Manager_Lf::RemoveInstanceAttachment(AttachmentHandle);
+		}
+		ATurboSequence_Manager_Lf::RemoveSkinnedMeshInstances(MeshIDs);
+		FlushRenderingCommands();
+	}
+
+	// Same order as the manager tick, minus the compute shader dispatches which need a real RHI
+	static void RunTick(FTickTimings& OutTimings, float DeltaTime, UWorld* World, int64 FrameCount)
+	{
+		FSkinnedMeshGlobalLibrary_Lf& Library = ATurboSequence_Manager_Lf::Instance->GlobalLibrary;
+
+		// Culling runs inside the solve, it reports its share so the solve column only holds the remaining work
+		Library.CullingTimeSeconds = 0;
+		const double SolveStartTime = FPlatformTime::Seconds();
+		ATurboSequence_Manager_Lf::SolveMeshes_GameThread(DeltaTime, World, FrameCount);
+		OutTimings.CullingSeconds = Library.CullingTimeSeconds;
+		OutTimings.SolveSeconds = FMath::Max(FPlatformTime::Seconds() - SolveStartTime - OutTimings.CullingSeconds, 0.0);
+
+		for (int32 DenseIndex = 0; DenseIndex < Library.RuntimeSkinnedMeshes.Num(); ++DenseIndex)
+		{
+			OutTimings.NumVisibleMeshes += Library.RuntimeSkinnedMeshes.IsVisible(DenseIndex);
+		}
+
+		const UTurboSequence_GlobalData_Lf* GlobalData = ATurboSequence_Manager_Lf::Instance->GlobalData;
+		const double NiagaraStartTime = FPlatformTime::Seconds();
+		for (const auto& PerReferenceData : Library.PerReferenceData)
+		{
+			if (IsValid(GlobalData))
+			{
+				PerReferenceData.Value->CompactRenderInstances(GlobalData->MaxRenderInstanceMovesPerFrame);
+			}
+			PerReferenceData.Value->UpdateNiagaraEmitter();
+			OutTimings.NiagaraWrittenBytes += PerReferenceData.Value->GetWrittenBytesThisFrame();
+		}
+		OutTimings.NiagaraUploadSeconds = FPlatformTime::Seconds() - NiagaraStartTime;
+
+		double RenderThreadSeconds = 0;
+		ATurboSequence_Manager_Lf::bFrameSnapshotAwaitsSolve = false;
+		ENQUEUE_RENDER_COMMAND(TurboSequence_BenchmarkSolve_Lf)(
+			[&RenderThreadSeconds](FRHICommandListImmediate& RHICmdList)
+			{
+				const double RenderThreadStartTime = FPlatformTime::Seconds();
+				ATurboSequence_Manager_Lf::SolveMeshes_RenderThread(RHICmdList);
+				RenderThreadSeconds = FPlatformTime::Seconds() - RenderThreadStartTime;
+
+				// The manager tick clears the keyframe upload after its dispatch, without it the input grows every tick
+				FSkinnedMeshGlobalLibrary_RenderThread_Lf& Library_RenderThread = ATurboSequence_Manager_Lf::GlobalLibrary_RenderThread;
+				Library_RenderThread.AnimationLibraryParams.SettingsInput.Reset();
+				Library_RenderThread.AnimationLibraryParams.SettingsInputIndices.Reset();
+				Library_RenderThread.AnimationLibraryParams.AdditiveWriteBaseIndex = Library_RenderThread.AnimationLibraryMaxNum;
+			});
+		FlushRenderingCommands();
+		OutTimings.RenderThreadSeconds = RenderThreadSeconds;
+	}
+};
+
+static FAutoConsoleCommand SolveBenchmarkCommand_Lf(
+	TEXT("TurboSequence.BenchmarkSolve"),
+	TEXT("Spawns a crowd of Meshes x Animations x Attachments, runs the solve pipeline for a fixed amount of ticks and writes per stage timings, allocator occupancy and memory as CSV. Arguments: MeshAssetPath [Meshes] [Animations] [Attachments] [Ticks] [OutputFile]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FTurboSequence_SolveBenchmark_Lf::Run));
+
+#endif
@@ -4,8 +4,10 @@
 
 #include "MeshDescription.h"
 #include "NiagaraComponent.h"
-#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "NiagaraDataInterfaceArrayFloat.h"
 #include "TurboSequence_ComputeShaders_Lf.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
 #include "Animation/AnimData/BoneMaskFilter.h"
 #include "Engine/SkeletalMeshSocket.h"
 
@@ -147,6 +149,19 @@ void FTurboSequence_Utility_Lf::UpdateCameras_1(TArray<FCameraView_Lf>& OutViews
 		{
 			View.InterpolatedCameraTransform_Internal = View.CameraTransform;
 		}
+
+		UpdateCullingPlanes(View);
+	}
+}
+
+void FTurboSequence_Utility_Lf::UpdateCullingPlanes(FCameraView_Lf& View)
+{
+	// The camera has no scale, so rotating the normals is enough to get the planes relative to the camera location
+	const FQuat& CameraRotation = View.InterpolatedCameraTransform_Internal.GetRotation();
+	for (uint8 p = 0; p < 6; ++p)
+	{
+		const FVector WorldNormal = CameraRotation.RotateVector(View.Planes_Internal[p].GetNormal());
+		View.CullingPlanes_Internal[p] = FVector4f(WorldNormal.X, WorldNormal.Y, WorldNormal.Z, View.Planes_Internal[p].W);
 	}
 }
 
@@ -174,34 +189,225 @@ void FTurboSequence_Utility_Lf::UpdateCameras_2(TMap<uint8, FTransform>& OutLast
 	}
 }
 
-bool FTurboSequence_Utility_Lf::IsMeshVisible(const FSkinnedMeshRuntime_Lf& Runtime,
-                                              const TArray<FCameraView_Lf>& PlayerViews)
+bool FTurboSequence_Utility_Lf::UpdateAnimationLOD(FSkinnedMeshRuntime_Lf& Runtime,
+                                                   const TArray<FCameraView_Lf>& PlayerViews,
+                                                   const float DeltaTime, const int64 CurrentFrameCount,
+                                                   double& OutCameraDistance)
 {
-	const FVector& MeshLocation = Runtime.WorldSpaceTransform.GetLocation();
-	const FBoxSphereBounds& Bounds = Runtime.DataAsset->StaticMesh->GetBounds();
-	const FBox Box(MeshLocation - Bounds.BoxExtent, MeshLocation + Bounds.BoxExtent);
+	Runtime.PendingAnimationDeltaTime += DeltaTime;
 
-	bool bIsVisibleOnAnyCamera = false;
+	const FVector& MeshLocation = Runtime.WorldSpaceTransform.GetLocation();
+	double MinDistanceSquared = TNumericLimits<double>::Max();
 	for (const FCameraView_Lf& View : PlayerViews)
 	{
-		if (FTurboSequence_Helper_Lf::Box_Intersects_With_Frustum(Box, View.Planes_Internal,
-		                                                          View.InterpolatedCameraTransform_Internal,
-		                                                          Bounds.SphereRadius))
+		MinDistanceSquared = FMath::Min(MinDistanceSquared,
+		                                FVector::DistSquared(MeshLocation, View.InterpolatedCameraTransform_Internal.GetLocation()));
+	}
+	OutCameraDistance = FMath::Sqrt(MinDistanceSquared);
+
+	const TArray<FTurboSequence_AnimationLODBand_Lf>& Bands = Runtime.DataAsset->AnimationLODBands;
+	if (!Bands.Num())
+	{
+		Runtime.AnimationLODBand = INDEX_NONE;
+		return true;
+	}
+
+	Runtime.AnimationLODBand = Bands.Num() - 1;
+	for (int32 BandIndex = 0; BandIndex < Bands.Num(); ++BandIndex)
+	{
+		if (OutCameraDistance <= Bands[BandIndex].MaxDistance)
 		{
-			bIsVisibleOnAnyCamera = true;
+			Runtime.AnimationLODBand = BandIndex;
 			break;
 		}
 	}
 
-	return bIsVisibleOnAnyCamera;
+	// The mesh id offsets the frame, so the meshes of a band don't all update on the same frame,
+	// meshes which missed their frame, like the ones deferred by the update budget, stay due
+	const int32 UpdateInterval = FMath::Max(Bands[Runtime.AnimationLODBand].UpdateInterval, 1);
+	return (CurrentFrameCount + Runtime.MeshID.MeshID) % UpdateInterval == 0 ||
+		CurrentFrameCount - Runtime.LastFrameAnimationSolved >= UpdateInterval;
 }
 
-void FTurboSequence_Utility_Lf::RefreshAsyncChunkedMeshData(
-	FSkinnedMeshGlobalLibrary_Lf& Library,
-	FSkinnedMeshGlobalLibrary_RenderThread_Lf& Library_RenderThread)
+void FTurboSequence_Utility_Lf::GetBlendedAnimations(const FSkinnedMeshRuntime_Lf& Runtime,
+                                                     TArray<int32, TInlineAllocator<8>>& OutAnimationIndices,
+                                                     float& OutWeightScale)
+{
+	OutWeightScale = 1;
+	OutAnimationIndices.Reset();
+	for (int32 AnimIdx = 0; AnimIdx < Runtime.AnimationMetaData.Num(); ++AnimIdx)
+	{
+		OutAnimationIndices.Add(AnimIdx);
+	}
+
+	const TArray<FTurboSequence_AnimationLODBand_Lf>& Bands = Runtime.DataAsset->AnimationLODBands;
+	if (!Bands.IsValidIndex(Runtime.AnimationLODBand))
+	{
+		return;
+	}
+
+	const int32 MaxAnimationLayers = Bands[Runtime.AnimationLODBand].MaxAnimationLayers;
+	if (MaxAnimationLayers <= 0 || OutAnimationIndices.Num() <= MaxAnimationLayers)
+	{
+		return;
+	}
+
+	float TotalWeight = 0;
+	for (const FAnimationMetaData_Lf& Animation : Runtime.AnimationMetaData)
+	{
+		TotalWeight += Animation.FinalAnimationWeight;
+	}
+
+	OutAnimationIndices.Sort([&Runtime](const int32 A, const int32 B)
+	{
+		return Runtime.AnimationMetaData[A].FinalAnimationWeight > Runtime.AnimationMetaData[B].FinalAnimationWeight;
+	});
+	OutAnimationIndices.SetNum(MaxAnimationLayers);
+	// The GPU blend is order dependent
+	OutAnimationIndices.Sort();
+
+	float KeptWeight = 0;
+	for (const int32 AnimIdx : OutAnimationIndices)
+	{
+		KeptWeight += Runtime.AnimationMetaData[AnimIdx].FinalAnimationWeight;
+	}
+
+	if (KeptWeight > UE_SMALL_NUMBER)
+	{
+		OutWeightScale = TotalWeight / KeptWeight;
+	}
+}
+
+// Scalar sphere versus frustum test, matches a single lane of the batched culling
+static bool IsSphereVisible_Lf(const FVector& Center, const float Radius, const TArray<FCameraView_Lf>& PlayerViews)
+{
+	for (const FCameraView_Lf& View : PlayerViews)
+	{
+		const FVector3f Relative = FVector3f(Center - View.InterpolatedCameraTransform_Internal.GetLocation());
+		if (Relative.SizeSquared() <= Radius * Radius)
+		{
+			return true;
+		}
+
+		bool bInside = true;
+		for (uint8 p = 0; p < 6 && bInside; ++p)
+		{
+			const FVector4f& Plane = View.CullingPlanes_Internal[p];
+			bInside = Plane.X * Relative.X + Plane.Y * Relative.Y + Plane.Z * Relative.Z - Plane.W >= -Radius;
+		}
+
+		if (bInside)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FTurboSequence_Utility_Lf::CullSpatialCells(FSkinnedMeshRuntimeStore_Lf& Store,
+                                                 const TArray<FCameraView_Lf>& PlayerViews)
 {
-	CreateBoneMaps(Library, Library_RenderThread);
-	CreateInverseReferencePose(Library, Library_RenderThread);
+	const double CellSize = Store.GetSpatialGridCellSize();
+	const float CellRadius = CellSize * UE_HALF_SQRT_3;
+	for (int32 CellIndex = 0; CellIndex < Store.GetNumSpatialCells(); ++CellIndex)
+	{
+		const FSpatialGridCell_Lf& Cell = Store.GetSpatialCell(CellIndex);
+		if (!Cell.Meshes.Num())
+		{
+			continue;
+		}
+
+		const FVector CellCenter = (FVector(Cell.Coordinates) + 0.5) * CellSize;
+		Store.SetSpatialCellVisible(CellIndex, IsSphereVisible_Lf(CellCenter, CellRadius + Cell.MaxRadius, PlayerViews));
+	}
+}
+
+void FTurboSequence_Utility_Lf::CullMeshes(FSkinnedMeshRuntimeStore_Lf& Store,
+                                           const TArray<FCameraView_Lf>& PlayerViews,
+                                           const int32 StartIndex, const int32 EndIndex)
+{
+	const double* CentersX = Store.GetCullingCentersX();
+	const double* CentersY = Store.GetCullingCentersY();
+	const double* CentersZ = Store.GetCullingCentersZ();
+	const float* Radii = Store.GetCullingRadii();
+	const int32* CellIndices = Store.GetSpatialCellIndices();
+
+	const VectorRegister4Float AllMask = VectorCompareEQ(VectorZeroFloat(), VectorZeroFloat());
+
+	int32 Index = StartIndex;
+	for (; Index + 4 <= EndIndex; Index += 4)
+	{
+		// Lanes inside culled grid cells don't need the plane tests
+		int32 CellBits = 0;
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			CellBits |= Store.IsSpatialCellVisible(CellIndices[Index + Lane]) << Lane;
+		}
+		if (!CellBits)
+		{
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				Store.SetVisible(Index + Lane, false);
+			}
+			continue;
+		}
+
+		const VectorRegister4Double CenterX = VectorLoad(CentersX + Index);
+		const VectorRegister4Double CenterY = VectorLoad(CentersY + Index);
+		const VectorRegister4Double CenterZ = VectorLoad(CentersZ + Index);
+		const VectorRegister4Float Radius = VectorLoad(Radii + Index);
+		const VectorRegister4Float NegativeRadius = VectorNegate(Radius);
+		const VectorRegister4Float RadiusSquared = VectorMultiply(Radius, Radius);
+
+		VectorRegister4Float Visible = VectorZeroFloat();
+		for (const FCameraView_Lf& View : PlayerViews)
+		{
+			// Relative to the camera the precision of floats is plenty, even in large worlds
+			const FVector& CameraLocation = View.InterpolatedCameraTransform_Internal.GetLocation();
+			const VectorRegister4Float RelativeX = MakeVectorRegisterFloatFromDouble(VectorSubtract(CenterX, VectorSetFloat1(CameraLocation.X)));
+			const VectorRegister4Float RelativeY = MakeVectorRegisterFloatFromDouble(VectorSubtract(CenterY, VectorSetFloat1(CameraLocation.Y)));
+			const VectorRegister4Float RelativeZ = MakeVectorRegisterFloatFromDouble(VectorSubtract(CenterZ, VectorSetFloat1(CameraLocation.Z)));
+
+			// The camera inside the sphere always counts as visible, same as the tolerance radius of the box test
+			const VectorRegister4Float DistanceSquared = VectorMultiplyAdd(RelativeX, RelativeX,
+				VectorMultiplyAdd(RelativeY, RelativeY, VectorMultiply(RelativeZ, RelativeZ)));
+			const VectorRegister4Float Near = VectorCompareLE(DistanceSquared, RadiusSquared);
+
+			VectorRegister4Float Inside = AllMask;
+			for (uint8 p = 0; p < 6; ++p)
+			{
+				const FVector4f& Plane = View.CullingPlanes_Internal[p];
+				const VectorRegister4Float Distance = VectorMultiplyAdd(VectorSetFloat1(Plane.X), RelativeX,
+					VectorMultiplyAdd(VectorSetFloat1(Plane.Y), RelativeY,
+						VectorMultiplyAdd(VectorSetFloat1(Plane.Z), RelativeZ, VectorSetFloat1(-Plane.W))));
+				Inside = VectorBitwiseAnd(Inside, VectorCompareGE(Distance, NegativeRadius));
+			}
+
+			Visible = VectorBitwiseOr(Visible, VectorBitwiseOr(Inside, Near));
+		}
+
+		const int32 VisibleBits = VectorMaskBits(Visible) & CellBits;
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			Store.SetVisible(Index + Lane, (VisibleBits & (1 << Lane)) != 0);
+		}
+	}
+
+	// Remainder which doesn't fill a whole register
+	for (; Index < EndIndex; ++Index)
+	{
+		Store.SetVisible(Index, Store.IsSpatialCellVisible(CellIndices[Index]) &&
+		                 IsSphereVisible_Lf(FVector(CentersX[Index], CentersY[Index], CentersZ[Index]), Radii[Index], PlayerViews));
+	}
+}
+
+void FTurboSequence_Utility_Lf::RefreshAsyncChunkedMeshData(FSkinnedMeshGlobalLibrary_Lf& Library)
+{
+	CreateBoneMaps(Library);
+	CreateInverseReferencePose(Library);
+
+	Library.ReferenceData.ReferenceDataVersion++;
 }
 
 void FTurboSequence_Utility_Lf::UpdateMaxBones(FSkinnedMeshGlobalLibrary_Lf& Library)
@@ -219,8 +425,7 @@ void FTurboSequence_Utility_Lf::UpdateMaxBones(FSkinnedMeshGlobalLibrary_Lf& Lib
 	Library.MaxNumGPUBones = MaxNumGPUBones;
 }
 
-void FTurboSequence_Utility_Lf::CreateBoneMaps(FSkinnedMeshGlobalLibrary_Lf& Library,
-                                               FSkinnedMeshGlobalLibrary_RenderThread_Lf& Library_RenderThread)
+void FTurboSequence_Utility_Lf::CreateBoneMaps(FSkinnedMeshGlobalLibrary_Lf& Library)
 {
 	if (Library.PerReferenceData.Num() == 0)
 	{
@@ -230,13 +435,13 @@ void FTurboSequence_Utility_Lf::CreateBoneMaps(FSkinnedMeshGlobalLibrary_Lf& Lib
 	const int32 MaxNumCPUBones = Library.MaxNumCPUBones;
 	const int32 MaxNumGPUBones = Library.MaxNumGPUBones;
 		
-	Library_RenderThread.BoneTransformParams.NumMaxCPUBones = MaxNumCPUBones;
+	Library.ReferenceData.NumMaxCPUBones = MaxNumCPUBones;
 
-	Library_RenderThread.BoneTransformParams.ReferenceNumCPUBones.Reset();
+	Library.ReferenceData.ReferenceNumCPUBones.Reset();
 
 	for (const UTurboSequence_MeshAsset_Lf* TurboSequence_MeshAsset_Lf : Library.PerReferenceDataKeys)
 	{
-		Library_RenderThread.BoneTransformParams.ReferenceNumCPUBones.Add(TurboSequence_MeshAsset_Lf->GetNumCPUBones());
+		Library.ReferenceData.ReferenceNumCPUBones.Add(TurboSequence_MeshAsset_Lf->GetNumCPUBones());
 	}
 
 	const int32 NumReferences = Library.PerReferenceDataKeys.Num();
@@ -283,11 +488,10 @@ void FTurboSequence_Utility_Lf::CreateBoneMaps(FSkinnedMeshGlobalLibrary_Lf& Lib
 		}
 	}
 		
-	Library_RenderThread.BoneTransformParams.Indices = CachedIndices;
+	Library.ReferenceData.Indices = CachedIndices;
 }
 
-void FTurboSequence_Utility_Lf::CreateInverseReferencePose(FSkinnedMeshGlobalLibrary_Lf& Library,
-                                                           FSkinnedMeshGlobalLibrary_RenderThread_Lf& Library_RenderThread)
+void FTurboSequence_Utility_Lf::CreateInverseReferencePose(FSkinnedMeshGlobalLibrary_Lf& Library)
 {
 	int32 NumReferences = Library.PerReferenceDataKeys.Num();
 	TArray<FVector4f> InvRefPoseData;
@@ -328,9 +532,236 @@ void FTurboSequence_Utility_Lf::CreateInverseReferencePose(FSkinnedMeshGlobalLib
 		}
 	}
 
-	Library_RenderThread.BoneTransformParams.CPUInverseReferencePose = InvRefPoseData;
+	Library.ReferenceData.CPUInverseReferencePose = InvRefPoseData;
+}
+
+
+void FTurboSequence_Utility_Lf::InitializeAnimationPoseData(FAnimationLibraryData_Lf& LibraryAnimData,
+                                                            const UTurboSequence_MeshAsset_Lf* Asset,
+                                                            const UAnimSequence* Animation)
+{
+	const FReferenceSkeleton& ReferenceSkeleton = Asset->GetReferenceSkeleton();
+	const FReferenceSkeleton& AnimationSkeleton = Animation->GetSkeleton()->GetReferenceSkeleton();
+
+	LibraryAnimData.PoseOptions = FAnimPoseEvaluationOptions_Lf();
+	LibraryAnimData.PoseOptions.bEvaluateCurves = true;
+	LibraryAnimData.PoseOptions.bShouldRetarget = true;
+	LibraryAnimData.PoseOptions.bExtractRootMotion = false;
+	LibraryAnimData.PoseOptions.bRetrieveAdditiveAsFullPose = true;
+	bool bNeedOptionalSkeletonMesh = true;
+	const uint16 NumAnimationBones = AnimationSkeleton.GetNum();
+	for (uint16 b = 0; b < NumAnimationBones; ++b)
+	{
+		const FName& BoneName = GetSkeletonBoneName(AnimationSkeleton, b);
+		if (GetSkeletonBoneIndex(ReferenceSkeleton, BoneName) == INDEX_NONE)
+		{
+			bNeedOptionalSkeletonMesh = false;
+			break;
+		}
+	}
+	if (bNeedOptionalSkeletonMesh)
+	{
+		LibraryAnimData.PoseOptions.OptionalSkeletalMesh = Asset->ReferenceMeshNative;
+	}
+	if (Animation->IsCompressedDataValid())
+	{
+		LibraryAnimData.PoseOptions.EvaluationType = EAnimDataEvalType_Lf::Compressed;
+	}
+
+	FAnimPose_Lf AlphaPose;
+	FTurboSequence_Helper_Lf::GetPoseInfo(0, Animation, LibraryAnimData.PoseOptions,
+	                                      AlphaPose);
+
+	for (uint16 B = 0; B < LibraryAnimData.NumBones; ++B)
+	{
+		const FName& BoneName = GetSkeletonBoneName(ReferenceSkeleton, B);
+		if (int32 PoseBoneIndex = FTurboSequence_Helper_Lf::GetAnimationBonePoseIndex(AlphaPose, BoneName);
+			PoseBoneIndex > INDEX_NONE)
+		{
+			LibraryAnimData.BoneNameToAnimationBoneIndex.FindOrAdd(BoneName, PoseBoneIndex);
+		}
+	}
+}
+
+int32 FTurboSequence_Utility_Lf::GetAnimationLibraryMaxFrames(const UAnimSequence* Animation,
+                                                             const UTurboSequence_MeshAsset_Lf* Asset)
+{
+	return Animation->GetPlayLength() / Asset->TimeBetweenAnimationLibraryFrames - 1;
+}
+
+float FTurboSequence_Utility_Lf::GetAnimationLibraryFrameTime(const int32 CPUIndex, const int32 MaxFrames,
+                                                             const UAnimSequence* Animation)
+{
+	return static_cast<float>(CPUIndex) / static_cast<float>(MaxFrames - 1) * Animation->GetPlayLength();
+}
+
+bool FTurboSequence_Utility_Lf::BakeAnimation(FTurboSequence_BakedAnimation_Lf& OutBakedAnimation,
+                                              const UTurboSequence_MeshAsset_Lf* Asset, UAnimSequence* Animation)
+{
+	if (!IsValid(Asset) || !IsValid(Asset->ReferenceMeshNative) || !IsValid(Animation) || !IsValid(Animation->GetSkeleton()))
+	{
+		return false;
+	}
+
+	FAnimationLibraryData_Lf LibraryAnimData;
+	LibraryAnimData.NumBones = Asset->GetNumCPUBones();
+	LibraryAnimData.MaxFrames = GetAnimationLibraryMaxFrames(Animation, Asset);
+	if (LibraryAnimData.MaxFrames <= 0 || !LibraryAnimData.NumBones)
+	{
+		return false;
+	}
+
+	InitializeAnimationPoseData(LibraryAnimData, Asset, Animation);
+
+	const FReferenceSkeleton& ReferenceSkeleton = Asset->GetReferenceSkeleton();
+	const FReferenceSkeleton& AnimationSkeleton = Animation->GetSkeleton()->GetReferenceSkeleton();
+
+	OutBakedAnimation.Animation = Animation;
+	OutBakedAnimation.NumFrames = LibraryAnimData.MaxFrames;
+	OutBakedAnimation.NumBones = LibraryAnimData.NumBones;
+	OutBakedAnimation.Keyframes.Reset(LibraryAnimData.MaxFrames * LibraryAnimData.NumBones * 3);
+
+	// Same sampling as AddAnimationPoseToLibraryChunked, so baked and sampled keyframes match texel for texel
+	for (int32 CPUIndex = 0; CPUIndex < LibraryAnimData.MaxFrames; ++CPUIndex)
+	{
+		FAnimPose_Lf PoseData;
+		FTurboSequence_Helper_Lf::GetPoseInfo(GetAnimationLibraryFrameTime(CPUIndex, LibraryAnimData.MaxFrames, Animation),
+		                                      Animation, LibraryAnimData.PoseOptions, PoseData);
+
+		for (uint16 BoneIndex = 0; BoneIndex < LibraryAnimData.NumBones; ++BoneIndex)
+		{
+			const FTurboSequence_TransposeMatrix_Lf& BoneSpaceTransform = GetBoneTransformFromLocalPoses(
+				BoneIndex, LibraryAnimData, ReferenceSkeleton, AnimationSkeleton, PoseData, Animation);
+
+			for (uint8 M = 0; M < 3; ++M)
+			{
+				OutBakedAnimation.Keyframes.Add(BoneSpaceTransform.Colum[M]);
+			}
+		}
+	}
+
+	return true;
+}
+
+int32 FTurboSequence_Utility_Lf::AllocateAnimationLibraryKeyframe(FSkinnedMeshGlobalLibrary_Lf& Library, const int32 Size)
+{
+	int32 GPUIndex = Library.AnimationLibraryAllocator.Allocate(Size);
+	if (GPUIndex == INDEX_NONE && EvictAnimationLibraryKeyframes(Library, Size))
+	{
+		GPUIndex = Library.AnimationLibraryAllocator.Allocate(Size);
+	}
+
+	if (GPUIndex == INDEX_NONE)
+	{
+		// A full library stays full for a while, every keyframe requested meanwhile would log again
+		if (!Library.bWarnedAnimationLibraryFull)
+		{
+			Library.bWarnedAnimationLibraryFull = true;
+			UE_LOG(LogTurboSequence_Lf, Warning,
+			       TEXT("The Animation Library is full with keyframes in use, resize the Animation Library Texture, %d resident keyframes..."),
+			       Library.NumResidentAnimationKeyframes);
+		}
+		return INDEX_NONE;
+	}
+
+	Library.NumResidentAnimationKeyframes++;
+	Library.AnimationLibraryMaxNum = Library.AnimationLibraryAllocator.GetUsedSize();
+	return GPUIndex;
 }
 
+bool FTurboSequence_Utility_Lf::EvictAnimationLibraryKeyframes(FSkinnedMeshGlobalLibrary_Lf& Library, const int32 Size)
+{
+	// Every keyframe was in use a moment ago, another scan this frame won't find anything
+	if (Library.LastFailedAnimationLibraryEvictionFrame == Library.AnimationLibraryFrame)
+	{
+		return false;
+	}
+
+	// The GPU samples the keyframes the meshes and animation groups point to, also on frames they don't solve.
+	// A stand in or the rest pose sits behind another CPU index, so the GPU indices themselves are kept as well
+	TSet<int32> ReferencedGPUIndices;
+	auto MarkKeyframesUsed = [&Library, &ReferencedGPUIndices](const TArray<FAnimationMetaData_Lf>& AnimationMetaData)
+	{
+		for (const FAnimationMetaData_Lf& Animation : AnimationMetaData)
+		{
+			ReferencedGPUIndices.Add(Animation.GPUAnimationIndex_0);
+			ReferencedGPUIndices.Add(Animation.GPUAnimationIndex_1);
+
+			if (FAnimationLibraryData_Lf* LibraryAnimData = Library.AnimationLibraryData.Find(Animation.AnimationLibraryHash))
+			{
+				for (const int32 CPUIndex : {Animation.CPUAnimationIndex_0, Animation.CPUAnimationIndex_1})
+				{
+					if (LibraryAnimData->KeyframesLastUsedFrame.IsValidIndex(CPUIndex))
+					{
+						LibraryAnimData->KeyframesLastUsedFrame[CPUIndex] = Library.AnimationLibraryFrame;
+					}
+				}
+			}
+		}
+	};
+	for (const FSkinnedMeshRuntime_Lf& Runtime : Library.RuntimeSkinnedMeshes)
+	{
+		MarkKeyframesUsed(Runtime.AnimationMetaData);
+	}
+	for (const TPair<FTurboSequence_AnimationGroupHandle_Lf, FSkinnedMeshAnimationGroup_Lf>& Group : Library.AnimationGroups)
+	{
+		MarkKeyframesUsed(Group.Value.Timeline.AnimationMetaData);
+		for (const FSkinnedMeshAnimationGroupPhase_Lf& Phase : Group.Value.Phases)
+		{
+			MarkKeyframesUsed(Phase.AnimationMetaData);
+		}
+	}
+
+	// < Last Used Frame | Keyframe >
+	TArray<TTuple<int64, FAnimationLibraryData_Lf*, int32>> Candidates;
+	for (TPair<FUintVector, FAnimationLibraryData_Lf>& LibraryAnimData : Library.AnimationLibraryData)
+	{
+		if (LibraryAnimData.Value.bIsRestPose)
+		{
+			continue;
+		}
+
+		for (int32 CPUIndex = 0; CPUIndex < LibraryAnimData.Value.KeyframesFilled.Num(); ++CPUIndex)
+		{
+			const int64 LastUsedFrame = LibraryAnimData.Value.KeyframesLastUsedFrame[CPUIndex];
+			const int32 GPUIndex = LibraryAnimData.Value.KeyframesFilled[CPUIndex];
+			if (GPUIndex > INDEX_NONE && LastUsedFrame < Library.AnimationLibraryFrame && !ReferencedGPUIndices.Contains(GPUIndex))
+			{
+				Candidates.Add(MakeTuple(LastUsedFrame, &LibraryAnimData.Value, CPUIndex));
+			}
+		}
+	}
+	Candidates.Sort([](const TTuple<int64, FAnimationLibraryData_Lf*, int32>& A, const TTuple<int64, FAnimationLibraryData_Lf*, int32>& B)
+	{
+		return A.Get<0>() < B.Get<0>();
+	});
+
+	// Evicts a batch, the next keyframes of a new animation shouldn't trigger another scan right away
+	TSegregatedFitAllocator<3>& Allocator = Library.AnimationLibraryAllocator;
+	const int32 TargetFreeSize = FMath::Max(Size, Allocator.GetTotalSize() / 16);
+	for (const TTuple<int64, FAnimationLibraryData_Lf*, int32>& Candidate : Candidates)
+	{
+		if (Allocator.GetFreeSize() >= TargetFreeSize && Allocator.GetLargestFreeSize() >= Size)
+		{
+			break;
+		}
+
+		FAnimationLibraryData_Lf& LibraryAnimData = *Candidate.Get<1>();
+		int32& GPUIndex = LibraryAnimData.KeyframesFilled[Candidate.Get<2>()];
+		Allocator.Free(GPUIndex, LibraryAnimData.NumBones * 3);
+		GPUIndex = INDEX_NONE;
+
+		Library.NumResidentAnimationKeyframes--;
+		Library.NumEvictedAnimationKeyframes++;
+	}
+
+	if (Allocator.GetLargestFreeSize() < Size)
+	{
+		Library.LastFailedAnimationLibraryEvictionFrame = Library.AnimationLibraryFrame;
+		return false;
+	}
+	return true;
+}
 
 int32 FTurboSequence_Utility_Lf::AddAnimationPoseToLibraryChunked(const int32 CPUIndex,
                                                                   FSkinnedMeshGlobalLibrary_Lf& Library,
@@ -339,6 +770,8 @@ int32 FTurboSequence_Utility_Lf::AddAnimationPoseToLibraryChunked(const int32 CP
                                                                   const FReferenceSkeleton& ReferenceSkeleton,
                                                                   const FReferenceSkeleton& AnimationSkeleton)
 {
+	LibraryAnimData.KeyframesLastUsedFrame[CPUIndex] = Library.AnimationLibraryFrame;
+
 	int32 GPUIndex = LibraryAnimData.KeyframesFilled[CPUIndex];
 
 	if (GPUIndex > INDEX_NONE)
@@ -346,12 +779,96 @@ int32 FTurboSequence_Utility_Lf::AddAnimationPoseToLibraryChunked(const int32 CP
 		return GPUIndex;
 	}
 
-	GPUIndex = LibraryAnimData.KeyframesFilled[CPUIndex] = Library.AnimationLibraryMaxNum;
+	// Not sampled yet, the nearest resident keyframe stands in while a worker samples it,
+	// only an animation without any resident keyframe has to wait for the sample here
+	const FTurboSequence_BakedAnimation_Lf* BakedAnimation = LibraryAnimData.GetBakedAnimation();
+	if (!BakedAnimation && !LibraryAnimData.HasKeyframePose(CPUIndex))
+	{
+		const int32 FallbackCPUIndex = FindNearestResidentKeyframe(LibraryAnimData, CPUIndex);
+		if (FallbackCPUIndex > INDEX_NONE && (LibraryAnimData.KeyframesSampling[CPUIndex] ||
+			RequestKeyframeSample(Library, LibraryAnimData, Animation, CPUIndex)))
+		{
+			// The meta data points to the missing keyframe, the eviction only sees the stand in through this stamp
+			LibraryAnimData.KeyframesLastUsedFrame[FallbackCPUIndex] = Library.AnimationLibraryFrame;
+			Library.NumKeyframeSampleFallbacks++;
+			return LibraryAnimData.KeyframesFilled[FallbackCPUIndex];
+		}
+	}
+
+	const int32 NumAllocations = LibraryAnimData.NumBones * 3;
+	GPUIndex = AllocateAnimationLibraryKeyframe(Library, NumAllocations);
+	if (GPUIndex == INDEX_NONE)
+	{
+		// Another keyframe of the animation stands in until a keyframe frees up, the caller falls back to the rest pose
+		const int32 FallbackCPUIndex = FindNearestResidentKeyframe(LibraryAnimData, CPUIndex);
+		if (FallbackCPUIndex == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+		LibraryAnimData.KeyframesLastUsedFrame[FallbackCPUIndex] = Library.AnimationLibraryFrame;
+		return LibraryAnimData.KeyframesFilled[FallbackCPUIndex];
+	}
+	LibraryAnimData.KeyframesFilled[CPUIndex] = GPUIndex;
+
+	const bool bDecomposeKeyframe = !LibraryAnimData.KeyframesDecomposed.IsValidIndex(CPUIndex) ||
+		!LibraryAnimData.KeyframesDecomposed[CPUIndex];
+
+	if (BakedAnimation)
+	{
+		Library.AnimationLibraryDataAllocatedThisFrame.Append(&BakedAnimation->Keyframes[CPUIndex * NumAllocations], NumAllocations);
+		for (int32 TexelIndex = 0; TexelIndex < NumAllocations; ++TexelIndex)
+		{
+			Library.AnimationLibraryIndicesAllocatedThisFrame.Add(GPUIndex + TexelIndex);
+		}
+
+		if (bDecomposeKeyframe)
+		{
+			for (uint16 BoneIndex = 0; BoneIndex < LibraryAnimData.NumBones; ++BoneIndex)
+			{
+				DecomposeKeyframeBone(LibraryAnimData, CPUIndex, BoneIndex,
+				                      &BakedAnimation->Keyframes[CPUIndex * NumAllocations + BoneIndex * 3]);
+			}
+			LibraryAnimData.KeyframesDecomposed[CPUIndex] = true;
+		}
+		return GPUIndex;
+	}
+
+	uint32 AnimationDataIndex = Library.AnimationLibraryDataAllocatedThisFrame.Num();
+
+	Library.AnimationLibraryDataAllocatedThisFrame.AddUninitialized(NumAllocations);
+	for (int32 TexelIndex = 0; TexelIndex < NumAllocations; ++TexelIndex)
+	{
+		Library.AnimationLibraryIndicesAllocatedThisFrame.Add(GPUIndex + TexelIndex);
+	}
+
+	// Evicted before, the decomposed keyframe writes the texels again without sampling the animation
+	if (!bDecomposeKeyframe)
+	{
+		for (uint16 BoneIndex = 0; BoneIndex < LibraryAnimData.NumBones; ++BoneIndex)
+		{
+			const int32 KeyframeBoneIndex = CPUIndex * LibraryAnimData.NumBones + BoneIndex;
+			const FMatrix BoneMatrix = FTransform(FQuat(LibraryAnimData.KeyframeRotations[KeyframeBoneIndex]),
+			                                      FVector(LibraryAnimData.KeyframeTranslations[KeyframeBoneIndex]),
+			                                      FVector(LibraryAnimData.KeyframeScales[KeyframeBoneIndex])).ToMatrixWithScale();
+			for (uint8 M = 0; M < 3; ++M)
+			{
+				FVector4f BoneData;
+				BoneData.X = BoneMatrix.M[0][M];
+				BoneData.Y = BoneMatrix.M[1][M];
+				BoneData.Z = BoneMatrix.M[2][M];
+				BoneData.W = BoneMatrix.M[3][M];
+
+				Library.AnimationLibraryDataAllocatedThisFrame[AnimationDataIndex] = BoneData;
+
+				AnimationDataIndex++;
+			}
+		}
+		return GPUIndex;
+	}
 
 	if (!LibraryAnimData.KeyframeIndexToPose.Contains(CPUIndex))
 	{
-		const float FrameTime = static_cast<float>(CPUIndex) / static_cast<float>(LibraryAnimData.MaxFrames -
-			1) * Animation.Animation->GetPlayLength();
+		const float FrameTime = GetAnimationLibraryFrameTime(CPUIndex, LibraryAnimData.MaxFrames, Animation.Animation);
 
 		FAnimPose_Lf PoseData;
 		FTurboSequence_Helper_Lf::GetPoseInfo(FrameTime, Animation.Animation, LibraryAnimData.PoseOptions,
@@ -362,12 +879,6 @@ int32 FTurboSequence_Utility_Lf::AddAnimationPoseToLibraryChunked(const int32 CP
 		LibraryAnimData.KeyframeIndexToPose.Add(CPUIndex, CPUPose);
 	}
 
-	uint32 AnimationDataIndex = Library.AnimationLibraryDataAllocatedThisFrame.Num();
-
-	const int32 NumAllocations = LibraryAnimData.NumBones * 3;
-	Library.AnimationLibraryMaxNum += NumAllocations;
-
-	Library.AnimationLibraryDataAllocatedThisFrame.AddUninitialized(NumAllocations);
 	//LibraryAnimData.AnimPoses[Pose0].RawData.AddUninitialized(NumAllocations);
 	for (uint16 BoneIndex = 0; BoneIndex < LibraryAnimData.NumBones; ++BoneIndex)
 	{
@@ -385,10 +896,216 @@ int32 FTurboSequence_Utility_Lf::AddAnimationPoseToLibraryChunked(const int32 CP
 
 			AnimationDataIndex++;
 		}
+
+		DecomposeKeyframeBone(LibraryAnimData, CPUIndex, BoneIndex, BoneSpaceTransform.Colum.GetData());
 	}
+	LibraryAnimData.KeyframesDecomposed[CPUIndex] = true;
+
+	// The decomposed keyframe holds the same pose, keeping both would store every sampled keyframe twice
+	LibraryAnimData.KeyframeIndexToPose.Remove(CPUIndex);
 	return GPUIndex;
 }
 
+bool FTurboSequence_Utility_Lf::RequestKeyframeSample(FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                      FAnimationLibraryData_Lf& LibraryAnimData,
+                                                      const FAnimationMetaData_Lf& Animation,
+                                                      const int32 CPUIndex)
+{
+	if (Library.PendingKeyframeSamples.Num() >= Library.MaxPendingKeyframeSamples || !IsValid(Animation.Animation))
+	{
+		return false;
+	}
+
+	LibraryAnimData.KeyframesSampling[CPUIndex] = true;
+
+	FAnimationKeyframeSample_Lf& Sample = Library.PendingKeyframeSamples.AddDefaulted_GetRef();
+	Sample.AnimationLibraryHash = Animation.AnimationLibraryHash;
+	Sample.CPUIndex = CPUIndex;
+	Sample.Animation.Reset(Animation.Animation);
+
+	const float FrameTime = GetAnimationLibraryFrameTime(CPUIndex, LibraryAnimData.MaxFrames, Animation.Animation);
+	Sample.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+	                                [FrameTime, AnimSequence = Animation.Animation, PoseOptions = LibraryAnimData.PoseOptions]
+	                                {
+		                                FAnimPose_Lf PoseData;
+		                                FTurboSequence_Helper_Lf::GetPoseInfo(FrameTime, AnimSequence, PoseOptions, PoseData);
+		                                return PoseData;
+	                                });
+	return true;
+}
+
+void FTurboSequence_Utility_Lf::GetKeyframesToPrefetch(TArray<int32, TInlineAllocator<8>>& OutKeyframes,
+                                                       const FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                       const FAnimationLibraryData_Lf& LibraryAnimData,
+                                                       const FSkinnedMeshRuntime_Lf& Runtime,
+                                                       const FAnimationMetaData_Lf& Animation,
+                                                       const int32 CPUIndex0, const int32 CPUIndex1)
+{
+	OutKeyframes.Reset();
+
+	// Self managed animations jump wherever the game sets them, there is no play direction to follow
+	if (!Library.MaxPendingKeyframeSamples || Library.KeyframePrefetchTime <= 0 || LibraryAnimData.BakedAnimationIndex != INDEX_NONE ||
+		!LibraryAnimData.bHasPoseData || Animation.Settings.bAnimationTimeSelfManaged || !IsValid(Runtime.DataAsset))
+	{
+		return;
+	}
+
+	const float Speed = Animation.Settings.AnimationSpeed;
+	const int32 NumFrames = LibraryAnimData.KeyframesFilled.Num();
+	const int32 NumAhead = FMath::Min(
+		FMath::CeilToInt32(Library.KeyframePrefetchTime * FMath::Abs(Speed) /
+			FMath::Max(Runtime.DataAsset->TimeBetweenAnimationLibraryFrames, UE_KINDA_SMALL_NUMBER)),
+		FMath::Min(8, NumFrames - 1));
+
+	const int32 Direction = Speed < 0 ? -1 : 1;
+	int32 CPUIndex = Direction > 0 ? CPUIndex1 : CPUIndex0;
+	for (int32 Step = 0; Step < NumAhead; ++Step)
+	{
+		CPUIndex += Direction;
+		if (!LibraryAnimData.KeyframesFilled.IsValidIndex(CPUIndex))
+		{
+			if (!Animation.bIsLoop)
+			{
+				break;
+			}
+			CPUIndex = (CPUIndex + NumFrames) % NumFrames;
+		}
+
+		if (LibraryAnimData.KeyframesFilled[CPUIndex] == INDEX_NONE && !LibraryAnimData.KeyframesSampling[CPUIndex] &&
+			!LibraryAnimData.HasKeyframePose(CPUIndex))
+		{
+			OutKeyframes.Add(CPUIndex);
+		}
+	}
+}
+
+int32 FTurboSequence_Utility_Lf::FindNearestResidentKeyframe(const FAnimationLibraryData_Lf& LibraryAnimData,
+                                                             const int32 CPUIndex)
+{
+	const int32 NumFrames = LibraryAnimData.KeyframesFilled.Num();
+	for (int32 Distance = 1; Distance < NumFrames; ++Distance)
+	{
+		for (const int32 Neighbour : {CPUIndex - Distance, CPUIndex + Distance})
+		{
+			if (LibraryAnimData.KeyframesFilled.IsValidIndex(Neighbour) && LibraryAnimData.KeyframesFilled[Neighbour] > INDEX_NONE)
+			{
+				return Neighbour;
+			}
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FTurboSequence_Utility_Lf::CommitKeyframeSamples(FSkinnedMeshGlobalLibrary_Lf& Library)
+{
+	for (int32 SampleIndex = Library.PendingKeyframeSamples.Num() - 1; SampleIndex >= 0; --SampleIndex)
+	{
+		FAnimationKeyframeSample_Lf& Sample = Library.PendingKeyframeSamples[SampleIndex];
+		if (!Sample.Task.IsCompleted())
+		{
+			continue;
+		}
+
+		// The texels get written when a mesh needs the keyframe, the expensive part was the decompression
+		if (FAnimationLibraryData_Lf* LibraryAnimData = Library.AnimationLibraryData.Find(Sample.AnimationLibraryHash);
+			LibraryAnimData && LibraryAnimData->KeyframesSampling.IsValidIndex(Sample.CPUIndex))
+		{
+			LibraryAnimData->KeyframesSampling[Sample.CPUIndex] = false;
+			if (!LibraryAnimData->HasKeyframePose(Sample.CPUIndex))
+			{
+				FCPUAnimationPose_Lf CPUPose;
+				CPUPose.Pose = MoveTemp(Sample.Task.GetResult());
+				LibraryAnimData->KeyframeIndexToPose.Add(Sample.CPUIndex, MoveTemp(CPUPose));
+			}
+		}
+		Library.PendingKeyframeSamples.RemoveAtSwap(SampleIndex);
+	}
+}
+
+void FTurboSequence_Utility_Lf::PrefetchKeyframes(FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                  FAnimationLibraryData_Lf& LibraryAnimData,
+                                                  const FSkinnedMeshRuntime_Lf& Runtime,
+                                                  const FAnimationMetaData_Lf& Animation,
+                                                  const int32 CPUIndex0, const int32 CPUIndex1)
+{
+	TArray<int32, TInlineAllocator<8>> Keyframes;
+	GetKeyframesToPrefetch(Keyframes, Library, LibraryAnimData, Runtime, Animation, CPUIndex0, CPUIndex1);
+	for (const int32 CPUIndex : Keyframes)
+	{
+		if (!RequestKeyframeSample(Library, LibraryAnimData, Animation, CPUIndex))
+		{
+			break;
+		}
+	}
+}
+
+// Makes the rest pose of the mesh resident and returns its library index, writes the texels when it gets allocated
+static bool AddRestPoseToLibrary_Lf(FSkinnedMeshGlobalLibrary_Lf& Library, FAnimationLibraryData_Lf& RestPoseData,
+                                    const FSkinnedMeshRuntime_Lf& Runtime, int32& OutGPUIndex)
+{
+	if (RestPoseData.KeyframesFilled.Num() && RestPoseData.KeyframesFilled[0] > INDEX_NONE)
+	{
+		OutGPUIndex = RestPoseData.KeyframesFilled[0];
+		return true;
+	}
+
+	const int32 NumAllocations = RestPoseData.NumBones * 3;
+	const int32 RestPoseGPUIndex = FTurboSequence_Utility_Lf::AllocateAnimationLibraryKeyframe(Library, NumAllocations);
+	if (RestPoseGPUIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RestPoseData.bIsRestPose = true;
+	if (!RestPoseData.KeyframesFilled.Num())
+	{
+		RestPoseData.KeyframesFilled.Init(RestPoseGPUIndex, 1);
+		RestPoseData.KeyframesLastUsedFrame.Init(Library.AnimationLibraryFrame, 1);
+		RestPoseData.MaxFrames = 1;
+	}
+	else
+	{
+		RestPoseData.KeyframesFilled[0] = RestPoseGPUIndex;
+	}
+	OutGPUIndex = RestPoseGPUIndex;
+
+	if (!RestPoseData.KeyframeIndexToPose.Contains(0))
+	{
+		FCPUAnimationPose_Lf CPUPose_0;
+		RestPoseData.KeyframeIndexToPose.Add(0, CPUPose_0);
+	}
+
+	uint32 AnimationDataIndex = Library.AnimationLibraryDataAllocatedThisFrame.Num();
+
+	const FReferenceSkeleton& ReferenceSkeleton = FTurboSequence_Utility_Lf::GetReferenceSkeleton(Runtime.DataAsset);
+	Library.AnimationLibraryDataAllocatedThisFrame.AddUninitialized(NumAllocations);
+	for (int32 TexelIndex = 0; TexelIndex < NumAllocations; ++TexelIndex)
+	{
+		Library.AnimationLibraryIndicesAllocatedThisFrame.Add(RestPoseGPUIndex + TexelIndex);
+	}
+	for (uint16 b = 0; b < RestPoseData.NumBones; ++b)
+	{
+		const FMatrix& BoneMatrix = FTurboSequence_Utility_Lf::GetSkeletonRefPose(ReferenceSkeleton)[b].ToMatrixWithScale();
+		// NOTE: Keep in mind this matrix is not in correct order after uploading it
+		//		 for performance reason we are using matrix calculations which match the order
+		//		 in the Vertex Shader
+		for (uint8 M = 0; M < 3; ++M)
+		{
+			FVector4f BoneData;
+			BoneData.X = BoneMatrix.M[0][M];
+			BoneData.Y = BoneMatrix.M[1][M];
+			BoneData.Z = BoneMatrix.M[2][M];
+			BoneData.W = BoneMatrix.M[3][M];
+
+			Library.AnimationLibraryDataAllocatedThisFrame[AnimationDataIndex] = BoneData;
+
+			AnimationDataIndex++;
+		}
+	}
+
+	return true;
+}
+
 bool FTurboSequence_Utility_Lf::AddAnimationToLibraryChunked(FSkinnedMeshGlobalLibrary_Lf& Library,
                                                              int32& CPUIndex0,
                                                              int32& GPUIndex0,
@@ -396,6 +1113,10 @@ bool FTurboSequence_Utility_Lf::AddAnimationToLibraryChunked(FSkinnedMeshGlobalL
                                                              const FSkinnedMeshRuntime_Lf& Runtime,
                                                              const FAnimationMetaData_Lf& Animation)
 {
+	// The meta data is passed in, a mesh nothing can be made resident for keeps its last keyframes
+	const int32 LastGPUIndex0 = GPUIndex0;
+	const int32 LastGPUIndex1 = GPUIndex1;
+
 	CPUIndex0 = 0;
 	CPUIndex1 = 0;
 	GPUIndex0 = 0;
@@ -415,15 +1136,22 @@ bool FTurboSequence_Utility_Lf::AddAnimationToLibraryChunked(FSkinnedMeshGlobalL
 	{
 		if (!LibraryAnimData.KeyframesFilled.Num())
 		{
-			LibraryAnimData.MaxFrames = Animation.Animation->GetPlayLength() / Runtime.DataAsset->
-				TimeBetweenAnimationLibraryFrames - 1;
-
+			LibraryAnimData.MaxFrames = GetAnimationLibraryMaxFrames(Animation.Animation, Runtime.DataAsset);
+			LibraryAnimData.BakedAnimationAsset = Runtime.DataAsset;
+			LibraryAnimData.BakedAnimationSequence = Animation.Animation;
+			LibraryAnimData.BakedAnimationIndex = Runtime.DataAsset->FindBakedAnimation(
+				Animation.Animation, LibraryAnimData.MaxFrames, LibraryAnimData.NumBones);
 
 			LibraryAnimData.KeyframesFilled.Init(INDEX_NONE, LibraryAnimData.MaxFrames);
+			LibraryAnimData.KeyframesLastUsedFrame.Init(0, LibraryAnimData.MaxFrames);
+			LibraryAnimData.KeyframesSampling.Init(false, LibraryAnimData.MaxFrames);
 			if (!LibraryAnimData.KeyframesFilled.Num())
 			{
 				return false;
 			}
+
+			BakeAnimationCurves(Library, LibraryAnimData, Animation.Animation);
+			BakeRootMotionTrack(LibraryAnimData, Animation.Animation);
 		}
 
 		FrameAlpha = AnimationCodecTimeToIndex(Animation.AnimationNormalizedTime, LibraryAnimData.MaxFrames,
@@ -438,110 +1166,62 @@ bool FTurboSequence_Utility_Lf::AddAnimationToLibraryChunked(FSkinnedMeshGlobalL
 
 		const FReferenceSkeleton& AnimationSkeleton = Animation.Animation->GetSkeleton()->GetReferenceSkeleton();
 
-		if (!LibraryAnimData.bHasPoseData)
+		// The asset got re-baked, the animation is found again or samples at runtime from now on
+		if (LibraryAnimData.BakedAnimationIndex != INDEX_NONE && !LibraryAnimData.GetBakedAnimation())
 		{
-			LibraryAnimData.bHasPoseData = true;
-
-			LibraryAnimData.PoseOptions = FAnimPoseEvaluationOptions_Lf();
-			LibraryAnimData.PoseOptions.bEvaluateCurves = true;
-			LibraryAnimData.PoseOptions.bShouldRetarget = true;
-			LibraryAnimData.PoseOptions.bExtractRootMotion = false;
-			LibraryAnimData.PoseOptions.bRetrieveAdditiveAsFullPose = true;
-			bool bNeedOptionalSkeletonMesh = true;
-			const uint16 NumAnimationBones = AnimationSkeleton.GetNum();
-			for (uint16 b = 0; b < NumAnimationBones; ++b)
+			LibraryAnimData.BakedAnimationIndex = Runtime.DataAsset->FindBakedAnimation(
+				Animation.Animation, LibraryAnimData.MaxFrames, LibraryAnimData.NumBones);
+			LibraryAnimData.BakedAnimationAsset = Runtime.DataAsset;
+			if (LibraryAnimData.BakedAnimationIndex == INDEX_NONE && LibraryAnimData.bHasPoseData)
 			{
-				const FName& BoneName = GetSkeletonBoneName(AnimationSkeleton, b);
-				if (GetSkeletonBoneIndex(ReferenceSkeleton, BoneName) == INDEX_NONE)
-				{
-					bNeedOptionalSkeletonMesh = false;
-					break;
-				}
-			}
-			if (bNeedOptionalSkeletonMesh)
-			{
-				LibraryAnimData.PoseOptions.OptionalSkeletalMesh = Runtime.DataAsset->ReferenceMeshNative;
-			}
-			if (Animation.Animation->IsCompressedDataValid())
-			{
-				LibraryAnimData.PoseOptions.EvaluationType = EAnimDataEvalType_Lf::Compressed;
+				InitializeAnimationPoseData(LibraryAnimData, Runtime.DataAsset, Animation.Animation);
 			}
+		}
 
-			FAnimPose_Lf AlphaPose;
-			FTurboSequence_Helper_Lf::GetPoseInfo(0, Animation.Animation, LibraryAnimData.PoseOptions,
-			                                      AlphaPose);
+		if (!LibraryAnimData.bHasPoseData)
+		{
+			LibraryAnimData.bHasPoseData = true;
 
-			for (uint16 B = 0; B < LibraryAnimData.NumBones; ++B)
+			// Baked keyframes never touch the animation
+			if (LibraryAnimData.BakedAnimationIndex == INDEX_NONE)
 			{
-				const FName& BoneName = GetSkeletonBoneName(ReferenceSkeleton, B);
-				if (int32 PoseBoneIndex = FTurboSequence_Helper_Lf::GetAnimationBonePoseIndex(AlphaPose, BoneName);
-					PoseBoneIndex > INDEX_NONE)
-				{
-					LibraryAnimData.BoneNameToAnimationBoneIndex.FindOrAdd(BoneName, PoseBoneIndex);
-				}
+				InitializeAnimationPoseData(LibraryAnimData, Runtime.DataAsset, Animation.Animation);
 			}
 		}
 		
 		GPUIndex0 = AddAnimationPoseToLibraryChunked(CPUIndex0, Library, Animation, LibraryAnimData, ReferenceSkeleton, AnimationSkeleton);
 		GPUIndex1 = AddAnimationPoseToLibraryChunked(CPUIndex1, Library, Animation, LibraryAnimData, ReferenceSkeleton, AnimationSkeleton);
-	}
-	else // Is Rest Pose
-	{
-		CPUIndex0 = CPUIndex1 = 0;
 
-		if (LibraryAnimData.KeyframesFilled.Num() && LibraryAnimData.KeyframesFilled[0] > INDEX_NONE)
+		// The library is full and the animation has nothing resident, the mesh shows its rest pose until keyframes free up.
+		// The rest pose resolves after the animations, so it gets allocated here when this mesh is the first to need it
+		if (GPUIndex0 == INDEX_NONE || GPUIndex1 == INDEX_NONE)
 		{
-			CPUIndex0 = CPUIndex1 = LibraryAnimData.KeyframesFilled[0];
-			return true;
-		}
-
-		if (!LibraryAnimData.KeyframesFilled.Num())
-		{
-			LibraryAnimData.KeyframesFilled.Init(Library.AnimationLibraryMaxNum, 1);
-			LibraryAnimData.MaxFrames = 1;
-
-			//const FReferenceSkeleton& ReferenceSkeleton = GetReferenceSkeleton(Runtime.DataAsset);
-			//LibraryAnimData.NumBones = GetSkeletonNumBones(ReferenceSkeleton);
-		}
-		else
-		{
-			LibraryAnimData.KeyframesFilled[0] = Library.AnimationLibraryMaxNum;
-		}
-		GPUIndex0 = GPUIndex1 = LibraryAnimData.KeyframesFilled[0];
-
-		if (!LibraryAnimData.KeyframeIndexToPose.Contains(0))
-		{
-			FCPUAnimationPose_Lf CPUPose_0;
-			LibraryAnimData.KeyframeIndexToPose.Add(0, CPUPose_0);
-		}
-
-		int32 NumAllocations = LibraryAnimData.NumBones * 3;
-		Library.AnimationLibraryMaxNum += NumAllocations;
-
-		uint32 AnimationDataIndex = Library.AnimationLibraryDataAllocatedThisFrame.Num();
-
-		const FReferenceSkeleton& ReferenceSkeleton = GetReferenceSkeleton(Runtime.DataAsset);
-		Library.AnimationLibraryDataAllocatedThisFrame.AddUninitialized(NumAllocations);
-		for (uint16 b = 0; b < LibraryAnimData.NumBones; ++b)
-		{
-			const FMatrix& BoneMatrix = GetSkeletonRefPose(ReferenceSkeleton)[b].ToMatrixWithScale();
-			// NOTE: Keep in mind this matrix is not in correct order after uploading it
-			//		 for performance reason we are using matrix calculations which match the order
-			//		 in the Vertex Shader
-			for (uint8 M = 0; M < 3; ++M)
+			FAnimationLibraryData_Lf* RestPoseData = Library.AnimationLibraryData.Find(
+				GetAnimationLibraryKey(Runtime.DataAsset->GetSkeleton(), Runtime.DataAsset, nullptr));
+			int32 RestPoseGPUIndex;
+			if (!RestPoseData || !AddRestPoseToLibrary_Lf(Library, *RestPoseData, Runtime, RestPoseGPUIndex))
 			{
-				FVector4f BoneData;
-				BoneData.X = BoneMatrix.M[0][M];
-				BoneData.Y = BoneMatrix.M[1][M];
-				BoneData.Z = BoneMatrix.M[2][M];
-				BoneData.W = BoneMatrix.M[3][M];
+				GPUIndex0 = LastGPUIndex0;
+				GPUIndex1 = LastGPUIndex1;
+				return false;
+			}
+			GPUIndex0 = GPUIndex0 == INDEX_NONE ? RestPoseGPUIndex : GPUIndex0;
+			GPUIndex1 = GPUIndex1 == INDEX_NONE ? RestPoseGPUIndex : GPUIndex1;
+		}
 
-				Library.AnimationLibraryDataAllocatedThisFrame[AnimationDataIndex] = BoneData;
-				//LibraryAnimData.AnimPoses[0].RawData[b * 3 + M] = BoneData;
+		PrefetchKeyframes(Library, LibraryAnimData, Runtime, Animation, CPUIndex0, CPUIndex1);
+	}
+	else // Is Rest Pose
+	{
+		CPUIndex0 = CPUIndex1 = 0;
 
-				AnimationDataIndex++;
-			}
+		if (!AddRestPoseToLibrary_Lf(Library, LibraryAnimData, Runtime, GPUIndex0))
+		{
+			GPUIndex0 = LastGPUIndex0;
+			GPUIndex1 = LastGPUIndex1;
+			return false;
 		}
+		GPUIndex1 = GPUIndex0;
 	}
 
 	return true;
@@ -577,9 +1257,9 @@ void UTurboSequenceRenderAttachmentData::AddAttachmentRenderInstance(const FAtta
 	ParticleAttachmentScales[InstanceIndex] = AttachmentLocalTransform.GetScale3D();
 	ParticleAttachmentRotations[InstanceIndex] = FTurboSequence_Helper_Lf::ConvertQuaternion4FToVector4F(AttachmentLocalTransform.GetRotation());
 	
-	bChangedParticleAttachmentPosition = true;
-	bChangedParticleAttachmentScale = true;
-	bChangedParticleAttachmentRotation = true;
+	DirtyAttachmentPositions.MarkDirty(InstanceIndex);
+	DirtyAttachmentScales.MarkDirty(InstanceIndex);
+	DirtyAttachmentRotations.MarkDirty(InstanceIndex);
 
 	UpdateInstanceTransformInternal(InstanceIndex, WorldSpaceTransform, bReuse);
 
@@ -588,31 +1268,45 @@ void UTurboSequenceRenderAttachmentData::AddAttachmentRenderInstance(const FAtta
 	SetGPUBoneIndexForInstanceInternal(BoneIndex, InstanceIndex);
 }
 
+void UTurboSequenceRenderAttachmentData::MoveRenderInstanceInternal(const int32 FromIndex, const int32 ToIndex)
+{
+	Super::MoveRenderInstanceInternal(FromIndex, ToIndex);
+
+	ParticleAttachmentPositions[ToIndex] = ParticleAttachmentPositions[FromIndex];
+	DirtyAttachmentPositions.MarkDirty(ToIndex);
+	ParticleAttachmentScales[ToIndex] = ParticleAttachmentScales[FromIndex];
+	DirtyAttachmentScales.MarkDirty(ToIndex);
+	ParticleAttachmentRotations[ToIndex] = ParticleAttachmentRotations[FromIndex];
+	DirtyAttachmentRotations.MarkDirty(ToIndex);
+}
+
+void UTurboSequenceRenderAttachmentData::ShrinkRenderInstancesInternal(const int32 NumInstances)
+{
+	Super::ShrinkRenderInstancesInternal(NumInstances);
+
+	ParticleAttachmentPositions.SetNum(NumInstances);
+	ParticleAttachmentScales.SetNum(NumInstances);
+	ParticleAttachmentRotations.SetNum(NumInstances);
+}
+
 void UTurboSequenceRenderAttachmentData::UpdateNiagaraEmitter()
 {
-	if (bChangedParticleAttachmentPosition || bChangedCollectionSizeThisFrame)
-	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(
-			NiagaraComponent, TEXT("User.ParticleAttachment_Position"), ParticleAttachmentPositions);
-	}
+	static const FName AttachmentPositionName = TEXT("User.ParticleAttachment_Position");
+	static const FName AttachmentRotationName = TEXT("User.ParticleAttachment_Rotation");
+	static const FName AttachmentScaleName = TEXT("User.ParticleAttachment_Scale");
 
-	if (bChangedParticleAttachmentRotation || bChangedCollectionSizeThisFrame)
-	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4(
-			NiagaraComponent, TEXT("User.ParticleAttachment_Rotation"), ParticleAttachmentRotations);
-	}
-		
-	if (bChangedParticleAttachmentScale || bChangedCollectionSizeThisFrame)
-	{
-		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(
-			NiagaraComponent, TEXT("User.ParticleAttachment_Scale"), ParticleAttachmentScales);
-	}
+	int32 WrittenAttachmentBytes = UploadNiagaraArray<UNiagaraDataInterfaceArrayFloat3>(DirtyAttachmentPositions,
+		ParticleAttachmentPositions, AttachmentPositionName, bChangedCollectionSizeThisFrame, sizeof(FVector3f));
+
+	WrittenAttachmentBytes += UploadNiagaraArray<UNiagaraDataInterfaceArrayFloat4>(DirtyAttachmentRotations,
+		ParticleAttachmentRotations, AttachmentRotationName, bChangedCollectionSizeThisFrame, sizeof(FVector4f));
 
-	bChangedParticleAttachmentPosition = false;
-	bChangedParticleAttachmentRotation = false;
-	bChangedParticleAttachmentScale = false;
+	WrittenAttachmentBytes += UploadNiagaraArray<UNiagaraDataInterfaceArrayFloat3>(DirtyAttachmentScales,
+		ParticleAttachmentScales, AttachmentScaleName, bChangedCollectionSizeThisFrame, sizeof(FVector3f));
 
 	Super::UpdateNiagaraEmitter();
+
+	WrittenBytesThisFrame += WrittenAttachmentBytes;
 }
 
 
@@ -710,7 +1404,8 @@ void FTurboSequence_Utility_Lf::AddAnimation(FSkinnedMeshRuntime_Lf& Runtime,
                                              FAnimationMetaData_Lf& Animation,
                                              FSkinnedMeshGlobalLibrary_Lf& Library, const bool bForceFront)
 {
-	
+	Animation.MaskProxyHandle = Animation.Settings.MaskDefinition.GetBuiltProxyHandle(Runtime.DataAsset);
+	Animation.MaskLayerVersion = 0;
 
 	if(bForceFront)
 	{
@@ -721,8 +1416,36 @@ void FTurboSequence_Utility_Lf::AddAnimation(FSkinnedMeshRuntime_Lf& Runtime,
 		Runtime.AnimationMetaData.Add(Animation);
 	}
 	
-	FBoneMaskBuiltProxyHandle BoneMaskBuiltProxyHandle = Animation.Settings.MaskDefinition.GetBuiltProxyHandle(Runtime.DataAsset);
+	AcquireAnimationMask(Library, Animation.MaskProxyHandle, Animation.Settings.MaskDefinition, Runtime.DataAsset);
+	
+	if(!Library.AnimationLibraryData.Contains(Animation.AnimationLibraryHash))
+	{
+		FAnimationLibraryData_Lf Data = FAnimationLibraryData_Lf();
+		Data.NumBones = Runtime.DataAsset->GetNumCPUBones();
+		if (IsValid(Animation.Animation))
+		{
+			BuildNotifyTimeline(Data, Animation.Animation);
+		}
+		Library.AnimationLibraryData.Add(Animation.AnimationLibraryHash, Data);
+	}
+}
 
+void FTurboSequence_Utility_Lf::RemoveAnimation(FSkinnedMeshRuntime_Lf& Runtime,
+                                                FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                const int32 Index)
+{
+	const FAnimationMetaData_Lf& Animation = Runtime.AnimationMetaData[Index];
+
+	ReleaseAnimationMask(Library, Animation.MaskProxyHandle);
+
+	Runtime.AnimationMetaData.RemoveAt(Index);
+}
+
+void FTurboSequence_Utility_Lf::AcquireAnimationMask(FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                     const FBoneMaskBuiltProxyHandle& BoneMaskBuiltProxyHandle,
+                                                     const FTurboSequence_MaskDefinition& MaskDefinition,
+                                                     const TObjectPtr<UTurboSequence_MeshAsset_Lf>& DataAsset)
+{
 	if(int* MaskRefCount = Library.MaskRefCount.Find(BoneMaskBuiltProxyHandle))
 	{
 		(*MaskRefCount)++;
@@ -733,29 +1456,17 @@ void FTurboSequence_Utility_Lf::AddAnimation(FSkinnedMeshRuntime_Lf& Runtime,
 		//Make the mask
 		FAnimationBlendLayerMask_Lf AnimationBlendLayerMask;
 		
-		GenerateAnimationLayerMask(Animation.Settings.MaskDefinition, AnimationBlendLayerMask.RawAnimationLayers, Runtime.DataAsset);
+		GenerateAnimationLayerMask(MaskDefinition, AnimationBlendLayerMask.RawAnimationLayers, DataAsset);
 		
 		Library.AnimationBlendLayerMasks.Add(BoneMaskBuiltProxyHandle,AnimationBlendLayerMask );
 		
 		Library.bMasksNeedRebuilding = true;
 	}
-	
-	if(!Library.AnimationLibraryData.Contains(Animation.AnimationLibraryHash))
-	{
-		FAnimationLibraryData_Lf Data = FAnimationLibraryData_Lf();
-		Data.NumBones = Runtime.DataAsset->GetNumCPUBones();
-		Library.AnimationLibraryData.Add(Animation.AnimationLibraryHash, Data);
-	}
 }
 
-void FTurboSequence_Utility_Lf::RemoveAnimation(FSkinnedMeshRuntime_Lf& Runtime,
-                                                FSkinnedMeshGlobalLibrary_Lf& Library,
-                                                const int32 Index)
+void FTurboSequence_Utility_Lf::ReleaseAnimationMask(FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                     const FBoneMaskBuiltProxyHandle& BoneMaskBuiltProxyHandle)
 {
-	const FAnimationMetaData_Lf& Animation = Runtime.AnimationMetaData[Index];
-
-	const FBoneMaskBuiltProxyHandle BoneMaskBuiltProxyHandle = Animation.Settings.MaskDefinition.GetBuiltProxyHandle(Runtime.DataAsset);
-
 	if(int* MaskRefCount = Library.MaskRefCount.Find(BoneMaskBuiltProxyHandle))
 	{
 		(*MaskRefCount)--;
@@ -769,9 +1480,6 @@ void FTurboSequence_Utility_Lf::RemoveAnimation(FSkinnedMeshRuntime_Lf& Runtime,
 			Library.bMasksNeedRebuilding = true;
 		}
 	}
-	
-
-	Runtime.AnimationMetaData.RemoveAt(Index);
 }
 
 bool FTurboSequence_Utility_Lf::RefreshBlendSpaceState(const TObjectPtr<UBlendSpace> BlendSpace,
@@ -1087,6 +1795,17 @@ bool FTurboSequence_Utility_Lf::TweakAnimation(FSkinnedMeshRuntime_Lf& Runtime,
 			AnimationFrame->AnimationWeightStartTime = Settings.StartTransitionTimeInSeconds;
 		}
 
+		// A tweaked mask moves the animation over to another built mask
+		const FBoneMaskBuiltProxyHandle MaskProxyHandle = Settings.MaskDefinition.GetBuiltProxyHandle(Runtime.DataAsset);
+		if (MaskProxyHandle != AnimationFrame->MaskProxyHandle)
+		{
+			AcquireAnimationMask(Library, MaskProxyHandle, Settings.MaskDefinition, Runtime.DataAsset);
+			ReleaseAnimationMask(Library, AnimationFrame->MaskProxyHandle);
+
+			AnimationFrame->MaskProxyHandle = MaskProxyHandle;
+			AnimationFrame->MaskLayerVersion = 0;
+		}
+
 		AnimationFrame->Settings = Settings;
 		
 		return true;
@@ -1110,9 +1829,171 @@ void FTurboSequence_Utility_Lf::SolveAnimations(FSkinnedMeshRuntime_Lf& Runtime,
 	}
 	
 	Runtime.LastFrameAnimationSolved = CurrentFrameCount;
+	Runtime.bBoneTextureDirty = true;
+
+	// The group timeline was solved once for all its meshes
+	if (Runtime.AnimationGroup.IsValid())
+	{
+		return;
+	}
 	
 	UpdateBlendSpaces(Runtime, DeltaTime, Library);
+
+	TArray<FBoneMaskBuiltProxyHandle> ReleasedMasks;
+	AdvanceAnimations(Runtime, DeltaTime, ReleasedMasks);
+
+	for (const FBoneMaskBuiltProxyHandle& ReleasedMask : ReleasedMasks)
+	{
+		ReleaseAnimationMask(Library, ReleasedMask);
+	}
+
+	ResolveAnimationsInLibrary(Runtime, Library);
+}
+
+bool FTurboSequence_Utility_Lf::SolveAnimations_Concurrent(FSkinnedMeshRuntime_Lf& Runtime,
+                                                           const FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                           const float DeltaTime, const int64 CurrentFrameCount,
+                                                           TArray<FBoneMaskBuiltProxyHandle>& OutReleasedMasks)
+{
+	if (CurrentFrameCount == Runtime.LastFrameAnimationSolved)
+	{
+		return false;
+	}
+
+	if(!Runtime.bAnimTickEnabled)
+	{
+		return false;
+	}
 	
+	Runtime.LastFrameAnimationSolved = CurrentFrameCount;
+	Runtime.bBoneTextureDirty = true;
+
+	if (Runtime.AnimationGroup.IsValid())
+	{
+		return false;
+	}
+
+	AdvanceAnimations(Runtime, DeltaTime, OutReleasedMasks);
+
+	// Same order as ResolveAnimationsInLibrary, the first miss defers the whole mesh to keep the library writes ordered
+	for (int32 AnimIdx = Runtime.AnimationMetaData.Num() - 1; AnimIdx >= 0; --AnimIdx)
+	{
+		FAnimationMetaData_Lf& Animation = Runtime.AnimationMetaData[AnimIdx];
+		if (!ResolveAnimationFromLibrary_Concurrent(Library, Animation.CPUAnimationIndex_0, Animation.GPUAnimationIndex_0,
+		                                            Animation.CPUAnimationIndex_1, Animation.GPUAnimationIndex_1,
+		                                            Animation.FrameAlpha, Runtime, Animation))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FTurboSequence_Utility_Lf::ResolveAnimationsInLibrary(FSkinnedMeshRuntime_Lf& Runtime,
+                                                           FSkinnedMeshGlobalLibrary_Lf& Library)
+{
+	for (int32 AnimIdx = Runtime.AnimationMetaData.Num() - 1; AnimIdx >= 0; --AnimIdx)
+	{
+		FAnimationMetaData_Lf& Animation = Runtime.AnimationMetaData[AnimIdx];
+
+		AddAnimationToLibraryChunked(Library, Animation.CPUAnimationIndex_0, Animation.GPUAnimationIndex_0,
+		                             Animation.CPUAnimationIndex_1, Animation.GPUAnimationIndex_1, Animation.FrameAlpha, Runtime, Animation);
+	}
+}
+
+void FTurboSequence_Utility_Lf::ResolveAnimationGroupPhase(FSkinnedMeshAnimationGroup_Lf& Group,
+                                                           FSkinnedMeshAnimationGroupPhase_Lf& Phase,
+                                                           FSkinnedMeshGlobalLibrary_Lf& Library)
+{
+	Phase.AnimationMetaData = Group.Timeline.AnimationMetaData;
+
+	for (int32 AnimIdx = Phase.AnimationMetaData.Num() - 1; AnimIdx >= 0; --AnimIdx)
+	{
+		FAnimationMetaData_Lf& Animation = Phase.AnimationMetaData[AnimIdx];
+
+		// A keyframe step is 1 / (MaxFrames - 1) in normalized time, see AnimationCodecTimeToIndex
+		const FAnimationLibraryData_Lf* LibraryAnimData = Library.AnimationLibraryData.Find(Animation.AnimationLibraryHash);
+		if (LibraryAnimData && LibraryAnimData->MaxFrames > 1 && IsValid(Animation.Animation))
+		{
+			const float PhaseTime = Animation.AnimationNormalizedTime +
+				static_cast<float>(Phase.PhaseOffset) / static_cast<float>(LibraryAnimData->MaxFrames - 1);
+			Animation.AnimationNormalizedTime = Animation.bIsLoop ? FMath::Frac(PhaseTime) : FMath::Clamp(PhaseTime, 0.0f, 1.0f);
+		}
+
+		AddAnimationToLibraryChunked(Library, Animation.CPUAnimationIndex_0, Animation.GPUAnimationIndex_0,
+		                             Animation.CPUAnimationIndex_1, Animation.GPUAnimationIndex_1, Animation.FrameAlpha,
+		                             Group.Timeline, Animation);
+	}
+}
+
+bool FTurboSequence_Utility_Lf::ResolveAnimationFromLibrary_Concurrent(const FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                                       int32& CPUIndex0,
+                                                                       int32& GPUIndex0,
+                                                                       int32& CPUIndex1, int32& GPUIndex1,
+                                                                       float& FrameAlpha,
+                                                                       const FSkinnedMeshRuntime_Lf& Runtime,
+                                                                       const FAnimationMetaData_Lf& Animation)
+{
+	// Mirrors AddAnimationToLibraryChunked, but bails out wherever it would write into the library
+	CPUIndex0 = 0;
+	CPUIndex1 = 0;
+	GPUIndex0 = 0;
+	GPUIndex1 = 0;
+	FrameAlpha = 0;
+
+	const FAnimationLibraryData_Lf* LibraryAnimData = Library.AnimationLibraryData.Find(Animation.AnimationLibraryHash);
+	if (!LibraryAnimData)
+	{
+		return false;
+	}
+
+	if (IsValid(Animation.Animation))
+	{
+		if (!LibraryAnimData->KeyframesFilled.Num())
+		{
+			return false;
+		}
+
+		FrameAlpha = AnimationCodecTimeToIndex(Animation.AnimationNormalizedTime, LibraryAnimData->MaxFrames,
+			Animation.Animation->Interpolation, CPUIndex0, CPUIndex1);
+
+		if (!(LibraryAnimData->KeyframesFilled.IsValidIndex(CPUIndex0) && LibraryAnimData->KeyframesFilled.IsValidIndex(CPUIndex1)))
+		{
+			return true;
+		}
+
+		if (!LibraryAnimData->bHasPoseData)
+		{
+			return false;
+		}
+
+		GPUIndex0 = LibraryAnimData->KeyframesFilled[CPUIndex0];
+		GPUIndex1 = LibraryAnimData->KeyframesFilled[CPUIndex1];
+
+		// Upcoming keyframes get their samples requested in the serial pass
+		TArray<int32, TInlineAllocator<8>> KeyframesToPrefetch;
+		if (Library.PendingKeyframeSamples.Num() < Library.MaxPendingKeyframeSamples)
+		{
+			GetKeyframesToPrefetch(KeyframesToPrefetch, Library, *LibraryAnimData, Runtime, Animation, CPUIndex0, CPUIndex1);
+		}
+
+		return GPUIndex0 > INDEX_NONE && GPUIndex1 > INDEX_NONE && !KeyframesToPrefetch.Num();
+	}
+
+	// Is Rest Pose
+	if (LibraryAnimData->KeyframesFilled.Num() && LibraryAnimData->KeyframesFilled[0] > INDEX_NONE)
+	{
+		GPUIndex0 = GPUIndex1 = LibraryAnimData->KeyframesFilled[0];
+		return true;
+	}
+
+	return false;
+}
+
+void FTurboSequence_Utility_Lf::AdvanceAnimations(FSkinnedMeshRuntime_Lf& Runtime, const float DeltaTime,
+                                                  TArray<FBoneMaskBuiltProxyHandle>& OutReleasedMasks)
+{
 	//We use bone masks to define the groups, then we scale the blend weight by the groups?
 	// < Animation Group Layer Hash | Animation Group >
 	TMap<FBoneMaskSourceHandle, float> AnimationGroupWeight;
@@ -1180,66 +2061,268 @@ void FTurboSequence_Utility_Lf::SolveAnimations(FSkinnedMeshRuntime_Lf& Runtime,
 
 				if (FMath::IsNearlyZero(AnimationWeight))
 				{
-					RemoveAnimation(Runtime, Library, AnimIdx); //Reverse loop so ok to remove
+					OutReleasedMasks.Add(Animation.MaskProxyHandle);
+					Runtime.AnimationMetaData.RemoveAt(AnimIdx); //Reverse loop so ok to remove
 					continue; 
 				}
 			}
 
-			// Weight
-			Animation.FinalAnimationWeight = FMath::Min(AnimationWeight, Animation.Settings.AnimationWeight);
+			// Weight
+			Animation.FinalAnimationWeight = FMath::Min(AnimationWeight, Animation.Settings.AnimationWeight);
+
+			if (Animation.Settings.bNormalizeWeightInGroup)
+			{
+				float& GroupWeight = AnimationGroupWeight.FindOrAdd(Animation.AnimationGroupLayerHash, 0.0f);
+				GroupWeight += Animation.FinalAnimationWeight;
+			}
+		}
+		else
+        {
+        	Animation.AnimationTime = 0;
+        	Animation.AnimationNormalizedTime = 0;
+        }
+	}
+	
+	float BaseLayerWeight = 1;
+	for (int32 AnimIdx = Runtime.AnimationMetaData.Num() - 1; AnimIdx >= 0; --AnimIdx)
+	{
+		FAnimationMetaData_Lf& Animation = Runtime.AnimationMetaData[AnimIdx];
+		if (Animation.Settings.bNormalizeWeightInGroup)
+		{
+			if (AnimIdx)
+			{
+				const float TotalAnimWeightRuntime = AnimationGroupWeight[Animation.AnimationGroupLayerHash];
+				
+				Animation.FinalAnimationWeight /= TotalAnimWeightRuntime;
+				Animation.FinalAnimationWeight = FMath::Min(Animation.FinalAnimationWeight,
+				                                            Animation.Settings.AnimationWeight);
+				BaseLayerWeight -= Animation.FinalAnimationWeight;
+			}
+			else
+			{
+				Animation.FinalAnimationWeight = FTurboSequence_Helper_Lf::Clamp01(BaseLayerWeight);
+			}
+		}
+	}
+}
+
+
+void FTurboSequence_Utility_Lf::BuildNotifyTimeline(FAnimationLibraryData_Lf& LibraryAnimData, const UAnimSequence* Animation)
+{
+	LibraryAnimData.NotifyTimeline.Reset();
+	LibraryAnimData.NotifyStateTimeline.Reset();
+
+	for (int32 NotifyIndex = 0; NotifyIndex < Animation->Notifies.Num(); ++NotifyIndex)
+	{
+		const FAnimNotifyEvent& Notify = Animation->Notifies[NotifyIndex];
+
+		FAnimationNotifyTimelineEntry_Lf Entry;
+		Entry.TriggerTime = Notify.GetTriggerTime();
+		Entry.EndTriggerTime = Notify.GetEndTriggerTime();
+		Entry.NotifyIndex = NotifyIndex;
+
+		if (Notify.NotifyStateClass)
+		{
+			LibraryAnimData.NotifyStateTimeline.Add(Entry);
+		}
+		else
+		{
+			LibraryAnimData.NotifyTimeline.Add(Entry);
+		}
+	}
+
+	Algo::SortBy(LibraryAnimData.NotifyTimeline, &FAnimationNotifyTimelineEntry_Lf::TriggerTime);
+}
+
+// A time on the group timeline shifted like ResolveAnimationGroupPhase, unchanged for meshes without a phase
+static float GetPhaseShiftedTime_Lf(const float Time, const FAnimationMetaData_Lf& Animation,
+                                    const FAnimationLibraryData_Lf& LibraryAnimData, const int32 PhaseOffset)
+{
+	if (!PhaseOffset || LibraryAnimData.MaxFrames <= 1)
+	{
+		return Time;
+	}
+
+	// A keyframe step in seconds
+	const float PlayLength = Animation.AnimationMaxPlayLength;
+	const float PhaseTime = static_cast<float>(PhaseOffset) / static_cast<float>(LibraryAnimData.MaxFrames - 1) * PlayLength;
+	return Animation.bIsLoop ? FMath::Fmod(Time + PhaseTime, PlayLength) : FMath::Clamp(Time + PhaseTime, 0.0f, PlayLength);
+}
+
+// The times an animation advanced between in its last solve, shifted like ResolveAnimationGroupPhase for meshes of a group
+static void GetAdvancedTimeRange_Lf(float& OutPreviousTime, float& OutCurrentTime, const FAnimationMetaData_Lf& Animation,
+                                    const FAnimationLibraryData_Lf& LibraryAnimData, const int32 PhaseOffset)
+{
+	OutPreviousTime = GetPhaseShiftedTime_Lf(Animation.LastAnimationTime, Animation, LibraryAnimData, PhaseOffset);
+	OutCurrentTime = GetPhaseShiftedTime_Lf(Animation.AnimationTime, Animation, LibraryAnimData, PhaseOffset);
+}
+
+// Notifies in the time range ( StartTime, EndTime ], notify states when their window overlaps it
+static void FindTimelineNotifies_Lf(TArray<const FAnimNotifyEvent*, TInlineAllocator<8>>& OutNotifies,
+                                    const FAnimationLibraryData_Lf& LibraryAnimData, const UAnimSequence* Animation,
+                                    const float StartTime, const float EndTime)
+{
+	const TArray<FAnimationNotifyTimelineEntry_Lf>& Timeline = LibraryAnimData.NotifyTimeline;
+	for (int32 EntryIndex = Algo::UpperBoundBy(Timeline, StartTime, &FAnimationNotifyTimelineEntry_Lf::TriggerTime);
+	     EntryIndex < Timeline.Num() && Timeline[EntryIndex].TriggerTime <= EndTime; ++EntryIndex)
+	{
+		OutNotifies.Add(&Animation->Notifies[Timeline[EntryIndex].NotifyIndex]);
+	}
+
+	for (const FAnimationNotifyTimelineEntry_Lf& Entry : LibraryAnimData.NotifyStateTimeline)
+	{
+		if (Entry.TriggerTime <= EndTime && Entry.EndTriggerTime > StartTime)
+		{
+			OutNotifies.AddUnique(&Animation->Notifies[Entry.NotifyIndex]);
+		}
+	}
+}
+
+void FTurboSequence_Utility_Lf::GetAnimationNotifies(TArray<const FAnimNotifyEvent*, TInlineAllocator<8>>& OutNotifies,
+                                                     const FAnimationMetaData_Lf& Animation,
+                                                     const FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                     const int32 PhaseOffset)
+{
+	if (!IsValid(Animation.Animation))
+	{
+		return;
+	}
+
+	const FAnimationLibraryData_Lf* LibraryAnimData = Library.AnimationLibraryData.Find(Animation.AnimationLibraryHash);
+	if (!LibraryAnimData || (!LibraryAnimData->NotifyTimeline.Num() && !LibraryAnimData->NotifyStateTimeline.Num()))
+	{
+		return;
+	}
+
+	float PreviousTime, CurrentTime;
+	GetAdvancedTimeRange_Lf(PreviousTime, CurrentTime, Animation, *LibraryAnimData, PhaseOffset);
+
+	if (PreviousTime == CurrentTime)
+	{
+		return;
+	}
+
+	// The animation time of loops is wrapped, a step against the play direction went over an end like in GetSolvedRootMotion
+	const float PlayLength = Animation.AnimationMaxPlayLength;
+	const bool bPlaysForward = Animation.Settings.AnimationSpeed >= 0;
+	if (Animation.bIsLoop && bPlaysForward && CurrentTime < PreviousTime)
+	{
+		// Wrapped around the end, the start of the animation is part of the range again
+		FindTimelineNotifies_Lf(OutNotifies, *LibraryAnimData, Animation.Animation, PreviousTime, PlayLength);
+		FindTimelineNotifies_Lf(OutNotifies, *LibraryAnimData, Animation.Animation, -UE_KINDA_SMALL_NUMBER, CurrentTime);
+	}
+	else if (Animation.bIsLoop && !bPlaysForward && CurrentTime > PreviousTime)
+	{
+		// Wrapped around the start playing backwards, the end of the animation is part of the range again
+		FindTimelineNotifies_Lf(OutNotifies, *LibraryAnimData, Animation.Animation, -UE_KINDA_SMALL_NUMBER, PreviousTime);
+		FindTimelineNotifies_Lf(OutNotifies, *LibraryAnimData, Animation.Animation, CurrentTime, PlayLength);
+	}
+	else if (CurrentTime > PreviousTime)
+	{
+		FindTimelineNotifies_Lf(OutNotifies, *LibraryAnimData, Animation.Animation, PreviousTime, CurrentTime);
+	}
+	else
+	{
+		FindTimelineNotifies_Lf(OutNotifies, *LibraryAnimData, Animation.Animation, CurrentTime, PreviousTime);
+	}
+}
+
+// The animations a mesh played in its last solve. Meshes of an animation group play the timeline of the group,
+// their phase resolved the keyframes into its own animations while the times stay on the timeline, shifted by PhaseOffset
+struct FAnimationSource_Lf
+{
+	const FSkinnedMeshRuntime_Lf& Runtime;
+	const TArray<FAnimationMetaData_Lf>& AnimationMetaData;
+	int32 PhaseOffset;
+};
 
-			if (Animation.Settings.bNormalizeWeightInGroup)
-			{
-				float& GroupWeight = AnimationGroupWeight.FindOrAdd(Animation.AnimationGroupLayerHash, 0.0f);
-				GroupWeight += Animation.FinalAnimationWeight;
-			}
+static FAnimationSource_Lf GetAnimationSource_Lf(const FSkinnedMeshRuntime_Lf& Runtime,
+                                                 const FSkinnedMeshGlobalLibrary_Lf& Library)
+{
+	if (Runtime.AnimationGroup.IsValid())
+	{
+		if (const FSkinnedMeshAnimationGroup_Lf* Group = Library.AnimationGroups.Find(Runtime.AnimationGroup))
+		{
+			// The phase without offset reads the timeline itself
+			const FSkinnedMeshAnimationGroupPhase_Lf* Phase = Runtime.AnimationGroupPhaseOffset
+				                                                  ? Group->Phases.FindByPredicate(
+					                                                  [&Runtime](const FSkinnedMeshAnimationGroupPhase_Lf& GroupPhase)
+					                                                  {
+						                                                  return GroupPhase.PhaseOffset == Runtime.AnimationGroupPhaseOffset;
+					                                                  })
+				                                                  : nullptr;
+			return {Group->Timeline, Phase ? Phase->AnimationMetaData : Group->Timeline.AnimationMetaData,
+			        Runtime.AnimationGroupPhaseOffset};
 		}
-		else
-        {
-        	Animation.AnimationTime = 0;
-        	Animation.AnimationNormalizedTime = 0;
-        }
-		
-		AddAnimationToLibraryChunked(Library, Animation.CPUAnimationIndex_0, Animation.GPUAnimationIndex_0,
-		                             Animation.CPUAnimationIndex_1, Animation.GPUAnimationIndex_1, Animation.FrameAlpha, Runtime, Animation);
 	}
-	
-	float BaseLayerWeight = 1;
-	for (int32 AnimIdx = Runtime.AnimationMetaData.Num() - 1; AnimIdx >= 0; --AnimIdx)
+	return {Runtime, Runtime.AnimationMetaData, 0};
+}
+
+void FTurboSequence_Utility_Lf::GetAnimNotifies(const FSkinnedMeshRuntime_Lf& Runtime,
+                                                const FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                FTurboSequence_AnimNotifyQueue_Lf& NotifyQueue)
+{
+	const FAnimationSource_Lf AnimationSource = GetAnimationSource_Lf(Runtime, Library);
+
+	TArray<const FAnimNotifyEvent*, TInlineAllocator<8>> Notifies;
+	TArray<FAnimNotifyEventReference> NotifyReferences;
+	for (int32 AnimIdx = AnimationSource.AnimationMetaData.Num() - 1; AnimIdx >= 0; --AnimIdx)
 	{
-		FAnimationMetaData_Lf& Animation = Runtime.AnimationMetaData[AnimIdx];
-		if (Animation.Settings.bNormalizeWeightInGroup)
+		const FAnimationMetaData_Lf& Animation = AnimationSource.AnimationMetaData[AnimIdx];
+
+		Notifies.Reset();
+		GetAnimationNotifies(Notifies, Animation, Library, AnimationSource.PhaseOffset);
+		if (!Notifies.Num())
 		{
-			if (AnimIdx)
-			{
-				const float TotalAnimWeightRuntime = AnimationGroupWeight[Animation.AnimationGroupLayerHash];
-				
-				Animation.FinalAnimationWeight /= TotalAnimWeightRuntime;
-				Animation.FinalAnimationWeight = FMath::Min(Animation.FinalAnimationWeight,
-				                                            Animation.Settings.AnimationWeight);
-				BaseLayerWeight -= Animation.FinalAnimationWeight;
-			}
-			else
-			{
-				Animation.FinalAnimationWeight = FTurboSequence_Helper_Lf::Clamp01(BaseLayerWeight);
-			}
+			continue;
+		}
+
+		NotifyReferences.Reset();
+		for (const FAnimNotifyEvent* Notify : Notifies)
+		{
+			NotifyReferences.Add(FAnimNotifyEventReference(Notify, Animation.Animation));
 		}
+		NotifyQueue.AddAnimNotifies(NotifyReferences, Animation.FinalAnimationWeight);
 	}
 }
 
-
-void FTurboSequence_Utility_Lf::GetAnimNotifies(const FSkinnedMeshRuntime_Lf& Runtime, FTurboSequence_AnimNotifyQueue_Lf& NotifyQueue)
+void FTurboSequence_Utility_Lf::CollectAnimNotifies(TArray<FTurboSequence_AnimNotifyEvent_Lf>& OutEvents,
+                                                    const FSkinnedMeshRuntime_Lf& Runtime,
+                                                    const FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                    const int64 CurrentFrameCount, FRandomStream& RandomStream)
 {
-	static FAnimNotifyContext NotifyContext;
-	
-	for (int32 AnimIdx = Runtime.AnimationMetaData.Num() - 1; AnimIdx >= 0; --AnimIdx)
+	const FAnimationSource_Lf AnimationSource = GetAnimationSource_Lf(Runtime, Library);
+	if (AnimationSource.Runtime.LastFrameAnimationSolved != CurrentFrameCount)
+	{
+		return;
+	}
+
+	const bool bIsDedicatedServer = IsRunningDedicatedServer();
+
+	TArray<const FAnimNotifyEvent*, TInlineAllocator<8>> Notifies;
+	for (int32 AnimIdx = AnimationSource.AnimationMetaData.Num() - 1; AnimIdx >= 0; --AnimIdx)
 	{
-		const FAnimationMetaData_Lf& Animation = Runtime.AnimationMetaData[AnimIdx];
-		if (Animation.Animation)
+		const FAnimationMetaData_Lf& Animation = AnimationSource.AnimationMetaData[AnimIdx];
+
+		Notifies.Reset();
+		GetAnimationNotifies(Notifies, Animation, Library, AnimationSource.PhaseOffset);
+
+		for (const FAnimNotifyEvent* Notify : Notifies)
 		{
-			Animation.Animation->GetAnimNotifiesFromDeltaPositions(Animation.LastAnimationTime, Animation.AnimationTime, NotifyContext);
-			NotifyQueue.AddAnimNotifies(NotifyContext.ActiveNotifies, Animation.FinalAnimationWeight);
-			NotifyContext.ActiveNotifies.Reset();
+			// Same filter as FTurboSequence_AnimNotifyQueue_Lf::AddAnimNotifiesToDest
+			if ((bIsDedicatedServer && !Notify->bTriggerOnDedicatedServer) ||
+				Notify->TriggerWeightThreshold > Animation.FinalAnimationWeight ||
+				(!Notify->NotifyStateClass && RandomStream.FRandRange(0.f, 1.f) >= Notify->NotifyTriggerChance))
+			{
+				continue;
+			}
+
+			FTurboSequence_AnimNotifyEvent_Lf& Event = OutEvents.AddDefaulted_GetRef();
+			Event.MeshID = Runtime.MeshID;
+			Event.Animation = Animation.Animation;
+			Event.NotifyName = Notify->NotifyName;
+			Event.Weight = Animation.FinalAnimationWeight;
+			Event.Notify = Notify;
 		}
 	}
 }
@@ -1367,6 +2450,19 @@ void FTurboSequence_Utility_Lf::GetBoneTransformFromAnimationSafe(FMatrix& OutAt
 			// OutAtom.M[3][2] = CurrentRow2.W;
 			// OutAtom.M[3][3] = 1;
 		}
+		else if (const FTurboSequence_BakedAnimation_Lf* BakedAnimation = LibraryData.GetBakedAnimation();
+			BakedAnimation && BakedAnimation->Keyframes.IsValidIndex((FrameIndex * BakedAnimation->NumBones + SkeletonBoneIndex) * 3 + 2))
+		{
+			const int32 KeyframeIndex = (FrameIndex * BakedAnimation->NumBones + SkeletonBoneIndex) * 3;
+			for (uint8 M = 0; M < 3; ++M)
+			{
+				const FVector4f& Colum = BakedAnimation->Keyframes[KeyframeIndex + M];
+				OutAtom.M[0][M] = Colum.X;
+				OutAtom.M[1][M] = Colum.Y;
+				OutAtom.M[2][M] = Colum.Z;
+				OutAtom.M[3][M] = Colum.W;
+			}
+		}
 		else
 		{
 			OutAtom = FMatrix::Identity;
@@ -1426,22 +2522,85 @@ void FTurboSequence_Utility_Lf::PrintAnimsToScreen(const FSkinnedMeshRuntime_Lf&
 
 }
 
+void FTurboSequence_Utility_Lf::DecomposeKeyframeBone(FAnimationLibraryData_Lf& LibraryAnimData, const int32 CPUIndex,
+                                                      const uint16 BoneIndex, const FVector4f* Colums)
+{
+	if (LibraryAnimData.KeyframesDecomposed.Num() != LibraryAnimData.MaxFrames)
+	{
+		const int32 NumKeyframeBones = LibraryAnimData.MaxFrames * LibraryAnimData.NumBones;
+		LibraryAnimData.KeyframeRotations.SetNumUninitialized(NumKeyframeBones);
+		LibraryAnimData.KeyframeTranslations.SetNumUninitialized(NumKeyframeBones);
+		LibraryAnimData.KeyframeScales.SetNumUninitialized(NumKeyframeBones);
+		LibraryAnimData.KeyframesDecomposed.Init(false, LibraryAnimData.MaxFrames);
+	}
+
+	FMatrix BoneMatrix = FMatrix::Identity;
+	for (uint8 M = 0; M < 3; ++M)
+	{
+		BoneMatrix.M[0][M] = Colums[M].X;
+		BoneMatrix.M[1][M] = Colums[M].Y;
+		BoneMatrix.M[2][M] = Colums[M].Z;
+		BoneMatrix.M[3][M] = Colums[M].W;
+	}
+	const FTransform BoneTransform(BoneMatrix);
+
+	const int32 KeyframeBoneIndex = CPUIndex * LibraryAnimData.NumBones + BoneIndex;
+	LibraryAnimData.KeyframeRotations[KeyframeBoneIndex] = FQuat4f(BoneTransform.GetRotation());
+	LibraryAnimData.KeyframeTranslations[KeyframeBoneIndex] = FVector3f(BoneTransform.GetTranslation());
+	LibraryAnimData.KeyframeScales[KeyframeBoneIndex] = FVector3f(BoneTransform.GetScale3D());
+}
+
+// Loads a keyframe bone for the blend, from the decomposed keyframes when the keyframe was written to the library
+static void LoadKeyframeBone_Lf(VectorRegister4Float& OutRotation, VectorRegister4Float& OutTranslation,
+                                VectorRegister4Float& OutScale, const FAnimationMetaData_Lf& Animation,
+                                const int32 FrameIndex, const uint16 BoneIndex,
+                                const FSkinnedMeshGlobalLibrary_Lf& Library, const FReferenceSkeleton& ReferenceSkeleton)
+{
+	if (IsValid(Animation.Animation))
+	{
+		const FAnimationLibraryData_Lf& LibraryData = Library.AnimationLibraryData[Animation.AnimationLibraryHash];
+		if (LibraryData.KeyframesDecomposed.IsValidIndex(FrameIndex) && LibraryData.KeyframesDecomposed[FrameIndex] &&
+			BoneIndex < LibraryData.NumBones)
+		{
+			const int32 KeyframeBoneIndex = FrameIndex * LibraryData.NumBones + BoneIndex;
+			OutRotation = VectorLoad(&LibraryData.KeyframeRotations[KeyframeBoneIndex].X);
+			OutTranslation = VectorLoadFloat3(&LibraryData.KeyframeTranslations[KeyframeBoneIndex].X);
+			OutScale = VectorLoadFloat3(&LibraryData.KeyframeScales[KeyframeBoneIndex].X);
+			return;
+		}
+	}
+
+	FMatrix BoneSpaceAtom = FMatrix::Identity;
+	// Since we get the data directly from the GPU Collection Data we can likely ignore the root state,
+	// the correct root bone data already baked into the collection .
+	FTurboSequence_Utility_Lf::GetBoneTransformFromAnimationSafe(BoneSpaceAtom, Animation, FrameIndex, BoneIndex,
+	                                                             Library, ReferenceSkeleton);
+	const FTransform Atom(BoneSpaceAtom);
+
+	const FQuat4f Rotation(Atom.GetRotation());
+	const FVector3f Translation(Atom.GetTranslation());
+	const FVector3f Scale(Atom.GetScale3D());
+	OutRotation = VectorLoad(&Rotation.X);
+	OutTranslation = VectorLoadFloat3(&Translation.X);
+	OutScale = VectorLoadFloat3(&Scale.X);
+}
+
 FTransform FTurboSequence_Utility_Lf::BendBoneFromAnimations(const int32 BoneIndex, const FSkinnedMeshRuntime_Lf& Runtime,
                                                              const FSkinnedMeshGlobalLibrary_Lf& Library)
 {
 	const FReferenceSkeleton& ReferenceSkeleton = GetReferenceSkeleton(Runtime.DataAsset);
 
-	FTransform OutAtom;
+	VectorRegister4Float AccumulatedRotation = VectorZeroFloat();
+	VectorRegister4Float AccumulatedTranslation = VectorZeroFloat();
+	VectorRegister4Float AccumulatedScale = VectorZeroFloat();
 	bool bFoundFirstAnimation = false;
 	float CumulativeAppliedWeight = 0.f;
 
-	for (const FAnimationMetaData_Lf& Animation : Runtime.AnimationMetaData) 
+	for (const FAnimationMetaData_Lf& Animation : GetAnimationSource_Lf(Runtime, Library).AnimationMetaData)
 	{
 		float Weight = Animation.FinalAnimationWeight;
 
-		FBoneMaskBuiltProxyHandle BoneMaskBuiltProxyHandle = Animation.Settings.MaskDefinition.GetBuiltProxyHandle(Runtime.DataAsset);
-
-		if (const FAnimationBlendLayerMask_Lf* AnimationBlendLayerMask_Lf = Library.AnimationBlendLayerMasks.Find(BoneMaskBuiltProxyHandle))
+		if (const FAnimationBlendLayerMask_Lf* AnimationBlendLayerMask_Lf = Library.AnimationBlendLayerMasks.Find(Animation.MaskProxyHandle))
 		{
 			if(AnimationBlendLayerMask_Lf->RawAnimationLayers.IsValidIndex(BoneIndex))
 			{
@@ -1462,40 +2621,38 @@ FTransform FTurboSequence_Utility_Lf::BendBoneFromAnimations(const int32 BoneInd
 			continue;
 		}
 		
-		FMatrix BoneSpaceAtom0 = FMatrix::Identity;
-		FMatrix BoneSpaceAtom1 = FMatrix::Identity;
-
-		// Since we get the data directly from the GPU Collection Data we can likely ignore the root state,
-		// the correct root bone data already baked into the collection .
-		GetBoneTransformFromAnimationSafe(BoneSpaceAtom0, Animation, Animation.CPUAnimationIndex_0, BoneIndex, Library,
-		                                  ReferenceSkeleton);
-
-		GetBoneTransformFromAnimationSafe(BoneSpaceAtom1, Animation, Animation.CPUAnimationIndex_1, BoneIndex, Library,
-		                                  ReferenceSkeleton);
-
-		const FTransform& Atom0 = FTransform(BoneSpaceAtom0);
-		const FTransform& Atom1 = FTransform(BoneSpaceAtom1);
-		
-		FVector ScaleInterpolated = FMath::Lerp(Atom0.GetScale3D(), Atom1.GetScale3D(),Animation.FrameAlpha );
-		FVector TranslationInterpolated = FMath::Lerp(Atom0.GetTranslation(), Atom1.GetTranslation(), Animation.FrameAlpha);
-		FQuat RotationInterpolated = FQuat::Slerp(Atom0.GetRotation(), Atom1.GetRotation(),Animation.FrameAlpha);
+		VectorRegister4Float Rotation0, Translation0, Scale0;
+		VectorRegister4Float Rotation1, Translation1, Scale1;
+		LoadKeyframeBone_Lf(Rotation0, Translation0, Scale0, Animation, Animation.CPUAnimationIndex_0, BoneIndex, Library,
+		                    ReferenceSkeleton);
+		LoadKeyframeBone_Lf(Rotation1, Translation1, Scale1, Animation, Animation.CPUAnimationIndex_1, BoneIndex, Library,
+		                    ReferenceSkeleton);
+
+		const VectorRegister4Float FrameAlpha = VectorSetFloat1(Animation.FrameAlpha);
+		const VectorRegister4Float BlendWeight = VectorSetFloat1(Weight);
+
+		const VectorRegister4Float ScaleInterpolated = VectorMultiplyAdd(VectorSubtract(Scale1, Scale0), FrameAlpha, Scale0);
+		const VectorRegister4Float TranslationInterpolated = VectorMultiplyAdd(
+			VectorSubtract(Translation1, Translation0), FrameAlpha, Translation0);
+		// The keyframes are close in time, the normalized lerp along the shortest path stays close to the slerp
+		const VectorRegister4Float RotationInterpolated = VectorNormalizeQuaternion(
+			VectorLerpQuat(Rotation0, Rotation1, FrameAlpha));
 
 		//NB AccumulateWithShortestRotation
 		
 		if (!bFoundFirstAnimation)
 		{
 			bFoundFirstAnimation = true;
-			OutAtom.SetScale3D(ScaleInterpolated * Weight);
-			OutAtom.SetTranslation(TranslationInterpolated * Weight);
-			OutAtom.SetRotation(RotationInterpolated * Weight);
+			AccumulatedScale = VectorMultiply(ScaleInterpolated, BlendWeight);
+			AccumulatedTranslation = VectorMultiply(TranslationInterpolated, BlendWeight);
+			AccumulatedRotation = VectorMultiply(RotationInterpolated, BlendWeight);
 		}
 		else
 		{
-			OutAtom.SetScale3D(OutAtom.GetScale3D() + ScaleInterpolated * Weight);
-			OutAtom.SetTranslation(OutAtom.GetTranslation() + TranslationInterpolated * Weight);
-			OutAtom.SetRotation(FTurboSequence_Helper_Lf::Scale_Quaternion(
-				OutAtom.GetRotation(), RotationInterpolated,
-				Weight).GetNormalized());
+			AccumulatedScale = VectorMultiplyAdd(ScaleInterpolated, BlendWeight, AccumulatedScale);
+			AccumulatedTranslation = VectorMultiplyAdd(TranslationInterpolated, BlendWeight, AccumulatedTranslation);
+			AccumulatedRotation = VectorNormalizeQuaternion(VectorAccumulateQuaternionShortestPath(
+				AccumulatedRotation, VectorMultiply(RotationInterpolated, BlendWeight)));
 		}
 	}
 
@@ -1503,25 +2660,102 @@ FTransform FTurboSequence_Utility_Lf::BendBoneFromAnimations(const int32 BoneInd
 	{
 		return FTransform::Identity;
 	}
-	
-	OutAtom.NormalizeRotation();
-	return OutAtom;
+
+	FQuat4f Rotation;
+	FVector3f Translation;
+	FVector3f Scale;
+	VectorStore(VectorNormalizeQuaternion(AccumulatedRotation), &Rotation.X);
+	VectorStoreFloat3(AccumulatedTranslation, &Translation.X);
+	VectorStoreFloat3(AccumulatedScale, &Scale.X);
+
+	return FTransform(FQuat(Rotation), FVector(Translation), FVector(Scale));
+}
+
+void FTurboSequence_Utility_Lf::BakeRootMotionTrack(FAnimationLibraryData_Lf& LibraryAnimData, const UAnimSequence* Animation)
+{
+	LibraryAnimData.RootMotionTrack.Reset();
+	if (!Animation->HasRootMotion() || LibraryAnimData.MaxFrames < 2)
+	{
+		return;
+	}
+
+	// Decompresses the root track once, extracting a range afterwards only blends two cached keyframes
+	LibraryAnimData.RootMotionTrack.SetNumUninitialized(LibraryAnimData.MaxFrames);
+	for (int32 CPUIndex = 0; CPUIndex < LibraryAnimData.MaxFrames; ++CPUIndex)
+	{
+		LibraryAnimData.RootMotionTrack[CPUIndex] = Animation->ExtractRootMotionFromRange(
+			0, GetAnimationLibraryFrameTime(CPUIndex, LibraryAnimData.MaxFrames, Animation));
+	}
+}
+
+// Root motion from the start of the animation up to Time, blended between the cached keyframes
+static FTransform SampleRootMotionTrack_Lf(const TArray<FTransform>& Track, const float Time, const float PlayLength)
+{
+	const float Frame = FMath::Clamp(Time / PlayLength, 0.0f, 1.0f) * static_cast<float>(Track.Num() - 1);
+	const int32 Frame0 = FMath::Min(FMath::FloorToInt32(Frame), Track.Num() - 1);
+	const int32 Frame1 = FMath::Min(Frame0 + 1, Track.Num() - 1);
+
+	FTransform RootMotion;
+	RootMotion.Blend(Track[Frame0], Track[Frame1], Frame - static_cast<float>(Frame0));
+	return RootMotion;
+}
+
+// Root motion played from StartTime to EndTime, a looping animation may run past either end once
+static FTransform ExtractCachedRootMotion_Lf(const TArray<FTransform>& Track, const float StartTime, const float EndTime,
+                                             const float PlayLength, const bool bIsLoop)
+{
+	const FTransform StartRootMotion = SampleRootMotionTrack_Lf(Track, StartTime, PlayLength);
+	if (!bIsLoop || (EndTime >= 0 && EndTime <= PlayLength))
+	{
+		return SampleRootMotionTrack_Lf(Track, EndTime, PlayLength).GetRelativeTransform(StartRootMotion);
+	}
+
+	// Played up to one end and continued from the other, accumulated like FRootMotionMovementParams does
+	const bool bForward = EndTime > PlayLength;
+	const float WrapTime = bForward ? PlayLength : 0;
+	const float ContinueTime = bForward ? 0 : PlayLength;
+	const float WrappedEndTime = bForward ? EndTime - PlayLength : EndTime + PlayLength;
+
+	const FTransform BeforeWrap = SampleRootMotionTrack_Lf(Track, WrapTime, PlayLength).GetRelativeTransform(StartRootMotion);
+	const FTransform AfterWrap = SampleRootMotionTrack_Lf(Track, WrappedEndTime, PlayLength).GetRelativeTransform(
+		SampleRootMotionTrack_Lf(Track, ContinueTime, PlayLength));
+	return AfterWrap * BeforeWrap;
+}
+
+static bool PlaysRootMotion_Lf(const FAnimationMetaData_Lf& Animation)
+{
+	const ETurboSequence_RootMotionMode_Lf Mode = Animation.Settings.RootMotionMode;
+	return IsValid(Animation.Animation) && Animation.Animation->HasRootMotion() &&
+		(Mode == ETurboSequence_RootMotionMode_Lf::Force ||
+			(Mode == ETurboSequence_RootMotionMode_Lf::OnRootBoneAnimated && Animation.bIsRootBoneAnimation));
 }
 
 void FTurboSequence_Utility_Lf::ExtractRootMotionFromAnimations(FTransform& OutAtom,
                                                                 const FSkinnedMeshRuntime_Lf& Runtime,
+                                                                const FSkinnedMeshGlobalLibrary_Lf& Library,
                                                                 float DeltaTime)
 {
+	// Meshes of a group move with the group timeline at their phase, like GetSolvedRootMotion
+	const FAnimationSource_Lf AnimationSource = GetAnimationSource_Lf(Runtime, Library);
+
 	FMatrix OutputTransform = FMatrix::Identity;
-	for (const FAnimationMetaData_Lf& Animation : Runtime.AnimationMetaData)
+	for (const FAnimationMetaData_Lf& Animation : AnimationSource.AnimationMetaData)
 	{
-		if (ETurboSequence_RootMotionMode_Lf Mode = Animation.Settings.RootMotionMode;
-			IsValid(Animation.Animation) && Animation.Animation->HasRootMotion() && (Mode ==
-				ETurboSequence_RootMotionMode_Lf::Force || (Mode ==
-					ETurboSequence_RootMotionMode_Lf::OnRootBoneAnimated && Animation.bIsRootBoneAnimation)))
+		if (PlaysRootMotion_Lf(Animation))
 		{
-			FTransform RootMotion_Transform = Animation.Animation->ExtractRootMotion(
-				Animation.AnimationTime, DeltaTime, Animation.bIsLoop);
+			const FAnimationLibraryData_Lf* LibraryAnimData = Library.AnimationLibraryData.Find(Animation.AnimationLibraryHash);
+			const float StartTime = LibraryAnimData
+				                        ? GetPhaseShiftedTime_Lf(Animation.AnimationTime, Animation, *LibraryAnimData,
+				                                                 AnimationSource.PhaseOffset)
+				                        : Animation.AnimationTime;
+
+			// Animations not yet in the library have no cached track
+			FTransform RootMotion_Transform = LibraryAnimData && LibraryAnimData->RootMotionTrack.Num()
+				                                  ? ExtractCachedRootMotion_Lf(LibraryAnimData->RootMotionTrack, StartTime,
+				                                                               StartTime + DeltaTime,
+				                                                               Animation.AnimationMaxPlayLength, Animation.bIsLoop)
+				                                  : Animation.Animation->ExtractRootMotion(
+					                                  StartTime, DeltaTime, Animation.bIsLoop);
 
 			float Scalar = Animation.FinalAnimationWeight * Animation.Settings.AnimationSpeed;
 
@@ -1532,6 +2766,71 @@ void FTurboSequence_Utility_Lf::ExtractRootMotionFromAnimations(FTransform& OutA
 	OutAtom = FTransform(OutputTransform);
 }
 
+bool FTurboSequence_Utility_Lf::GetSolvedRootMotion(FTransform& OutRootMotion, const FSkinnedMeshRuntime_Lf& Runtime,
+                                                    const FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                    const int64 CurrentFrameCount)
+{
+	const FAnimationSource_Lf AnimationSource = GetAnimationSource_Lf(Runtime, Library);
+	if (AnimationSource.Runtime.LastFrameAnimationSolved != CurrentFrameCount)
+	{
+		return false;
+	}
+
+	// Weighted like FRootMotionMovementParams::AccumulateWithBlend, the missing weight blends towards no motion
+	FTransform RootMotion = FTransform(FQuat(0, 0, 0, 0), FVector::ZeroVector, FVector::ZeroVector);
+	float TotalWeight = 0;
+	for (const FAnimationMetaData_Lf& Animation : AnimationSource.AnimationMetaData)
+	{
+		if (!PlaysRootMotion_Lf(Animation) || Animation.FinalAnimationWeight <= 0)
+		{
+			continue;
+		}
+
+		const FAnimationLibraryData_Lf* LibraryAnimData = Library.AnimationLibraryData.Find(Animation.AnimationLibraryHash);
+		if (!LibraryAnimData || !LibraryAnimData->RootMotionTrack.Num())
+		{
+			continue;
+		}
+
+		float PreviousTime, CurrentTime;
+		GetAdvancedTimeRange_Lf(PreviousTime, CurrentTime, Animation, *LibraryAnimData, AnimationSource.PhaseOffset);
+		if (PreviousTime == CurrentTime)
+		{
+			continue;
+		}
+
+		// The animation time of loops is wrapped, a step against the play direction went over an end
+		const float PlayLength = Animation.AnimationMaxPlayLength;
+		if (Animation.bIsLoop && Animation.Settings.AnimationSpeed >= 0 && CurrentTime < PreviousTime)
+		{
+			CurrentTime += PlayLength;
+		}
+		else if (Animation.bIsLoop && Animation.Settings.AnimationSpeed < 0 && CurrentTime > PreviousTime)
+		{
+			CurrentTime -= PlayLength;
+		}
+
+		const FTransform AnimationRootMotion = ExtractCachedRootMotion_Lf(LibraryAnimData->RootMotionTrack, PreviousTime,
+		                                                                  CurrentTime, PlayLength, Animation.bIsLoop);
+		RootMotion.AccumulateWithShortestRotation(AnimationRootMotion, ScalarRegister(Animation.FinalAnimationWeight));
+		TotalWeight += Animation.FinalAnimationWeight;
+	}
+
+	if (TotalWeight <= 0)
+	{
+		return false;
+	}
+
+	if (TotalWeight < 1)
+	{
+		RootMotion.AccumulateWithShortestRotation(FTransform::Identity, ScalarRegister(1 - TotalWeight));
+	}
+	RootMotion.NormalizeRotation();
+
+	OutRootMotion = RootMotion;
+	return true;
+}
+
 void FTurboSequence_Utility_Lf::GetTransforms(TArray<FTransform>& OutAtoms, const TArray<int32>& BoneIndices, FSkinnedMeshRuntime_Lf& Runtime,
                                               const FSkinnedMeshGlobalLibrary_Lf& Library,
                                               const EBoneSpaces::Type Space)
@@ -1542,6 +2841,13 @@ void FTurboSequence_Utility_Lf::GetTransforms(TArray<FTransform>& OutAtoms, cons
 
 	for (const int32 BoneIndex : BoneIndices)
 	{
+		// Without override bones both ways of walking the chain agree, so the component pose can be read as is
+		if (Runtime.bPoseCacheEnabled && BoneIndex != INDEX_NONE && Runtime.OverrideBoneTransforms.IsEmpty())
+		{
+			OutAtoms.Add(GetCachedComponentBoneTransform(BoneIndex, Runtime, Library));
+			continue;
+		}
+
 		FTransform BoneMatrix = FTransform::Identity;
 
 		int32 RuntimeIndex = BoneIndex;
@@ -1553,7 +2859,11 @@ void FTurboSequence_Utility_Lf::GetTransforms(TArray<FTransform>& OutAtoms, cons
 			}
 			else
 			{
-				if(const FTransform* AnimatedBone = AnimatedBoneCache.Find(RuntimeIndex))
+				if (Runtime.bPoseCacheEnabled)
+				{
+					BoneMatrix = GetCachedLocalBoneTransform(RuntimeIndex, Runtime, Library) * BoneMatrix;
+				}
+				else if(const FTransform* AnimatedBone = AnimatedBoneCache.Find(RuntimeIndex))
 				{
 					BoneMatrix = *AnimatedBone * BoneMatrix;
 				}
@@ -1646,18 +2956,25 @@ void FTurboSequence_Utility_Lf::GetBoneTransform(FTransform& OutAtom, const int3
 {
 	const FReferenceSkeleton& ReferenceSkeleton = GetReferenceSkeleton(Runtime.DataAsset);
 	OutAtom = FTransform::Identity;
-	int32 RuntimeIndex = BoneIndex;
-	while (RuntimeIndex != INDEX_NONE)
+	if (Runtime.bPoseCacheEnabled && BoneIndex != INDEX_NONE)
+	{
+		OutAtom = GetCachedComponentBoneTransform(BoneIndex, Runtime, Library);
+	}
+	else
 	{
-		if (const FOverrideBoneTransform_Lf* IKBoneData = Runtime.OverrideBoneTransforms.Find(RuntimeIndex))
+		int32 RuntimeIndex = BoneIndex;
+		while (RuntimeIndex != INDEX_NONE)
 		{
-			OutAtom *= IKBoneData->OverrideTransform;
-			break;
-		}
+			if (const FOverrideBoneTransform_Lf* IKBoneData = Runtime.OverrideBoneTransforms.Find(RuntimeIndex))
+			{
+				OutAtom *= IKBoneData->OverrideTransform;
+				break;
+			}
 
-		OutAtom *= BendBoneFromAnimations(RuntimeIndex, Runtime, Library);
+			OutAtom *= BendBoneFromAnimations(RuntimeIndex, Runtime, Library);
 
-		RuntimeIndex = GetSkeletonParentIndex(ReferenceSkeleton, RuntimeIndex);
+			RuntimeIndex = GetSkeletonParentIndex(ReferenceSkeleton, RuntimeIndex);
+		}
 	}
 
 	if (Space == EBoneSpaces::Type::WorldSpace)
@@ -1666,6 +2983,69 @@ void FTurboSequence_Utility_Lf::GetBoneTransform(FTransform& OutAtom, const int3
 	}
 }
 
+const FTransform& FTurboSequence_Utility_Lf::GetCachedLocalBoneTransform(const int32 BoneIndex,
+                                                                        const FSkinnedMeshRuntime_Lf& Runtime,
+                                                                        const FSkinnedMeshGlobalLibrary_Lf& Library)
+{
+	FSkinnedMeshPoseCache_Lf& PoseCache = Runtime.PoseCache;
+	PoseCache.Validate(GetAnimationSource_Lf(Runtime, Library).Runtime.LastFrameAnimationSolved,
+	                   GetSkeletonNumBones(GetReferenceSkeleton(Runtime.DataAsset)));
+
+	if (!PoseCache.LocalPoseValid[BoneIndex])
+	{
+		PoseCache.LocalPose[BoneIndex] = BendBoneFromAnimations(BoneIndex, Runtime, Library);
+		PoseCache.LocalPoseValid[BoneIndex] = true;
+	}
+
+	return PoseCache.LocalPose[BoneIndex];
+}
+
+const FTransform& FTurboSequence_Utility_Lf::GetCachedComponentBoneTransform(const int32 BoneIndex,
+                                                                            const FSkinnedMeshRuntime_Lf& Runtime,
+                                                                            const FSkinnedMeshGlobalLibrary_Lf& Library)
+{
+	const FReferenceSkeleton& ReferenceSkeleton = GetReferenceSkeleton(Runtime.DataAsset);
+	FSkinnedMeshPoseCache_Lf& PoseCache = Runtime.PoseCache;
+	PoseCache.Validate(GetAnimationSource_Lf(Runtime, Library).Runtime.LastFrameAnimationSolved,
+	                   GetSkeletonNumBones(ReferenceSkeleton));
+
+	// Walk up to the first filled parent or override bone, the chain is then filled root first
+	TArray<int32, TInlineAllocator<32>> Chain;
+	int32 RuntimeIndex = BoneIndex;
+	while (RuntimeIndex != INDEX_NONE && !PoseCache.ComponentPoseValid[RuntimeIndex])
+	{
+		Chain.Add(RuntimeIndex);
+		if (Runtime.OverrideBoneTransforms.Contains(RuntimeIndex))
+		{
+			break;
+		}
+		RuntimeIndex = GetSkeletonParentIndex(ReferenceSkeleton, RuntimeIndex);
+	}
+
+	for (int32 ChainIndex = Chain.Num() - 1; ChainIndex >= 0; --ChainIndex)
+	{
+		const int32 ChainBoneIndex = Chain[ChainIndex];
+		const int32 ParentIndex = GetSkeletonParentIndex(ReferenceSkeleton, ChainBoneIndex);
+
+		if (const FOverrideBoneTransform_Lf* IKBoneData = Runtime.OverrideBoneTransforms.Find(ChainBoneIndex))
+		{
+			PoseCache.ComponentPose[ChainBoneIndex] = IKBoneData->OverrideTransform;
+		}
+		else if (ParentIndex == INDEX_NONE)
+		{
+			PoseCache.ComponentPose[ChainBoneIndex] = GetCachedLocalBoneTransform(ChainBoneIndex, Runtime, Library);
+		}
+		else
+		{
+			PoseCache.ComponentPose[ChainBoneIndex] = GetCachedLocalBoneTransform(ChainBoneIndex, Runtime, Library) *
+				PoseCache.ComponentPose[ParentIndex];
+		}
+		PoseCache.ComponentPoseValid[ChainBoneIndex] = true;
+	}
+
+	return PoseCache.ComponentPose[BoneIndex];
+}
+
 bool FTurboSequence_Utility_Lf::OverrideBoneTransform(const FTransform& Atom, const int32 BoneIndex,
                                                       FSkinnedMeshRuntime_Lf& Runtime,
                                                       const EBoneSpaces::Type Space)
@@ -1694,13 +3074,109 @@ bool FTurboSequence_Utility_Lf::OverrideBoneTransform(const FTransform& Atom, co
 		Data.OverrideTransform = IKTransform;
 		Runtime.OverrideBoneTransforms.Add(BoneIndex, Data);
 	}
+	Runtime.bBoneTextureDirty = true;
+	Runtime.PoseCache.InvalidateComponentPose();
 
 	return true;
 }
 
 bool FTurboSequence_Utility_Lf::RemoveOverrideBoneTransform(const int32 BoneIndex, FSkinnedMeshRuntime_Lf& Runtime)
 {
-	return Runtime.OverrideBoneTransforms.Remove(BoneIndex) > 0;
+	if (Runtime.OverrideBoneTransforms.Remove(BoneIndex) > 0)
+	{
+		Runtime.bBoneTextureDirty = true;
+		Runtime.PoseCache.InvalidateComponentPose();
+		return true;
+	}
+
+	return false;
+}
+
+void FTurboSequence_Utility_Lf::BakeAnimationCurves(FSkinnedMeshGlobalLibrary_Lf& Library,
+                                                    FAnimationLibraryData_Lf& LibraryAnimData,
+                                                    const UAnimSequence* Animation)
+{
+	LibraryAnimData.CurveTable.Reset();
+	LibraryAnimData.CurveIdToSlot.Reset();
+
+	const int32 MaxFrames = LibraryAnimData.MaxFrames;
+	for (int32 CPUIndex = 0; CPUIndex < MaxFrames; ++CPUIndex)
+	{
+		// Curves only, far cheaper than the pose the keyframe gets in the library
+		FBlendedCurve Curve;
+		Animation->EvaluateCurveData(Curve, FAnimExtractContext(
+			static_cast<double>(GetAnimationLibraryFrameTime(CPUIndex, MaxFrames, Animation))));
+
+		Curve.ForEachElement([&Library, &LibraryAnimData, MaxFrames, CPUIndex](const UE::Anim::FCurveElement& Element)
+		{
+			const int32 CurveId = GetAnimationCurveId(Library, Element.Name);
+			while (LibraryAnimData.CurveIdToSlot.Num() <= CurveId)
+			{
+				LibraryAnimData.CurveIdToSlot.Add(INDEX_NONE);
+			}
+
+			int32& Slot = LibraryAnimData.CurveIdToSlot[CurveId];
+			if (Slot == INDEX_NONE)
+			{
+				Slot = LibraryAnimData.CurveTable.Num() / MaxFrames;
+				LibraryAnimData.CurveTable.AddZeroed(MaxFrames);
+			}
+
+			LibraryAnimData.CurveTable[Slot * MaxFrames + CPUIndex] = Element.Value;
+		});
+	}
+}
+
+int32 FTurboSequence_Utility_Lf::GetAnimationCurveId(FSkinnedMeshGlobalLibrary_Lf& Library, const FName& CurveName)
+{
+	if (const int32* CurveId = Library.AnimationCurveIds.Find(CurveName))
+	{
+		return *CurveId;
+	}
+	return Library.AnimationCurveIds.Add(CurveName, Library.AnimationCurveIds.Num());
+}
+
+bool FTurboSequence_Utility_Lf::SampleAnimationCurve(float& OutValue, const FAnimationMetaData_Lf& Animation,
+                                                     const FSkinnedMeshGlobalLibrary_Lf& Library, const int32 CurveId)
+{
+	const FAnimationLibraryData_Lf* LibraryAnimData = Library.AnimationLibraryData.Find(Animation.AnimationLibraryHash);
+	if (!LibraryAnimData || !LibraryAnimData->CurveIdToSlot.IsValidIndex(CurveId))
+	{
+		return false;
+	}
+
+	const int32 Slot = LibraryAnimData->CurveIdToSlot[CurveId];
+	if (Slot == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const int32 MaxFrames = LibraryAnimData->MaxFrames;
+	const float* Keyframes = LibraryAnimData->CurveTable.GetData() + Slot * MaxFrames;
+	const float Value0 = Keyframes[FMath::Clamp(Animation.CPUAnimationIndex_0, 0, MaxFrames - 1)];
+	const float Value1 = Keyframes[FMath::Clamp(Animation.CPUAnimationIndex_1, 0, MaxFrames - 1)];
+	OutValue = FMath::Lerp(Value0, Value1, Animation.FrameAlpha);
+
+	return true;
+}
+
+bool FTurboSequence_Utility_Lf::GetAnimationCurveValue(float& OutValue, const FSkinnedMeshRuntime_Lf& Runtime,
+                                                       const FSkinnedMeshGlobalLibrary_Lf& Library, const int32 CurveId)
+{
+	OutValue = 0;
+
+	bool bFound = false;
+	for (const FAnimationMetaData_Lf& Animation : GetAnimationSource_Lf(Runtime, Library).AnimationMetaData)
+	{
+		float Value;
+		if (SampleAnimationCurve(Value, Animation, Library, CurveId))
+		{
+			OutValue += Value * Animation.FinalAnimationWeight;
+			bFound = true;
+		}
+	}
+
+	return bFound;
 }
 
 FTurboSequence_PoseCurveData_Lf FTurboSequence_Utility_Lf::GetAnimationCurveByAnimation(
@@ -1709,14 +3185,11 @@ FTurboSequence_PoseCurveData_Lf FTurboSequence_Utility_Lf::GetAnimationCurveByAn
 {
 	if (IsValid(Animation.Animation))
 	{
-		const FAnimationLibraryData_Lf& LibraryData = Library.AnimationLibraryData[Animation.AnimationLibraryHash];
-
-		if (LibraryData.KeyframeIndexToPose.Contains(Animation.CPUAnimationIndex_0))
+		float CurveValue;
+		if (const int32* CurveId = Library.AnimationCurveIds.Find(CurveName);
+			CurveId && SampleAnimationCurve(CurveValue, Animation, Library, *CurveId))
 		{
-			float PoseCurve0 = FTurboSequence_Helper_Lf::GetAnimationCurveWeight(
-				LibraryData.KeyframeIndexToPose[Animation.CPUAnimationIndex_0].Pose, CurveName);
-
-			return FTurboSequence_PoseCurveData_Lf(Animation.Animation, CurveName, PoseCurve0);
+			return FTurboSequence_PoseCurveData_Lf(Animation.Animation, CurveName, CurveValue);
 		}
 	}
 
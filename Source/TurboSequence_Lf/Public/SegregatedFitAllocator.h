@@ -0,0 +1,403 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Two level segregated fit (TLSF) allocator over a range of indices, the memory itself lives elsewhere (the bone texture).
+// Allocate and Free are O(1), freed ranges coalesce with their free neighbours immediately.
+template <int32 BlockSize>
+class TSegregatedFitAllocator
+{
+public:
+    explicit TSegregatedFitAllocator(const int32 TotalSize = 0)
+    {
+        static_assert(BlockSize > 0, "BlockSize must be greater than zero.");
+        static_assert(FirstLevelCount <= 32, "The first level bitmap holds 32 classes.");
+
+        Reset(TotalSize);
+    }
+
+    // Frees everything at once and sets the capacity
+    void Reset(const int32 TotalSize)
+    {
+        NumBlocks = FMath::Max(TotalSize / BlockSize, 0);
+
+        RangeSizes.Init(0, NumBlocks);
+        PrevPhysicalRanges.SetNumUninitialized(NumBlocks);
+        NextFreeRanges.SetNumUninitialized(NumBlocks);
+        PrevFreeRanges.SetNumUninitialized(NumBlocks);
+        FreeFlags.Init(false, NumBlocks);
+        AllocatedFlags.Init(false, NumBlocks);
+
+        FirstLevelBitmap = 0;
+        FMemory::Memzero(SecondLevelBitmaps);
+        for (int32 FirstLevel = 0; FirstLevel < FirstLevelCount; ++FirstLevel)
+        {
+            for (int32 SecondLevel = 0; SecondLevel < SecondLevelCount; ++SecondLevel)
+            {
+                FreeHeads[FirstLevel][SecondLevel] = INDEX_NONE;
+            }
+        }
+
+        NumAllocations = 0;
+        NumFreeRanges = 0;
+        FreeBlocks = 0;
+        HighWaterMarkBlocks = 0;
+        LastRange = INDEX_NONE;
+
+        if (NumBlocks)
+        {
+            RangeSizes[0] = NumBlocks;
+            PrevPhysicalRanges[0] = INDEX_NONE;
+            LastRange = 0;
+            InsertFreeRange(0);
+        }
+    }
+
+    // Appends free space at the end, live allocations keep their index
+    void Grow(const int32 TotalSize)
+    {
+        const int32 NewNumBlocks = TotalSize / BlockSize;
+        if (NewNumBlocks <= NumBlocks)
+        {
+            return;
+        }
+
+        const int32 OldNumBlocks = NumBlocks;
+        NumBlocks = NewNumBlocks;
+
+        RangeSizes.SetNumZeroed(NumBlocks);
+        PrevPhysicalRanges.SetNumUninitialized(NumBlocks);
+        NextFreeRanges.SetNumUninitialized(NumBlocks);
+        PrevFreeRanges.SetNumUninitialized(NumBlocks);
+        FreeFlags.Add(false, NumBlocks - OldNumBlocks);
+        AllocatedFlags.Add(false, NumBlocks - OldNumBlocks);
+
+        if (LastRange != INDEX_NONE && FreeFlags[LastRange])
+        {
+            RemoveFreeRange(LastRange);
+            RangeSizes[LastRange] += NumBlocks - OldNumBlocks;
+            InsertFreeRange(LastRange);
+            return;
+        }
+
+        RangeSizes[OldNumBlocks] = NumBlocks - OldNumBlocks;
+        PrevPhysicalRanges[OldNumBlocks] = LastRange;
+        LastRange = OldNumBlocks;
+        InsertFreeRange(OldNumBlocks);
+    }
+
+    // Allocate a range, returns the start index or -1 when no free range is large enough
+    int32 Allocate(const int32 Size)
+    {
+        if (Size <= 0 || Size > GetTotalSize())
+        {
+            return -1;
+        }
+
+        const int32 SizeInBlocks = FMath::DivideAndRoundUp(Size, BlockSize);
+
+        const int32 Range = FindFreeRange(SizeInBlocks);
+        if (Range == INDEX_NONE)
+        {
+            return -1;
+        }
+
+        RemoveFreeRange(Range);
+
+        // Give the tail back
+        const int32 RemainingBlocks = RangeSizes[Range] - SizeInBlocks;
+        if (RemainingBlocks > 0)
+        {
+            const int32 Remainder = Range + SizeInBlocks;
+            RangeSizes[Range] = SizeInBlocks;
+            RangeSizes[Remainder] = RemainingBlocks;
+            PrevPhysicalRanges[Remainder] = Range;
+            SetPrevPhysicalOfNext(Remainder);
+            if (LastRange == Range)
+            {
+                LastRange = Remainder;
+            }
+            InsertFreeRange(Remainder);
+        }
+
+        AllocatedFlags[Range] = true;
+        NumAllocations++;
+        HighWaterMarkBlocks = FMath::Max(HighWaterMarkBlocks, Range + SizeInBlocks);
+
+        return Range * BlockSize;
+    }
+
+    // Free a range returned by Allocate, Size has to match the allocated size
+    void Free(const int32 Index, const int32 Size)
+    {
+        if (Index < 0 || Index >= GetTotalSize() || Index % BlockSize)
+        {
+            return;
+        }
+
+        int32 Range = Index / BlockSize;
+        if (!AllocatedFlags[Range])
+        {
+            return;
+        }
+        ensure(RangeSizes[Range] == FMath::DivideAndRoundUp(Size, BlockSize));
+
+        AllocatedFlags[Range] = false;
+        NumAllocations--;
+
+        // Merge with the free physical neighbours before reinserting
+        const int32 NextRange = Range + RangeSizes[Range];
+        if (NextRange < NumBlocks && FreeFlags[NextRange])
+        {
+            RemoveFreeRange(NextRange);
+            RangeSizes[Range] += RangeSizes[NextRange];
+            SetPrevPhysicalOfNext(Range);
+            if (LastRange == NextRange)
+            {
+                LastRange = Range;
+            }
+        }
+
+        const int32 PrevRange = PrevPhysicalRanges[Range];
+        if (PrevRange != INDEX_NONE && FreeFlags[PrevRange])
+        {
+            RemoveFreeRange(PrevRange);
+            RangeSizes[PrevRange] += RangeSizes[Range];
+            if (LastRange == Range)
+            {
+                LastRange = PrevRange;
+            }
+            Range = PrevRange;
+            SetPrevPhysicalOfNext(Range);
+        }
+
+        InsertFreeRange(Range);
+    }
+
+    int32 GetTotalSize() const { return NumBlocks * BlockSize; }
+    int32 GetNumAllocations() const { return NumAllocations; }
+    // End of the highest allocation since the last reset
+    int32 GetHighWaterMark() const { return HighWaterMarkBlocks * BlockSize; }
+    // End of the highest live allocation, everything above is one free range
+    int32 GetUsedSize() const
+    {
+        return LastRange != INDEX_NONE && FreeFlags[LastRange] ? LastRange * BlockSize : GetTotalSize();
+    }
+    int32 GetNumFreeRanges() const { return NumFreeRanges; }
+    int32 GetFreeSize() const { return FreeBlocks * BlockSize; }
+
+    int32 GetLargestFreeSize() const
+    {
+        if (!FirstLevelBitmap)
+        {
+            return 0;
+        }
+
+        // Only the list of the highest class needs a scan, its ranges differ by less than the class width
+        const int32 FirstLevel = FMath::FloorLog2(FirstLevelBitmap);
+        const int32 SecondLevel = FMath::FloorLog2(SecondLevelBitmaps[FirstLevel]);
+        int32 LargestBlocks = 0;
+        for (int32 Range = FreeHeads[FirstLevel][SecondLevel]; Range != INDEX_NONE; Range = NextFreeRanges[Range])
+        {
+            LargestBlocks = FMath::Max(LargestBlocks, RangeSizes[Range]);
+        }
+        return LargestBlocks * BlockSize;
+    }
+
+    // 0 when all free space is one range, towards 1 the more it is scattered
+    float GetFragmentation() const
+    {
+        return FreeBlocks ? 1.0f - static_cast<float>(GetLargestFreeSize()) / GetFreeSize() : 0.0f;
+    }
+
+    // Walks the physical ranges and checks the bookkeeping, for tests and benchmarks
+    bool Validate() const
+    {
+        int32 CountedFreeBlocks = 0;
+        int32 CountedFreeRanges = 0;
+        int32 CountedAllocations = 0;
+        int32 PrevRange = INDEX_NONE;
+        for (int32 Range = 0; Range < NumBlocks; Range += RangeSizes[Range])
+        {
+            if (RangeSizes[Range] <= 0 || PrevPhysicalRanges[Range] != PrevRange || FreeFlags[Range] == AllocatedFlags[Range])
+            {
+                return false;
+            }
+
+            if (FreeFlags[Range])
+            {
+                // Free neighbours would have been coalesced
+                if (PrevRange != INDEX_NONE && FreeFlags[PrevRange])
+                {
+                    return false;
+                }
+                CountedFreeBlocks += RangeSizes[Range];
+                CountedFreeRanges++;
+            }
+            else
+            {
+                CountedAllocations++;
+            }
+            PrevRange = Range;
+        }
+
+        return CountedFreeBlocks == FreeBlocks && CountedFreeRanges == NumFreeRanges && CountedAllocations == NumAllocations &&
+            LastRange == PrevRange;
+    }
+
+private:
+    static constexpr int32 ConstFloorLog2(const int32 Value)
+    {
+        return Value <= 1 ? 0 : 1 + ConstFloorLog2(Value / 2);
+    }
+
+    static constexpr int32 SecondLevelLog2 = 4;
+    static constexpr int32 SecondLevelCount = 1 << SecondLevelLog2;
+    // Sizes below SecondLevelCount share the first class linearly, every power of two above gets its own
+    static constexpr int32 FirstLevelCount = ConstFloorLog2(MAX_int32) - SecondLevelLog2 + 2;
+
+    int32 NumBlocks = 0;
+
+    // Per range start, only valid at the first block of a range
+    TArray<int32> RangeSizes;
+    TArray<int32> PrevPhysicalRanges;
+    TArray<int32> NextFreeRanges;
+    TArray<int32> PrevFreeRanges;
+    TBitArray<> FreeFlags;
+    TBitArray<> AllocatedFlags;
+
+    uint32 FirstLevelBitmap = 0;
+    uint32 SecondLevelBitmaps[FirstLevelCount];
+    int32 FreeHeads[FirstLevelCount][SecondLevelCount];
+
+    int32 NumAllocations = 0;
+    int32 NumFreeRanges = 0;
+    int32 FreeBlocks = 0;
+    int32 HighWaterMarkBlocks = 0;
+    // Physically last range, free space is appended to it when growing
+    int32 LastRange = INDEX_NONE;
+
+    static void MapSize(const int32 SizeInBlocks, int32& OutFirstLevel, int32& OutSecondLevel)
+    {
+        if (SizeInBlocks < SecondLevelCount)
+        {
+            OutFirstLevel = 0;
+            OutSecondLevel = SizeInBlocks;
+            return;
+        }
+
+        const int32 Log2 = FMath::FloorLog2(SizeInBlocks);
+        OutFirstLevel = Log2 - SecondLevelLog2 + 1;
+        OutSecondLevel = (SizeInBlocks >> (Log2 - SecondLevelLog2)) ^ SecondLevelCount;
+    }
+
+    int32 FindFreeRange(const int32 SizeInBlocks) const
+    {
+        // Round up to the next class, every range in it is large enough
+        int32 SearchSize = SizeInBlocks;
+        if (SearchSize >= SecondLevelCount)
+        {
+            SearchSize += (1 << (FMath::FloorLog2(SearchSize) - SecondLevelLog2)) - 1;
+        }
+
+        int32 FirstLevel;
+        int32 SecondLevel;
+        MapSize(SearchSize, FirstLevel, SecondLevel);
+        if (FirstLevel < FirstLevelCount)
+        {
+            uint32 SecondLevelMap = SecondLevelBitmaps[FirstLevel] & (~0u << SecondLevel);
+            if (!SecondLevelMap)
+            {
+                const uint32 FirstLevelMap = FirstLevel + 1 < 32 ? FirstLevelBitmap & (~0u << (FirstLevel + 1)) : 0;
+                if (FirstLevelMap)
+                {
+                    FirstLevel = FMath::CountTrailingZeros(FirstLevelMap);
+                    SecondLevelMap = SecondLevelBitmaps[FirstLevel];
+                }
+            }
+
+            if (SecondLevelMap)
+            {
+                return FreeHeads[FirstLevel][FMath::CountTrailingZeros(SecondLevelMap)];
+            }
+        }
+
+        // Nearly full, a range of the request's own class may still fit
+        MapSize(SizeInBlocks, FirstLevel, SecondLevel);
+        for (int32 Range = FreeHeads[FirstLevel][SecondLevel]; Range != INDEX_NONE; Range = NextFreeRanges[Range])
+        {
+            if (RangeSizes[Range] >= SizeInBlocks)
+            {
+                return Range;
+            }
+        }
+
+        return INDEX_NONE;
+    }
+
+    void InsertFreeRange(const int32 Range)
+    {
+        int32 FirstLevel;
+        int32 SecondLevel;
+        MapSize(RangeSizes[Range], FirstLevel, SecondLevel);
+
+        const int32 Head = FreeHeads[FirstLevel][SecondLevel];
+        NextFreeRanges[Range] = Head;
+        PrevFreeRanges[Range] = INDEX_NONE;
+        if (Head != INDEX_NONE)
+        {
+            PrevFreeRanges[Head] = Range;
+        }
+        FreeHeads[FirstLevel][SecondLevel] = Range;
+
+        FirstLevelBitmap |= 1u << FirstLevel;
+        SecondLevelBitmaps[FirstLevel] |= 1u << SecondLevel;
+
+        FreeFlags[Range] = true;
+        NumFreeRanges++;
+        FreeBlocks += RangeSizes[Range];
+    }
+
+    void RemoveFreeRange(const int32 Range)
+    {
+        int32 FirstLevel;
+        int32 SecondLevel;
+        MapSize(RangeSizes[Range], FirstLevel, SecondLevel);
+
+        const int32 Next = NextFreeRanges[Range];
+        const int32 Prev = PrevFreeRanges[Range];
+        if (Next != INDEX_NONE)
+        {
+            PrevFreeRanges[Next] = Prev;
+        }
+        if (Prev != INDEX_NONE)
+        {
+            NextFreeRanges[Prev] = Next;
+        }
+        else
+        {
+            FreeHeads[FirstLevel][SecondLevel] = Next;
+            if (Next == INDEX_NONE)
+            {
+                SecondLevelBitmaps[FirstLevel] &= ~(1u << SecondLevel);
+                if (!SecondLevelBitmaps[FirstLevel])
+                {
+                    FirstLevelBitmap &= ~(1u << FirstLevel);
+                }
+            }
+        }
+
+        FreeFlags[Range] = false;
+        NumFreeRanges--;
+        FreeBlocks -= RangeSizes[Range];
+    }
+
+    void SetPrevPhysicalOfNext(const int32 Range)
+    {
+        const int32 NextRange = Range + RangeSizes[Range];
+        if (NextRange < NumBlocks)
+        {
+            PrevPhysicalRanges[NextRange] = Range;
+        }
+    }
+};
@@ -6,14 +6,18 @@
 #include "TurboSequence_ComputeShaders_Lf.h"
 #include "TurboSequence_Helper_Lf.h"
 #include "TurboSequence_MinimalData_Lf.h"
-#include "BestFitAllocator.h"
+#include "SegregatedFitAllocator.h"
 #include "TurboSequence_RenderData.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
 
 
 #include "TurboSequence_Data_Lf.generated.h"
 
 struct FSkinnedMeshGlobalLibrary_Lf;
 struct FSkinnedMeshRuntime_Lf;
+struct FTurboSequence_BakedAnimation_Lf;
+class UTurboSequence_MeshAsset_Lf;
 class UNiagaraComponent;
 
 /*	==============================================================================================================
@@ -50,6 +54,9 @@ struct TURBOSEQUENCE_LF_API FCameraView_Lf
 
 	FPlane Planes_Internal[6];
 	FTransform InterpolatedCameraTransform_Internal;
+
+	// Planes_Internal rotated into world orientation, relative to the camera location, used by the batched culling
+	FVector4f CullingPlanes_Internal[6];
 };
 
 USTRUCT()
@@ -97,6 +104,10 @@ public:
 
 	virtual void UpdateNiagaraEmitter() override;
 
+protected:
+	virtual void MoveRenderInstanceInternal(int32 FromIndex, int32 ToIndex) override;
+	virtual void ShrinkRenderInstancesInternal(int32 NumInstances) override;
+
 private:
 	
 	//Attachment local transforms
@@ -104,9 +115,9 @@ private:
 	TArray<FVector3f> ParticleAttachmentScales;
 	TArray<FVector4f> ParticleAttachmentRotations;
 
-	bool bChangedParticleAttachmentPosition = false;
-	bool bChangedParticleAttachmentScale = false;
-	bool bChangedParticleAttachmentRotation = false;
+	FNiagaraArrayDirtyElements_Lf DirtyAttachmentPositions;
+	FNiagaraArrayDirtyElements_Lf DirtyAttachmentScales;
+	FNiagaraArrayDirtyElements_Lf DirtyAttachmentRotations;
 
 
 	
@@ -132,6 +143,14 @@ struct TURBOSEQUENCE_LF_API FAnimationLibraryDataAllocationItem_Lf
 };
 
 
+// Notify of an animation sequence, indexes its Notifies
+struct TURBOSEQUENCE_LF_API FAnimationNotifyTimelineEntry_Lf
+{
+	float TriggerTime = 0;
+	float EndTriggerTime = 0;
+	int32 NotifyIndex = INDEX_NONE;
+};
+
 USTRUCT()
 struct TURBOSEQUENCE_LF_API FAnimationLibraryData_Lf
 {
@@ -141,15 +160,72 @@ struct TURBOSEQUENCE_LF_API FAnimationLibraryData_Lf
 
 	uint16 NumBones = 0;
 	
+	// Sampled poses not decomposed yet, a pose is dropped once its keyframe got decomposed below
 	TMap<int32, FCPUAnimationPose_Lf> KeyframeIndexToPose;
 
+	// Bone space keyframes decomposed once for the CPU blends, laid out keyframe x bone,
+	// a keyframe gets decomposed when it's first written to the library and rewrites its texels from here after an eviction
+	TArray<FQuat4f> KeyframeRotations;
+	TArray<FVector3f> KeyframeTranslations;
+	TArray<FVector3f> KeyframeScales;
+	TBitArray<> KeyframesDecomposed;
+
+	bool HasKeyframePose(const int32 CPUIndex) const
+	{
+		return (KeyframesDecomposed.IsValidIndex(CPUIndex) && KeyframesDecomposed[CPUIndex]) ||
+			KeyframeIndexToPose.Contains(CPUIndex);
+	}
+
 	TArray<int32> KeyframesFilled;
 
+	// Frame a keyframe was last referenced by a mesh, the least recently used get evicted when the library runs full
+	TArray<int64> KeyframesLastUsedFrame;
+
+	// Keyframes with a pose sample in flight on a worker thread
+	TBitArray<> KeyframesSampling;
+
 	TMap<FName, int16> BoneNameToAnimationBoneIndex;
+
+	// Notifies sorted by trigger time, built when the animation is registered, crossings are found by binary search.
+	// Notify states stay apart since they span a window and fire while it overlaps the played range
+	TArray<FAnimationNotifyTimelineEntry_Lf> NotifyTimeline;
+	TArray<FAnimationNotifyTimelineEntry_Lf> NotifyStateTimeline;
+
+	// Float curves baked once per keyframe, laid out curve slot x keyframe,
+	// indexed by the curve id of the library, INDEX_NONE when the animation has no such curve
+	TArray<float> CurveTable;
+	TArray<int32> CurveIdToSlot;
+
+	// Root motion from the start of the animation up to each keyframe, empty for animations without root motion
+	TArray<FTransform> RootMotionTrack;
 	
 	FAnimPoseEvaluationOptions_Lf PoseOptions;
 
 	bool bHasPoseData = false;
+
+	// The rest pose stays resident, meshes without animation fall back to it
+	bool bIsRestPose = false;
+
+	// Offline sampled keyframes, an index into the baked animation library of the mesh asset, INDEX_NONE samples at runtime.
+	// A re-bake replaces that library, so the keyframes get looked up on each use
+	TWeakObjectPtr<const UTurboSequence_MeshAsset_Lf> BakedAnimationAsset;
+	TWeakObjectPtr<const UAnimSequence> BakedAnimationSequence;
+	int32 BakedAnimationIndex = INDEX_NONE;
+
+	// The baked keyframes, null when the animation samples at runtime or the bake changed since it was registered
+	const FTurboSequence_BakedAnimation_Lf* GetBakedAnimation() const;
+};
+
+// Pose of a library keyframe sampled on a worker thread before the animation reaches it
+struct TURBOSEQUENCE_LF_API FAnimationKeyframeSample_Lf
+{
+	FUintVector AnimationLibraryHash = FUintVector::ZeroValue;
+	int32 CPUIndex = INDEX_NONE;
+
+	// Keeps the animation alive while the worker samples it
+	TStrongObjectPtr<UAnimSequence> Animation;
+
+	UE::Tasks::TTask<FAnimPose_Lf> Task;
 };
 
 USTRUCT()
@@ -193,6 +269,10 @@ struct TURBOSEQUENCE_LF_API FAnimationMetaData_Lf
 	
 	FBoneMaskSourceHandle AnimationGroupLayerHash;	//Source mask hash
 
+	FBoneMaskBuiltProxyHandle MaskProxyHandle;	//Built mask hash, resolved once when the mask is set since hashing the bone layers is slow
+	int32 MaskLayerIndex = INDEX_NONE;	//Index of the built mask in ReferenceData.AnimationLayers, valid while MaskLayerVersion matches its version
+	uint32 MaskLayerVersion = 0;
+
 	FUintVector AnimationLibraryHash = FUintVector::ZeroValue; //FUintVector(GetTypeHash(Skeleton), GetTypeHash(Asset), GetTypeHash(Animation))
 
 	float AnimationNormalizedTime = 0;
@@ -281,6 +361,45 @@ struct TURBOSEQUENCE_LF_API FSkinnedMeshAttachmentRuntime
 	FTurboSequenceRenderHandle RenderHandle;
 };
 
+// Bone transforms of a mesh evaluated on the CPU, filled lazily per bone and valid for one animation solve
+struct TURBOSEQUENCE_LF_API FSkinnedMeshPoseCache_Lf
+{
+	// The LastFrameAnimationSolved of the mesh the cached bones belong to
+	int64 SolvedFrame = INDEX_NONE;
+
+	// Blended bone space transforms of the animations, without override bones
+	TArray<FTransform> LocalPose;
+	TBitArray<> LocalPoseValid;
+
+	// Component space transforms, an override bone replaces the chain from its parents like GetBoneTransform did
+	TArray<FTransform> ComponentPose;
+	TBitArray<> ComponentPoseValid;
+
+	// Override bones only change the component space transforms, the blended animations stay valid
+	void InvalidateComponentPose()
+	{
+		if (ComponentPoseValid.Num())
+		{
+			ComponentPoseValid.SetRange(0, ComponentPoseValid.Num(), false);
+		}
+	}
+
+	// Clears the cached bones when the mesh solved since they were filled
+	void Validate(const int64 LastFrameAnimationSolved, const int32 NumBones)
+	{
+		if (SolvedFrame == LastFrameAnimationSolved && LocalPose.Num() == NumBones)
+		{
+			return;
+		}
+
+		SolvedFrame = LastFrameAnimationSolved;
+		LocalPose.SetNumUninitialized(NumBones);
+		ComponentPose.SetNumUninitialized(NumBones);
+		LocalPoseValid.Init(false, NumBones);
+		ComponentPoseValid.Init(false, NumBones);
+	}
+};
+
 USTRUCT()
 struct TURBOSEQUENCE_LF_API FSkinnedMeshRuntime_Lf 
 {
@@ -318,11 +437,13 @@ struct TURBOSEQUENCE_LF_API FSkinnedMeshRuntime_Lf
 
 	FTurboSequenceRenderHandle RenderHandle;
 
-	bool bIsVisible = true;
-
 	TMap<uint16, FOverrideBoneTransform_Lf> OverrideBoneTransforms;
 
 	int32 BoneTextureSkeletonIndex = INDEX_NONE;
+
+	// Index of DataAsset in PerReferenceDataKeys, valid while ReferenceIndexVersion matches ReferenceData.ReferenceDataVersion
+	int32 ReferenceIndex = INDEX_NONE;
+	uint32 ReferenceIndexVersion = 0;
 	
 	FTransform WorldSpaceTransform = FTransform::Identity;
 
@@ -331,6 +452,13 @@ struct TURBOSEQUENCE_LF_API FSkinnedMeshRuntime_Lf
 	TArray<TObjectPtr<UNiagaraComponent>> AttachedParticles;
 	
 	int32 GetAnimIndex(FAnimationMetaDataHandle AnimationMetaDataHandle ) const;
+
+	float ConsumePendingAnimationDeltaTime()
+	{
+		const float AnimationDeltaTime = PendingAnimationDeltaTime;
+		PendingAnimationDeltaTime = 0;
+		return AnimationDeltaTime;
+	}
 	const FAnimationMetaData_Lf* GetAnimMetaData(FAnimationMetaDataHandle AnimationMetaDataHandle) const;
 	FAnimationMetaData_Lf* GetAnimMetaData(FAnimationMetaDataHandle AnimationMetaDataHandle);
 
@@ -347,9 +475,228 @@ struct TURBOSEQUENCE_LF_API FSkinnedMeshRuntime_Lf
 	TMap<TObjectPtr<UBlendSpace>, FAnimationBlendSpaceData_Lf> AnimationBlendSpaceMetaData;
 
 	int64 LastFrameAnimationSolved = 0;
+
+	// Index into the animation LOD bands of the asset, INDEX_NONE when the asset has none
+	int32 AnimationLODBand = INDEX_NONE;
+
+	// Time not yet applied to the animations, frames skipped by the animation LOD or the update budget add up here
+	float PendingAnimationDeltaTime = 0;
+
+	// The bone texture rows are outdated, cleared once the GPU solve wrote them
+	bool bBoneTextureDirty = true;
+
+	// The previous rows lag one solve behind the current rows, a frame skipped by the animation LOD copies them once
+	bool bPreviousBoneRowsStale = false;
+
+	// The previous rows hold no pose of this mesh, the skeleton is new or moved in the bone texture,
+	// the next solve writes its pose into both textures
+	bool bPreviousBoneRowsInvalid = true;
+
+	// Group whose timeline the mesh plays instead of its own animations, shifted by the phase offset in keyframes
+	FTurboSequence_AnimationGroupHandle_Lf AnimationGroup;
+	int32 AnimationGroupPhaseOffset = 0;
+
+	// Opt-in, bone and socket queries read the pose cache instead of blending the animations per query,
+	// filling it mutates the runtime, so queries of the same mesh must not run in parallel
+	bool bPoseCacheEnabled = false;
+	mutable FSkinnedMeshPoseCache_Lf PoseCache;
+
+	// Opt-in, the solve moves the mesh by the root motion its animations played, like MoveMeshWithRootMotion
+	bool bAutoRootMotion = false;
+	bool bAutoRootMotionZeroZAxis = false;
+	bool bAutoRootMotionIncludeScale = false;
 	
 };
 
+// Meshes of an animation group sharing the same phase offset, they share one set of animation entries on the GPU
+struct TURBOSEQUENCE_LF_API FSkinnedMeshAnimationGroupPhase_Lf
+{
+	int32 PhaseOffset = 0;
+	int32 NumMeshes = 0;
+
+	// The timeline animations moved by the phase offset, the phase without offset reads the timeline itself
+	TArray<FAnimationMetaData_Lf> AnimationMetaData;
+
+	// Range of the phase in the animation arrays of the snapshot being built, INDEX_NONE until its first mesh
+	int32 SnapshotAnimationStartIndex = INDEX_NONE;
+	int32 SnapshotNumAnimations = 0;
+};
+
+// Shared animation timeline, advanced and resolved in the library once per frame for all meshes of the group
+struct TURBOSEQUENCE_LF_API FSkinnedMeshAnimationGroup_Lf
+{
+	// Carries the animations of the group like a mesh would, it's never rendered
+	FSkinnedMeshRuntime_Lf Timeline;
+
+	TArray<FSkinnedMeshAnimationGroupPhase_Lf> Phases;
+	int32 NumMeshes = 0;
+
+	FSkinnedMeshAnimationGroupPhase_Lf* FindPhase(const int32 PhaseOffset)
+	{
+		return Phases.FindByPredicate([PhaseOffset](const FSkinnedMeshAnimationGroupPhase_Lf& Phase)
+		{
+			return Phase.PhaseOffset == PhaseOffset;
+		});
+	}
+};
+
+
+// Cell of the loose spatial grid, meshes are sorted in by their location only, MaxRadius loosens the cell bounds
+struct TURBOSEQUENCE_LF_API FSpatialGridCell_Lf
+{
+	FIntVector Coordinates = FIntVector::ZeroValue;
+	TArray<FBaseSkeletalMeshHandle> Meshes;
+	float MaxRadius = 0;
+};
+
+// Slot map owning all skinned mesh runtimes, the handle encodes < Slot | Generation > so lookups stay O(1)
+// and handles of removed meshes never resolve to a reused slot. Runtimes are packed densely and removed by
+// swap, the per frame passes iterate them by dense index together with the hot visibility column.
+// Only visibility and the culling spheres live in separate columns, the transform, bone texture index,
+// render handle and update flags stay on the runtime record, the bone and socket queries take it by reference
+struct TURBOSEQUENCE_LF_API FSkinnedMeshRuntimeStore_Lf
+{
+	static constexpr int32 NumSlotBits = 18;
+	static constexpr int32 NumGenerationBits = 5; // Keeps the sign bit of the 24 bit MeshID clear, so never INDEX_NONE
+	static constexpr int32 MaxSlots = 1 << NumSlotBits;
+
+	FBaseSkeletalMeshHandle AllocateHandle();
+
+	FSkinnedMeshRuntime_Lf& Add(const FBaseSkeletalMeshHandle Handle, const FSkinnedMeshRuntime_Lf& Runtime);
+
+	bool Remove(const FBaseSkeletalMeshHandle Handle);
+
+	void Empty();
+
+	// Pre-sizes the dense columns for NumRuntimes, bulk adds don't grow them one by one
+	void Reserve(const int32 NumRuntimes);
+
+	int32 GetDenseIndex(const FBaseSkeletalMeshHandle Handle) const;
+
+	FORCEINLINE FSkinnedMeshRuntime_Lf* Find(const FBaseSkeletalMeshHandle Handle)
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? &Runtimes[DenseIndex] : nullptr;
+	}
+
+	FORCEINLINE const FSkinnedMeshRuntime_Lf* Find(const FBaseSkeletalMeshHandle Handle) const
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? &Runtimes[DenseIndex] : nullptr;
+	}
+
+	FORCEINLINE bool Contains(const FBaseSkeletalMeshHandle Handle) const
+	{
+		return GetDenseIndex(Handle) != INDEX_NONE;
+	}
+
+	FORCEINLINE FSkinnedMeshRuntime_Lf& operator[](const FBaseSkeletalMeshHandle Handle)
+	{
+		FSkinnedMeshRuntime_Lf* Runtime = Find(Handle);
+		check(Runtime);
+		return *Runtime;
+	}
+
+	FORCEINLINE const FSkinnedMeshRuntime_Lf& operator[](const FBaseSkeletalMeshHandle Handle) const
+	{
+		const FSkinnedMeshRuntime_Lf* Runtime = Find(Handle);
+		check(Runtime);
+		return *Runtime;
+	}
+
+	FORCEINLINE int32 Num() const { return Runtimes.Num(); }
+
+	FORCEINLINE FSkinnedMeshRuntime_Lf& GetDense(const int32 DenseIndex) { return Runtimes[DenseIndex]; }
+	FORCEINLINE const FSkinnedMeshRuntime_Lf& GetDense(const int32 DenseIndex) const { return Runtimes[DenseIndex]; }
+
+	FORCEINLINE bool IsVisible(const int32 DenseIndex) const { return VisibleFlags[DenseIndex]; }
+	FORCEINLINE void SetVisible(const int32 DenseIndex, const bool bVisible) { VisibleFlags[DenseIndex] = bVisible; }
+
+	// Refreshes the packed culling sphere and the spatial grid cell,
+	// call it whenever the world space transform of the runtime changes
+	void UpdateCullingBounds(const int32 DenseIndex);
+
+	// Only applied while the store is empty, the grid is not rebuilt
+	void SetSpatialGridCellSize(const double InCellSize);
+
+	void QueryMeshesInRadius(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs, const FVector& Location, const double Radius) const;
+	void QueryMeshesInBox(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs, const FBox& Box) const;
+
+	FORCEINLINE double GetSpatialGridCellSize() const { return SpatialGridCellSize; }
+	FORCEINLINE int32 GetNumSpatialCells() const { return SpatialCells.Num(); }
+	FORCEINLINE const FSpatialGridCell_Lf& GetSpatialCell(const int32 CellIndex) const { return SpatialCells[CellIndex]; }
+	FORCEINLINE bool IsSpatialCellVisible(const int32 CellIndex) const { return SpatialCellVisibleFlags[CellIndex]; }
+	FORCEINLINE void SetSpatialCellVisible(const int32 CellIndex, const bool bVisible) { SpatialCellVisibleFlags[CellIndex] = bVisible; }
+	FORCEINLINE const int32* GetSpatialCellIndices() const { return SpatialCellIndices.GetData(); }
+
+	FORCEINLINE const double* GetCullingCentersX() const { return CullingCentersX.GetData(); }
+	FORCEINLINE const double* GetCullingCentersY() const { return CullingCentersY.GetData(); }
+	FORCEINLINE const double* GetCullingCentersZ() const { return CullingCentersZ.GetData(); }
+	FORCEINLINE const float* GetCullingRadii() const { return CullingRadii.GetData(); }
+
+	// Ranged for over the dense runtimes
+	FORCEINLINE auto begin() { return Runtimes.begin(); }
+	FORCEINLINE auto end() { return Runtimes.end(); }
+	FORCEINLINE auto begin() const { return Runtimes.begin(); }
+	FORCEINLINE auto end() const { return Runtimes.end(); }
+
+private:
+	struct FSlot_Lf
+	{
+		int32 DenseIndex = INDEX_NONE;
+		int32 NextFreeSlot = INDEX_NONE;
+		uint8 Generation = 0;
+	};
+
+	static FORCEINLINE int32 GetSlot(const FBaseSkeletalMeshHandle Handle)
+	{
+		return Handle.MeshID & (MaxSlots - 1);
+	}
+
+	static FORCEINLINE uint8 GetGeneration(const FBaseSkeletalMeshHandle Handle)
+	{
+		return (Handle.MeshID >> NumSlotBits) & ((1 << NumGenerationBits) - 1);
+	}
+
+	FORCEINLINE FIntVector GetSpatialCellCoordinates(const FVector& Location) const
+	{
+		return FIntVector(FMath::FloorToInt32(Location.X / SpatialGridCellSize),
+		                  FMath::FloorToInt32(Location.Y / SpatialGridCellSize),
+		                  FMath::FloorToInt32(Location.Z / SpatialGridCellSize));
+	}
+
+	void AddToSpatialCell(const int32 DenseIndex, const FIntVector& Coordinates);
+	void RemoveFromSpatialCell(const int32 DenseIndex);
+
+	template <typename Predicate>
+	void QueryMeshesInCellRange(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs, const FVector& Min, const FVector& Max,
+	                            const Predicate& IsInside) const;
+
+	TArray<FSlot_Lf> Slots;
+	// Free slots are recycled first in first out, a slot is reused as late as possible which keeps stale handles unique longer
+	int32 FreeSlotHead = INDEX_NONE;
+	int32 FreeSlotTail = INDEX_NONE;
+
+	// Dense, indexed by dense index
+	TArray<FSkinnedMeshRuntime_Lf> Runtimes;
+	TArray<int32> DenseToSlot;
+	TBitArray<> VisibleFlags;
+
+	// Packed culling spheres, SoA so the culling can load several instances per register
+	TArray<double> CullingCentersX;
+	TArray<double> CullingCentersY;
+	TArray<double> CullingCentersZ;
+	TArray<float> CullingRadii;
+
+	// Spatial grid, cells are recycled through a free list so their index stays stable while in use
+	double SpatialGridCellSize = 2000;
+	TArray<FSpatialGridCell_Lf> SpatialCells;
+	TMap<FIntVector, int32> SpatialCellLookup;
+	TArray<int32> FreeSpatialCells;
+	TBitArray<> SpatialCellVisibleFlags;
+	TArray<int32> SpatialCellIndices; // Dense, the cell of the runtime
+	TArray<int32> SpatialCellSlots; // Dense, the position of the runtime inside the meshes of its cell
+};
 
 /*	==============================================================================================================
 												GLOBAL
@@ -365,6 +712,90 @@ struct TURBOSEQUENCE_LF_API FAnimationBlendLayerMask_Lf
 };
 
 
+// Reference data of all mesh assets the bone solve needs, rebuilt on the game thread when the assets or masks change
+struct TURBOSEQUENCE_LF_API FSkinnedMeshReferenceData_Lf
+{
+	// Bumped whenever NumMaxCPUBones, ReferenceNumCPUBones, Indices or CPUInverseReferencePose change
+	uint32 ReferenceDataVersion = 0;
+	int32 NumMaxCPUBones = 0;
+	TArray<int32> ReferenceNumCPUBones;
+	TArray<FVector4f> Indices;
+	TArray<FVector4f> CPUInverseReferencePose;
+
+	// Bumped whenever AnimationLayers change
+	uint32 AnimationLayersVersion = 0;
+	TArray<int32> AnimationLayers;
+
+	// Copies only the parts which are older than in Other
+	void CopyChanged(const FSkinnedMeshReferenceData_Lf& Other)
+	{
+		if (ReferenceDataVersion != Other.ReferenceDataVersion)
+		{
+			ReferenceDataVersion = Other.ReferenceDataVersion;
+			NumMaxCPUBones = Other.NumMaxCPUBones;
+			ReferenceNumCPUBones = Other.ReferenceNumCPUBones;
+			Indices = Other.Indices;
+			CPUInverseReferencePose = Other.CPUInverseReferencePose;
+		}
+		if (AnimationLayersVersion != Other.AnimationLayersVersion)
+		{
+			AnimationLayersVersion = Other.AnimationLayersVersion;
+			AnimationLayers = Other.AnimationLayers;
+		}
+	}
+};
+
+// Immutable input of one bone solve, built by the game thread and handed to the render thread,
+// so the render thread never reads the live game thread library
+struct TURBOSEQUENCE_LF_API FSkinnedMeshFrameSnapshot_Lf
+{
+	int32 NumMeshes = 0;
+	int32 NumCopyOnlyMeshes = 0;
+
+	TArray<int32> PerMeshCustomDataIndex;
+	TArray<int32> PerMeshCustomDataCollectionIndex;
+	TArray<int32> PerMeshResetPreviousRows;
+	TArray<int32> AnimationStartIndex;
+	TArray<int32> AnimationEndIndex;
+	TArray<int32> AnimationFramePose0;
+	TArray<int32> AnimationFramePose1;
+	TArray<int32> AnimationFrameAlpha;
+	TArray<int32> AnimationWeights;
+	TArray<int32> AnimationLayerIndex;
+	TArray<int32> BoneSpaceAnimationIKStartIndex;
+	TArray<int32> BoneSpaceAnimationIKEndIndex;
+	TArray<FVector4f> BoneSpaceAnimationIKInput;
+	TArray<int32> BoneSpaceAnimationIKData;
+
+	// Skeleton and reference index of the copy only meshes, appended behind the solved meshes once the snapshot is built
+	TArray<int32> CopyOnlyCustomDataIndex;
+	TArray<int32> CopyOnlyCustomDataCollectionIndex;
+
+	FSkinnedMeshReferenceData_Lf ReferenceData;
+
+	void ResetFrameData()
+	{
+		NumMeshes = 0;
+		NumCopyOnlyMeshes = 0;
+		CopyOnlyCustomDataIndex.Reset();
+		CopyOnlyCustomDataCollectionIndex.Reset();
+		PerMeshCustomDataIndex.Reset();
+		PerMeshCustomDataCollectionIndex.Reset();
+		PerMeshResetPreviousRows.Reset();
+		AnimationStartIndex.Reset();
+		AnimationEndIndex.Reset();
+		AnimationFramePose0.Reset();
+		AnimationFramePose1.Reset();
+		AnimationFrameAlpha.Reset();
+		AnimationWeights.Reset();
+		AnimationLayerIndex.Reset();
+		BoneSpaceAnimationIKStartIndex.Reset();
+		BoneSpaceAnimationIKEndIndex.Reset();
+		BoneSpaceAnimationIKInput.Reset();
+		BoneSpaceAnimationIKData.Reset();
+	}
+};
+
 USTRUCT()
 struct TURBOSEQUENCE_LF_API FSkinnedMeshGlobalLibrary_RenderThread_Lf
 {
@@ -383,6 +814,56 @@ struct TURBOSEQUENCE_LF_API FSkinnedMeshGlobalLibrary_RenderThread_Lf
 };
 
 
+// Mesh which touches the shared library during the parallel solve, processed in the ordered merge
+struct TURBOSEQUENCE_LF_API FSkinnedMeshDeferredSolve_Lf
+{
+	FSkinnedMeshRuntime_Lf* Runtime = nullptr;
+
+	// Blend spaces can restructure the animation stack through TweakAnimation, so they get solved fully in the merge
+	bool bNeedsFullSolve = false;
+
+	// Includes the time skipped by the animation LOD
+	float DeltaTime = 0;
+};
+
+// Per worker accumulation of the parallel game thread solve, merged in shard order to stay deterministic
+struct TURBOSEQUENCE_LF_API FSkinnedMeshSolveShard_Lf
+{
+	TArray<FSkinnedMeshDeferredSolve_Lf> DeferredMeshes;
+	TArray<FBoneMaskBuiltProxyHandle> ReleasedMasks;
+	TMap<UTurboSequence_RenderData*, FRendererBoundsPartial_Lf> RendererBounds;
+
+	// The last entry counts this band and all further ones
+	static constexpr int32 NumAnimationLODStats = 4;
+
+	uint32 NumVisibleMeshes = 0;
+	uint32 NumMeshesPerAnimationLOD[NumAnimationLODStats] = {};
+	uint32 NumSkippedAnimationUpdates = 0;
+	double SolveTimeSeconds = 0;
+	double CullingTimeSeconds = 0;
+
+	void Reset()
+	{
+		DeferredMeshes.Reset();
+		ReleasedMasks.Reset();
+		RendererBounds.Reset();
+		NumVisibleMeshes = 0;
+		FMemory::Memzero(NumMeshesPerAnimationLOD);
+		NumSkippedAnimationUpdates = 0;
+		SolveTimeSeconds = 0;
+		CullingTimeSeconds = 0;
+	}
+
+	void CountAnimationLOD(const int32 AnimationLODBand, const bool bSkippedUpdate)
+	{
+		if (AnimationLODBand != INDEX_NONE)
+		{
+			NumMeshesPerAnimationLOD[FMath::Min(AnimationLODBand, NumAnimationLODStats - 1)]++;
+		}
+		NumSkippedAnimationUpdates += bSkippedUpdate;
+	}
+};
+
 USTRUCT()
 struct TURBOSEQUENCE_LF_API FSkinnedMeshGlobalLibrary_Lf
 {
@@ -390,8 +871,6 @@ struct TURBOSEQUENCE_LF_API FSkinnedMeshGlobalLibrary_Lf
 
 	FSkinnedMeshGlobalLibrary_Lf() {}
 
-	int32 GlobalMeshCounter = 0; //Used to generate unique FTurboSequenceMeshHandle globally
-
 	UPROPERTY()
 	TMap<FTurboSequenceRenderHandle, UTurboSequence_RenderData*> PerReferenceData;
 	
@@ -402,6 +881,20 @@ struct TURBOSEQUENCE_LF_API FSkinnedMeshGlobalLibrary_Lf
 	TMap<FUintVector, FAnimationLibraryData_Lf> AnimationLibraryData;
 	uint32 AnimationLibraryMaxNum = 0;
 	TArray<FVector4f> AnimationLibraryDataAllocatedThisFrame;
+	TArray<int32> AnimationLibraryIndicesAllocatedThisFrame; // Texture index of each allocated texel
+	// Sized from the animation library texture on the first instance, a bone is 3 texels
+	TSegregatedFitAllocator<3> AnimationLibraryAllocator;
+	int64 AnimationLibraryFrame = 0;
+	int64 LastFailedAnimationLibraryEvictionFrame = INDEX_NONE;
+	bool bWarnedAnimationLibraryFull = false;
+	int32 NumResidentAnimationKeyframes = 0;
+	int32 NumEvictedAnimationKeyframes = 0;
+	// Keyframe samples running on worker threads, committed into KeyframeIndexToPose on the game thread once done
+	TArray<FAnimationKeyframeSample_Lf> PendingKeyframeSamples;
+	int32 NumKeyframeSampleFallbacks = 0;
+	// Copied from the global data every frame, keyframes are sampled on the game thread while it's 0
+	int32 MaxPendingKeyframeSamples = 0;
+	float KeyframePrefetchTime = 0;
 	// // Sum of -> ( Values * Library Hash, Mesh Bones ) is the Keyframe index
 	// // We need this construct to easy determinate the index when we remove an animation from the GPU
 	// // We need an alpha type to copy the new Library Data over
@@ -411,19 +904,56 @@ struct TURBOSEQUENCE_LF_API FSkinnedMeshGlobalLibrary_Lf
 
 	//Masks
 	bool bMasksNeedRebuilding = false;
-	int32 MasksBuiltBoneCount = -1; //Masks are added to AnimationLayers_RenderThread, separated by MaxNumCPUBones, need to rebuild when that changes 
+	int32 MasksBuiltBoneCount = -1; //Masks are added to ReferenceData.AnimationLayers, separated by MaxNumCPUBones, need to rebuild when that changes 
 	TMap<FBoneMaskBuiltProxyHandle, int32> MaskRefCount; //Ref count 
 	TMap<FBoneMaskBuiltProxyHandle, FAnimationBlendLayerMask_Lf> AnimationBlendLayerMasks; //Currently in use built masks 
 
-	TMap<FBoneMaskBuiltProxyHandle, int32> ProxyToIndex; //Order added to AnimationLayers_RenderThread
+	TMap<FBoneMaskBuiltProxyHandle, int32> ProxyToIndex; //Order added to ReferenceData.AnimationLayers
+
+	// Game thread copy of the reference data, handed to the render thread with the frame snapshots
+	FSkinnedMeshReferenceData_Lf ReferenceData;
 	
 	int32 MaxNumCPUBones = 0;
 	int32 MaxNumGPUBones = 0;
 
-	// < MeshID | Index >
-	TMap<FBaseSkeletalMeshHandle, FSkinnedMeshRuntime_Lf> RuntimeSkinnedMeshes; //Skeleton to runtime
+	// < MeshID | Runtime >
+	FSkinnedMeshRuntimeStore_Lf RuntimeSkinnedMeshes; //Skeleton to runtime, also generates the unique mesh handles
+
+	// < Group | Shared Timeline >
+	TMap<FTurboSequence_AnimationGroupHandle_Lf, FSkinnedMeshAnimationGroup_Lf> AnimationGroups;
+	int32 LastAnimationGroupID = 0;
 	
-	TBestFitAllocator<8, 512 * 512 > BoneTextureAllocator;
+	// Sized from the transform texture on the first instance, grows with it by whole array slices
+	TSegregatedFitAllocator<8> BoneTextureAllocator;
+	// Array slices of the transform textures before they grew, the compaction never shrinks below and clean up restores it
+	int32 InitialTransformTextureSlices = 0;
+	float TimeSinceBoneTextureCompaction = 0;
 	
 	bool bRefreshAsyncChunkedMeshData = false;
+
+	// Scratch of the parallel solve, kept around to avoid reallocating every frame
+	TArray<FSkinnedMeshSolveShard_Lf> SolveShards;
+	// Spatial cells plus the slowest culling range of the last solve, the mesh culling is part of the sharded solve
+	double CullingTimeSeconds = 0;
+
+	// Dense, set by the update scheduler when an animation update budget is configured
+	bool bAnimationUpdatesScheduled = false;
+	TBitArray<> ScheduledAnimationUpdates;
+	TArray<TPair<float, int32>> AnimationUpdateCandidates;
+	int32 NumScheduledAnimationUpdates = 0;
+	// Updates per frame fitting into the millisecond budget, adapted from the measured solve time
+	int32 TimedAnimationUpdateBudget = 0;
+
+	// Compact ids of the animation curve names, stable for the lifetime of the library
+	TMap<FName, int32> AnimationCurveIds;
+
+	// Notifies all meshes passed during the last solve, replaced every frame and drained by gameplay
+	TArray<FTurboSequence_AnimNotifyEvent_Lf> AnimNotifyEvents;
+	// Scratch of the parallel notify collection, one array per worker
+	TArray<TArray<FTurboSequence_AnimNotifyEvent_Lf>> AnimNotifyEventShards;
+
+	// Meshes with auto root motion enabled, the pass is skipped while there are none
+	int32 NumAutoRootMotionMeshes = 0;
+	// Dense indices of the meshes moved by auto root motion, one array per worker
+	TArray<TArray<int32>> AutoRootMotionShards;
 };
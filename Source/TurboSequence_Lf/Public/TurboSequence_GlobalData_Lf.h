@@ -37,6 +37,15 @@ public:
 	UPROPERTY(EditAnywhere)
 	FName NameNiagaraParticleScales = FName("User.Particle_Scale");
 
+	UPROPERTY(EditAnywhere)
+	FName NameNiagaraCompactTransforms = FName("User.Particle_CompactTransform");
+
+	UPROPERTY(EditAnywhere)
+	FName NameNiagaraCompactTileOrigin = FName("User.Particle_CompactTileOrigin");
+
+	UPROPERTY(EditAnywhere)
+	FName NameNiagaraCompactPositionStep = FName("User.Particle_CompactPositionStep");
+
 	UPROPERTY(EditAnywhere)
 	FName NameNiagaraFlags = FName("User.Particle_Flags");
 	
@@ -55,5 +64,64 @@ public:
 	UPROPERTY(EditAnywhere)
 	bool bUseHighPrecisionAnimationMode = true;
 
+	// Shards the per mesh game thread solve across task graph workers
+	UPROPERTY(EditAnywhere)
+	bool bUseParallelMeshSolve = true;
+
+	// Below this amount of meshes per worker the solve stays on the game thread, the task overhead would dominate
+	UPROPERTY(EditAnywhere, meta=(ClampMin="1"))
+	int32 ParallelMeshSolveMinBatchSize = 256;
+
+	// Collects the notifies of all meshes once per frame into one event buffer, see ConsumeAnimNotifies
+	UPROPERTY(EditAnywhere)
+	bool bCollectAnimNotifies = false;
+
+	// Edge length of the spatial grid cells used for proximity queries and coarse culling,
+	// only applied while no mesh instance exists
+	UPROPERTY(EditAnywhere, meta=(ClampMin="100"))
+	float SpatialGridCellSize = 2000;
+
+	// Upper limit of animation updates per frame, meshes over the budget are deferred and catch up their time later,
+	// visible, close and long not updated meshes go first, 0 is unlimited
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0"))
+	int32 MaxAnimationUpdatesPerFrame = 0;
+
+	// Game thread time budget of the mesh solve in milliseconds, the update limit adapts to the measured solve time,
+	// 0 is unlimited
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0"))
+	float AnimationUpdateBudgetMs = 0;
+
+	// Upper limit of array slices the transform textures grow to when the bone texture runs full,
+	// every slice costs SizeX * SizeY texels in both textures, 0 never grows
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0", ClampMax="2048"))
+	int32 MaxTransformTextureSlices = 64;
+
+	// Seconds between the bone texture compaction checks, 0 disables the compaction
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0"))
+	float BoneTextureCompactionInterval = 5;
+
+	// Fragmentation of the free bone texture space from 0 to 1 above which the compaction packs all skeletons
+	// into a dense prefix, grown textures are compacted and shrunk as soon as a slice would get free
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0", ClampMax="1"))
+	float BoneTextureCompactionThreshold = 0.3f;
+
+	// Upper limit of live instances per renderer moved into the holes of removed instances each frame,
+	// once an eighth of a renderer is dead it gets packed and shrunk to the live instances, 0 keeps dead instances
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0"))
+	int32 MaxRenderInstanceMovesPerFrame = 256;
+
+	// Samples the keyframes of the animation library on worker threads, an animation reaching a keyframe
+	// which is still sampling shows the nearest resident keyframe meanwhile
+	UPROPERTY(EditAnywhere)
+	bool bAsyncKeyframeSampling = true;
+
+	// Seconds of playback ahead of each animation whose keyframes get sampled before they are reached
+	UPROPERTY(EditAnywhere, meta=(ClampMin="0"))
+	float KeyframePrefetchTime = 0.25f;
+
+	// Upper limit of keyframe samples in flight, keyframes over it are sampled on the game thread when reached
+	UPROPERTY(EditAnywhere, meta=(ClampMin="1"))
+	int32 MaxPendingKeyframeSamples = 64;
+
 	FSettingsComputeShader_Params_Lf CachedMeshDataCreationSettingsParams;
 };
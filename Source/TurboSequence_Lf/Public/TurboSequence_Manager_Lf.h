@@ -6,6 +6,9 @@
 #include "TurboSequence_Data_Lf.h"
 #include "TurboSequence_Manager_Lf.generated.h"
 
+struct FRenderDataLookupCache_Lf;
+struct FTurboSequence_SolveBenchmark_Lf;
+
 USTRUCT(BlueprintType)
 struct FTurboSequence_AttachInfo
 {
@@ -25,6 +28,9 @@ class TURBOSEQUENCE_LF_API ATurboSequence_Manager_Lf : public AActor
 {
 	GENERATED_BODY()
 
+	// Runs the protected solve stages one by one to time them
+	friend FTurboSequence_SolveBenchmark_Lf;
+
 public:
 	// Sets default values for this actor's properties
 	ATurboSequence_Manager_Lf();
@@ -52,6 +58,14 @@ public:
 	FSkinnedMeshGlobalLibrary_Lf GlobalLibrary;
 	// The Global Library which holds all Render Thread Data
 	inline static FSkinnedMeshGlobalLibrary_RenderThread_Lf GlobalLibrary_RenderThread;
+	// Snapshots travel to the render thread inside a render command, so they stay ordered with the library uploads
+	// and bone texture moves of their frame, consumed ones go back to the pool and their arrays get reused
+	inline static TArray<FSkinnedMeshFrameSnapshot_Lf> FrameSnapshotPool;
+	inline static FCriticalSection FrameSnapshotPoolLock;
+	// Render thread, the latest snapshot no solve consumed yet
+	inline static TOptional<FSkinnedMeshFrameSnapshot_Lf> PendingFrameSnapshot_RenderThread;
+	// Game thread, no solve was enqueued after the last published snapshot yet
+	inline static bool bFrameSnapshotAwaitsSolve = false;
 
 	// The Instance
 	inline static TObjectPtr<ATurboSequence_Manager_Lf> Instance;
@@ -72,9 +86,6 @@ protected:
 	// The Current Thread Context, Please Call GetThreadContext()
 	TObjectPtr<UTurboSequence_ThreadContext_Lf> CurrentThreadContext_Runtime;
 
-	//Locked when we are reading the library in the render thread or modifying it in the game thread
-	FCriticalSection RenderThreadDataConsistency; 
-
 public:
 	/**
 	 * Get the Thread Context | Any Thread
@@ -116,6 +127,20 @@ public:
 	                                                                 const FTransform& SpawnTransform,
 	                                                                 UObject* WorldContextObject,
 	                                                                 const TArray<UMaterialInterface*>& OverrideMaterials, FLightingChannels LightingChannels, bool bNewReceivesDecals = false, bool bInRenderInCustomDepth = false, int32 InStencilValue = 0);
+
+	/**
+	 * Adds a mesh instance per spawn transform, validates and looks up the renderer once and pre-sizes the storage
+	 * @param OutMeshIDs The added meshes, in the order of the spawn transforms, shorter when the bone texture runs full
+	 * @return The amount of added meshes
+	 */
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(WorldContext = "WorldContextObject", ReturnDisplayName="Num Added"))
+	static int32 AddSkinnedMeshInstances(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs,
+	                                     UTurboSequence_MeshAsset_Lf* FromAsset,
+	                                     const TArray<FTransform>& SpawnTransforms,
+	                                     UObject* WorldContextObject,
+	                                     const TArray<UMaterialInterface*>& OverrideMaterials, FLightingChannels LightingChannels,
+	                                     bool bNewReceivesDecals = false, bool bInRenderInCustomDepth = false, int32 InStencilValue = 0);
+
 	static void RemoveRenderHandle(
 		const FTurboSequenceRenderHandle RenderHandle,
 		const FAttachmentMeshHandle MeshHandle,
@@ -125,6 +150,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Turbo Sequence")
 	static bool RemoveSkinnedMeshInstance(FBaseSkeletalMeshHandle MeshID);
 
+	// Removes the meshes, the bone counts and reference data get rebuilt once for the whole batch.
+	// Stale or invalid handles are skipped, returns the number of meshes actually removed
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Num Removed"))
+	static int32 RemoveSkinnedMeshInstances(const TArray<FBaseSkeletalMeshHandle>& MeshIDs);
+
 	static bool GetAttachmentComponentSpaceTransform(FTransform& AttachmentComponentSpaceTransform, int32& BoneIndexGPU,
 	                                                 const FName
 	                                                 BoneOrSocketName,
@@ -170,7 +200,61 @@ public:
 
 protected:
 	
-	static void SolveMeshes_GameThread(float DeltaTime, UWorld* InWorld);
+	static void SolveMeshes_GameThread(float DeltaTime, UWorld* InWorld, int64 CurrentFrameCount);
+
+	// Shards the mesh solve over NumWorkers task graph workers and merges their results in shard order
+	static void SolveMeshesParallel_GameThread(float DeltaTime, int64 CurrentFrameCount, int32 NumWorkers);
+
+	static int32 GetNumSolveWorkers(const int32 NumMeshes);
+
+	// Gathers the notifies every mesh passed in this solve into the event buffer, sharded like the mesh solve
+	static void CollectAnimNotifies_GameThread(int64 CurrentFrameCount);
+
+	// Moves the meshes with auto root motion on worker threads, then writes their transforms into the renderers in one go
+	static void ApplyAutoRootMotion_GameThread(int64 CurrentFrameCount);
+
+	// Picks the meshes updating their animations this frame when an update budget is configured,
+	// returns false without a budget, the solve then decides per mesh
+	static bool ScheduleAnimationUpdates_GameThread(float DeltaTime, int64 CurrentFrameCount);
+
+	// Adapts the timed update budget to the measured solve time of this frame
+	static void UpdateAnimationUpdateBudget(double SolveSeconds);
+
+	// Allocates a skeleton in the bone texture, grows the transform textures by array slices while no free range fits,
+	// returns INDEX_NONE when the slice limit is reached
+	static int32 AllocateBoneTextureSkeleton(int32 Size);
+
+	// Resizes both transform textures to NumSlices array slices, the bone texture contents are lost
+	static bool ResizeTransformTextures(int32 NumSlices);
+
+	// Packs all skeletons into a dense prefix of the bone texture when the free space is fragmented
+	// or a grown texture could give back slices
+	static void CompactBoneTexture_GameThread(float DeltaTime);
+
+	// Validates the asset and sets up its renderer and the manager for new instances, null when they can't be added
+	static UTurboSequence_RenderData* PrepareSkinnedMeshInstances(FTurboSequenceRenderHandle& OutRenderHandle,
+	                                                              UTurboSequence_MeshAsset_Lf* FromAsset,
+	                                                              UObject* WorldContextObject,
+	                                                              const TArray<UMaterialInterface*>& OverrideMaterials,
+	                                                              FLightingChannels LightingChannels, bool bNewReceivesDecals,
+	                                                              bool bInRenderInCustomDepth, int32 InStencilValue);
+
+	static FBaseSkeletalMeshHandle AddSkinnedMeshInstance_Internal(UTurboSequence_MeshAsset_Lf* FromAsset,
+	                                                               const FTurboSequenceRenderHandle& RenderHandle,
+	                                                               UTurboSequence_RenderData* RenderData,
+	                                                               const FTransform& SpawnTransform);
+
+	// Leaves refreshing the bone counts to the caller when bRemovedAnySkeleton comes back true
+	static bool RemoveSkinnedMeshInstance_Internal(FBaseSkeletalMeshHandle MeshID, bool& bRemovedAnySkeleton);
+
+	static bool SetMeshWorldSpaceTransform_Internal(FBaseSkeletalMeshHandle MeshID, const FTransform& Transform,
+	                                                FRenderDataLookupCache_Lf& RenderDataCache);
+
+	// Builds the frame snapshot from the game thread library, the render thread only ever reads snapshots
+	static void BuildFrameSnapshot_GameThread();
+
+	// Advances the timeline of every animation group with meshes once and resolves the keyframes of its phases
+	static void SolveAnimationGroups_GameThread(float DeltaTime, int64 CurrentFrameCount);
 
 	static void SolveMeshes_RenderThread(FRHICommandListImmediate& RHICmdList);
 
@@ -190,14 +274,30 @@ public:
 	{
 		LastFrameCameraTransforms.Empty();
 		GlobalLibrary_RenderThread = FSkinnedMeshGlobalLibrary_RenderThread_Lf();
+		PendingFrameSnapshot_RenderThread.Reset();
+		bFrameSnapshotAwaitsSolve = false;
+		FScopeLock Lock(&FrameSnapshotPoolLock);
+		FrameSnapshotPool.Empty();
 	}
 
 	UFUNCTION(BlueprintPure, Category="Turbo Sequence", meta=(ReturnDisplayName="World Space Transform"))
 	static FTransform GetMeshWorldSpaceTransform(FBaseSkeletalMeshHandle MeshID);
 
+	// Collects the meshes whose location lies within the radius, backed by the spatial grid
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Num Meshes"))
+	static int32 QueryMeshesInRadius(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs, const FVector& Location, float Radius);
+
+	// Collects the meshes whose location lies within the box, backed by the spatial grid
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Num Meshes"))
+	static int32 QueryMeshesInBox(TArray<FBaseSkeletalMeshHandle>& OutMeshIDs, const FBox& Box);
+
 	UFUNCTION(BlueprintCallable, Category="Turbo Sequence")
 	static void SetMeshWorldSpaceTransform(FBaseSkeletalMeshHandle MeshID, const FTransform& Transform);
 
+	// Sets the transform of every mesh to the transform at the same index, returns the amount of updated meshes
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Num Updated"))
+	static int32 SetMeshWorldSpaceTransforms(const TArray<FBaseSkeletalMeshHandle>& MeshIDs, const TArray<FTransform>& Transforms);
+
 	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Success"))
 	static bool GetRootMotionTransform(FTransform& OutRootMotion,
 	                                                    FBaseSkeletalMeshHandle MeshID,
@@ -210,6 +310,14 @@ public:
 	                                                    bool ZeroZAxis = false,
 	                                                    bool bIncludeScale = false);
 
+	/**
+	 * Moves the mesh by the root motion of its animations inside the solve, every time they advance,
+	 * so MoveMeshWithRootMotion isn't needed per mesh and frame anymore
+	 */
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence")
+	static void SetAutoRootMotion(FBaseSkeletalMeshHandle MeshID, const bool bInAutoRootMotion,
+	                              const bool ZeroZAxis = false, const bool bIncludeScale = false);
+
 	UFUNCTION(BlueprintCallable, Category="Turbo Sequence",
 		meta=(ReturnDisplayName="Animation Data"))
 	static FTurboSequence_AnimMinimalData_Lf PlayAnimation(const FBaseSkeletalMeshHandle MeshID,
@@ -219,6 +327,14 @@ public:
 	);
 
 
+	// Plays the animation on every mesh, OutAnimations holds the animation data at the index of the mesh
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Num Played"))
+	static int32 PlayAnimationBatch(TArray<FTurboSequence_AnimMinimalData_Lf>& OutAnimations,
+	                                const TArray<FBaseSkeletalMeshHandle>& MeshIDs,
+	                                UAnimSequence* Animation,
+	                                const FTurboSequence_AnimPlaySettings_Lf& AnimSettings,
+	                                const bool bForceLoop = false, const bool bForceFront = false);
+
 	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Blend Space Data"))
 	static FTurboSequence_AnimMinimalBlendSpace_Lf PlayBlendSpace(FBaseSkeletalMeshHandle MeshID,
 		UBlendSpace* BlendSpace,
@@ -230,6 +346,15 @@ public:
 	static UAnimSequence* GetHighestPriorityPlayingAnimation_RawID_Concurrent(FBaseSkeletalMeshHandle MeshID);
 
 	static void GetAnimNotifies(FBaseSkeletalMeshHandle MeshID, FTurboSequence_AnimNotifyQueue_Lf& NotifyQueue);
+
+	/**
+	 * Moves the notifies all meshes passed in the last solve into OutEvents,
+	 * requires bCollectAnimNotifies in the global data
+	 * @param OutEvents The notify events, ordered by mesh
+	 * @return The number of notify events
+	 */
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Num Events"))
+	static int32 ConsumeAnimNotifies(TArray<FTurboSequence_AnimNotifyEvent_Lf>& OutEvents);
 	
 	/**
 	 * Tweaks an Animation with new Settings
@@ -262,6 +387,55 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Turbo Sequence")
 	static void SetAnimationTick(FBaseSkeletalMeshHandle MeshID, const bool bInTickEnabled);
 
+	/**
+	 * Caches the pose of the mesh once per animation solve, so repeated bone and socket queries read it
+	 * instead of blending the animations of every parent bone per query
+	 */
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence")
+	static void SetPoseCacheEnabled(FBaseSkeletalMeshHandle MeshID, const bool bInPoseCacheEnabled);
+
+	/**
+	 * Creates a shared animation timeline, crowds playing the same animations in lock-step advance and
+	 * resolve it once per frame instead of once per mesh
+	 * @param FromAsset The mesh asset of the meshes joining the group
+	 * @return The group, invalid without any mesh instance in the world yet
+	 */
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Animation Group"))
+	static FTurboSequence_AnimationGroupHandle_Lf CreateAnimationGroup(UTurboSequence_MeshAsset_Lf* FromAsset);
+
+	// Removes the group, its meshes go back to their own animations
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Success"))
+	static bool RemoveAnimationGroup(FTurboSequence_AnimationGroupHandle_Lf GroupHandle);
+
+	/**
+	 * Lets a mesh play the timeline of a group instead of its own animations, until it's removed from the group.
+	 * Bone transforms, sockets, root motion, notifies and curves queried on the CPU follow the group timeline
+	 * at the phase of the mesh, its own animations stay untouched and play again once it leaves the group
+	 * @param MeshID The mesh, it has to use the mesh asset of the group
+	 * @param GroupHandle The group
+	 * @param PhaseOffset Offset to the group timeline in keyframes of the animation library,
+	 *					  meshes with the same offset share their animation data on the GPU
+	 * @return True if Successful
+	 */
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Success"))
+	static bool AddMeshToAnimationGroup(FBaseSkeletalMeshHandle MeshID, FTurboSequence_AnimationGroupHandle_Lf GroupHandle,
+	                                    int32 PhaseOffset = 0);
+
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Success"))
+	static bool RemoveMeshFromAnimationGroup(FBaseSkeletalMeshHandle MeshID);
+
+	// Plays an animation on the group timeline, the returned data belongs to no mesh, tweak it with TweakGroupAnimation
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Animation Data"))
+	static FTurboSequence_AnimMinimalData_Lf PlayGroupAnimation(FTurboSequence_AnimationGroupHandle_Lf GroupHandle,
+	                                                            UAnimSequence* Animation,
+	                                                            const FTurboSequence_AnimPlaySettings_Lf& AnimSettings,
+	                                                            const bool bForceLoop = false, const bool bForceFront = false);
+
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Success"))
+	static bool TweakGroupAnimation(FTurboSequence_AnimationGroupHandle_Lf GroupHandle,
+	                                const FTurboSequence_AnimPlaySettings_Lf& TweakSettings,
+	                                const FTurboSequence_AnimMinimalData_Lf& AnimationData);
+
 	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Success"))
 	static bool GetBoneTransform(FTransform& OutIKTransform,
 	                                            FBaseSkeletalMeshHandle MeshID,
@@ -294,6 +468,20 @@ public:
 	static FTurboSequence_PoseCurveData_Lf GetAnimationCurveValue(FBaseSkeletalMeshHandle MeshID,
 		const FName& CurveName,
 		UAnimSequence* Animation);
+
+	// Compact id of an animation curve, resolve it once and pass it to GetCurveValues
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Curve ID"))
+	static int32 GetAnimationCurveId(const FName& CurveName);
+
+	/**
+	 * Samples a curve for every mesh from the baked curve tables, blended by keyframe and animation weight
+	 * @param OutValues One value per mesh ID, 0 for meshes without the curve
+	 * @param MeshIDs The Mesh IDs
+	 * @param CurveId The curve id from GetAnimationCurveId
+	 * @return The number of meshes playing an animation with the curve
+	 */
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Num Found"))
+	static int32 GetCurveValues(TArray<float>& OutValues, const TArray<FBaseSkeletalMeshHandle>& MeshIDs, int32 CurveId);
 	
 
 	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Success"))
@@ -304,6 +492,11 @@ public:
 	static bool SetInstanceCustomDataArray(
 										const FBaseSkeletalMeshHandle MeshID, const int StartIndex,
 										const TArray<float>& Values, const bool bSetAttachments = true); 
+
+	// Sets the custom data at Index of every mesh to the value at the same index, returns the amount of meshes set
+	UFUNCTION(BlueprintCallable, Category="Turbo Sequence", meta=(ReturnDisplayName="Num Set"))
+	static int32 SetInstanceCustomDataBatch(const TArray<FBaseSkeletalMeshHandle>& MeshIDs, const int Index,
+	                                        const TArray<float>& Values, const bool bSetAttachments = true);
 	
 
 
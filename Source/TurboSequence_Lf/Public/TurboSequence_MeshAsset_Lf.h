@@ -7,6 +7,45 @@
 
 class UNiagaraSystem;
 class UTurboSequence_GlobalData_Lf;
+
+USTRUCT(BlueprintType)
+struct TURBOSEQUENCE_LF_API FTurboSequence_AnimationLODBand_Lf
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category="Animation LOD",
+		meta=(ClampMin="0", ToolTip="The band is used up to this distance to the nearest camera"))
+	float MaxDistance = 5000;
+
+	UPROPERTY(EditAnywhere, Category="Animation LOD",
+		meta=(ClampMin="1", ToolTip="The animation advances every N frames, the skipped time is caught up on the next update"))
+	int32 UpdateInterval = 1;
+
+	UPROPERTY(EditAnywhere, Category="Animation LOD",
+		meta=(ClampMin="0", ToolTip="The maximum amount of animations blended on the GPU, the strongest ones are kept, 0 is unlimited"))
+	int32 MaxAnimationLayers = 0;
+};
+
+// Animation library keyframes sampled in the editor, uploaded as they are instead of decompressing the animation
+USTRUCT()
+struct TURBOSEQUENCE_LF_API FTurboSequence_BakedAnimation_Lf
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UAnimSequence> Animation;
+
+	UPROPERTY()
+	int32 NumFrames = 0;
+
+	UPROPERTY()
+	int32 NumBones = 0;
+
+	// NumFrames * NumBones * 3 texels in the layout of the animation library texture
+	UPROPERTY()
+	TArray<FVector4f> Keyframes;
+};
+
 /**
  * 
  */
@@ -43,6 +82,38 @@ public:
 	// Turbo Sequence makes linear Keyframe Reduction, 1 Keyframe happens in this interval, ( Quality | Memory Usage ) <- -> ( Low Memory Usage )
 	float TimeBetweenAnimationLibraryFrames = 0.05f;
 	
+	UPROPERTY(EditAnywhere, Category="Optimization",
+		meta=(ToolTip=
+			"Distance based animation LOD, sorted by Max Distance, meshes further away than the last band use the last band, empty means full rate"
+		))
+	// Distance based animation LOD, sorted by Max Distance, meshes further away than the last band use the last band, empty means full rate
+	TArray<FTurboSequence_AnimationLODBand_Lf> AnimationLODBands;
+
+	UPROPERTY(EditAnywhere, Category="Optimization",
+		meta=(ToolTip=
+			"Animations sampled offline into the animation library of this asset, right click to bake/update, curve values still need runtime sampled animations"
+		))
+	// Animations sampled offline into the animation library of this asset, right click to bake/update
+	TArray<TObjectPtr<UAnimSequence>> AnimationsToBake;
+
+	// Baked by the editor from AnimationsToBake, outdated entries are ignored
+	UPROPERTY()
+	TArray<FTurboSequence_BakedAnimation_Lf> BakedAnimationLibrary;
+
+	UPROPERTY(EditAnywhere, Category="Optimization",
+		meta=(ToolTip=
+			"Sends instance transforms as 16 bytes of fixed point position, smallest three rotation and uniform scale instead of 40 bytes, the Niagara system has to decode them with TS_CompactTransform_Lf.ush"
+		))
+	// Sends instance transforms as 16 bytes of fixed point position, smallest three rotation and uniform scale instead of 40 bytes
+	bool bUseCompactInstanceTransforms = false;
+
+	UPROPERTY(EditAnywhere, Category="Optimization",
+		meta=(ClampMin = "0.01", ClampMax = "10", EditCondition="bUseCompactInstanceTransforms", ToolTip=
+			"World space size of one compact position step in cm, a renderer tile spans 2^21 steps per axis around its origin"
+		))
+	// World space size of one compact position step in cm, a renderer tile spans 2^21 steps per axis around its origin
+	float CompactPositionPrecision = 0.1f;
+
 	UPROPERTY(EditAnywhere, Category="Instance",
 		meta=(ToolTip=
 			"The baked Static Mesh for this asset, right click to bake/update"
@@ -124,10 +195,40 @@ public:
 	
 	bool IsMeshAssetValid() const;
 
+	// Index of the baked keyframes of the animation, INDEX_NONE when it's not baked or the bake is outdated
+	int32 FindBakedAnimation(const UAnimSequence* Animation, int32 NumFrames, int32 NumBones) const;
+
+	// The baked keyframes at BakedAnimationIndex, null when a re-bake moved the animation or the bake is outdated
+	const FTurboSequence_BakedAnimation_Lf* GetBakedAnimation(int32 BakedAnimationIndex, const UAnimSequence* Animation,
+	                                                          int32 NumFrames, int32 NumBones) const;
+
+	// Radius around the pivot enclosing the static mesh bounds, cached for the batched frustum culling,
+	// max float when frustum culling is disabled so the instance is always visible
+	float GetCullingSphereRadius() const
+	{
+		if (CachedCullingSphereRadius < 0)
+		{
+			CachedCullingSphereRadius = TNumericLimits<float>::Max();
+			if (bIsFrustumCullingEnabled && IsValid(StaticMesh))
+			{
+				const FBoxSphereBounds& Bounds = StaticMesh->GetBounds();
+				CachedCullingSphereRadius = Bounds.Origin.Size() + Bounds.SphereRadius;
+			}
+		}
+		return CachedCullingSphereRadius;
+	}
+
 	UFUNCTION()
 	TArray<FString> GetSocketNames() const;
 
 	void PrecachePSOs();
 	
 	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	mutable float CachedCullingSphereRadius = -1;
 };
@@ -177,6 +177,29 @@ FORCEINLINE uint32 GetTypeHash(const FAttachmentMeshHandle& AttachmentMeshHandle
 }
 #endif
 
+// Shared animation timeline, the meshes of a group play its animations instead of their own
+USTRUCT(BlueprintType)
+struct FTurboSequence_AnimationGroupHandle_Lf
+{
+	GENERATED_BODY()
+
+	FTurboSequence_AnimationGroupHandle_Lf() = default;
+
+	explicit FTurboSequence_AnimationGroupHandle_Lf(const int32 InGroupID) : GroupID(InGroupID) {}
+
+	bool IsValid() const { return GroupID != INDEX_NONE; }
+
+	bool operator==(const FTurboSequence_AnimationGroupHandle_Lf& GroupHandle) const = default;
+	bool operator!=(const FTurboSequence_AnimationGroupHandle_Lf& GroupHandle) const = default;
+
+	int32 GroupID = INDEX_NONE;
+};
+
+FORCEINLINE uint32 GetTypeHash(const FTurboSequence_AnimationGroupHandle_Lf& GroupHandle)
+{
+	return GetTypeHash(GroupHandle.GroupID);
+}
+
 
 USTRUCT(BlueprintType)
 struct FTurboSequence_MaskDefinition
@@ -462,4 +485,26 @@ private:
 
 	/** Adds the contents of the NewNotifies array to the DestArray (maintaining uniqueness of notify states*/
 	void AddAnimNotifiesToDestNoFiltering(const TArray<FAnimNotifyEventReference>& NewNotifies, TArray<FAnimNotifyEventReference>& DestArray) const;
-};
\ No newline at end of file
+};
+
+// A notify a mesh passed during the last solve, collected for all meshes in one pass
+USTRUCT(BlueprintType)
+struct TURBOSEQUENCE_LF_API FTurboSequence_AnimNotifyEvent_Lf
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FBaseSkeletalMeshHandle MeshID;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	TObjectPtr<UAnimSequence> Animation = nullptr;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FName NotifyName = NAME_None;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float Weight = 0;
+
+	// Points into the Notifies of Animation, for C++ callers which need the notify object or state
+	const FAnimNotifyEvent* Notify = nullptr;
+};
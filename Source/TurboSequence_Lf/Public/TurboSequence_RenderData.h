@@ -9,9 +9,78 @@
 
 class UNiagaraSystem;
 class UNiagaraComponent;
+class UNiagaraDataInterface;
 class UTurboSequence_MeshAsset_Lf;
 struct FSkinnedMeshRuntime_Lf;
 
+// Renderer bounds gathered away from the render data, e.g. on a solve worker, merged back with MergeRendererBounds
+struct TURBOSEQUENCE_LF_API FRendererBoundsPartial_Lf
+{
+	FVector MinBounds = FVector(TNumericLimits<double>::Max());
+	FVector MaxBounds = FVector(TNumericLimits<double>::Lowest());
+	float MaxScale = 0;
+
+	void Add(const FTransform& WorldSpaceTransform)
+	{
+		const FVector& MeshLocation = WorldSpaceTransform.GetLocation();
+
+		MinBounds = MinBounds.ComponentMin(MeshLocation);
+		MaxBounds = MaxBounds.ComponentMax(MeshLocation);
+		MaxScale = FMath::Max(MaxScale, static_cast<float>(WorldSpaceTransform.GetScale3D().GetAbsMax()));
+	}
+};
+
+// Elements of one Niagara array written since the last upload, so the upload scales with the changes instead of the instance count
+struct TURBOSEQUENCE_LF_API FNiagaraArrayDirtyElements_Lf
+{
+	void MarkDirty(const int32 Index)
+	{
+		if (DirtyFlags.Num() <= Index)
+		{
+			DirtyFlags.Add(false, Index + 1 - DirtyFlags.Num());
+		}
+		if (!DirtyFlags[Index])
+		{
+			DirtyFlags[Index] = true;
+			DirtyIndices.Add(Index);
+		}
+	}
+
+	void Reset()
+	{
+		for (const int32 Index : DirtyIndices)
+		{
+			DirtyFlags[Index] = false;
+		}
+		DirtyIndices.Reset();
+	}
+
+	bool IsDirty() const
+	{
+		return DirtyIndices.Num() > 0;
+	}
+
+	int32 Num() const
+	{
+		return DirtyIndices.Num();
+	}
+
+	// Every partial write looks up the array by name, past an eighth of the array one full write is cheaper
+	bool ShouldUploadAll(const int32 NumElements) const
+	{
+		return DirtyIndices.Num() * 8 > NumElements;
+	}
+
+	const TArray<int32>& GetDirtyIndices() const
+	{
+		return DirtyIndices;
+	}
+
+private:
+	TBitArray<> DirtyFlags;
+	TArray<int32> DirtyIndices;
+};
+
 UCLASS()
 class TURBOSEQUENCE_LF_API UTurboSequence_RenderData : public UObject
 {
@@ -41,6 +110,12 @@ public:
 
 	FString& GetMaterialsName() const;
 
+	FName& GetCompactTransformsName() const;
+
+	FName& GetCompactTileOriginName() const;
+
+	FName& GetCompactPositionStepName() const;
+
 	FName& GetFlagsName() const;
 
 	FName& GetCustomDataName() const;
@@ -56,6 +131,13 @@ public:
 
 	virtual void UpdateNiagaraEmitter();
 
+	// Bytes written through the Niagara array interfaces by the last UpdateNiagaraEmitter, an array interface copies
+	// its whole array to the GPU once any element changed, so the GPU side upload can be larger
+	int32 GetWrittenBytesThisFrame() const
+	{
+		return WrittenBytesThisFrame;
+	}
+
 	void SetEmitterBounds(const FBox& RendererBounds) const;
 
 
@@ -69,6 +151,10 @@ public:
 	
 protected:
 	void UpdateInstanceTransformInternal(int32 InstanceIndex, const FTransform& WorldSpaceTransform, bool bForceUpdate = false);
+	void UpdateCompactTransformInternal(int32 InstanceIndex, const FTransform& WorldSpaceTransform, bool bForceUpdate);
+	void EncodeCompactTransformClamped(int32* OutValues, const FTransform& WorldSpaceTransform);
+	// Moves the tile over the bounds of all instances and Location, false when they don't fit into one tile
+	bool RecenterCompactTile(const FVector& Location);
 
 public:
 	/**
@@ -92,12 +178,28 @@ public:
 	*/
 	void AddRenderInstance(const FAttachmentMeshHandle MeshHandle,
 	                       const FTransform& WorldSpaceTransform, int32 SkeletonIndex);
+
+	/**
+	* @brief Pre-sizes the instance arrays for bulk adds, instances reusing free slots need no room
+	* @param NumAddedInstances
+	*/
+	void ReserveRenderInstances(int32 NumAddedInstances);
+
+	/**
+	* @brief Points an instance to a new skeleton in the bone texture, e.g. after the bone texture got compacted
+	* @param MeshHandle
+	* @param SkeletonIndex
+	* @return false if the instance is not in this renderer
+	*/
+	bool SetSkeletonIndex(const FAttachmentMeshHandle MeshHandle, int32 SkeletonIndex);
 	
 
 
 	void UpdateRendererBounds(
 		const FTransform& WorldSpaceTransform);
 
+	void MergeRendererBounds(const FRendererBoundsPartial_Lf& PartialBounds);
+
 	/**
 	 * Updates the custom data for a specific instance in the skinned mesh reference.
 	 *
@@ -123,11 +225,77 @@ public:
 	void RemoveRenderInstance(
 		FAttachmentMeshHandle Handle);
 
+	/**
+	 * @brief Moves live instances from the end of the arrays into the holes removed instances left behind,
+	 * the arrays shrink to the live instances once every hole is filled, so Niagara only iterates live particles
+	 * @param MaxMoves Upper limit of moved instances, spreads the compaction over frames, 0 disables it
+	 * @return The amount of moved instances
+	 */
+	int32 CompactRenderInstances(int32 MaxMoves);
+
 	const FVector& GetMeshMinBounds() const {return MeshMinBounds;}
 	const FVector& GetMeshMaxBounds() const {return MeshMaxBounds;}
 
 protected:
 	void SetGPUBoneIndexForInstanceInternal(uint8 BoneIndex, int Index);
+
+	// Copies every per instance value, renderers with more instance arrays move those as well
+	virtual void MoveRenderInstanceInternal(int32 FromIndex, int32 ToIndex);
+	virtual void ShrinkRenderInstancesInternal(int32 NumInstances);
+
+	// One name lookup of the array interface, done once per uploaded array instead of once per written element
+	UNiagaraDataInterface* FindNiagaraArrayInterface(UClass* ArrayInterfaceClass, const FName& ArrayName) const;
+
+	/**
+	 * Writes the dirty elements of one Niagara array, or the whole array after a resize or when most of it changed.
+	 *
+	 * @tparam ArrayInterfaceType The Niagara array data interface behind ArrayName
+	 * @param DirtyElements The changed elements, reset afterwards
+	 * @param Array The CPU copy of the Niagara array
+	 * @param ArrayName The user parameter of the array interface
+	 * @param bUploadAll Writes the whole array, e.g. when the instance count changed
+	 * @param NiagaraElementSize The size of one element on the Niagara side
+	 *
+	 * @return The bytes written through the array interface
+	 *
+	 * @throws None
+	 */
+	template <typename ArrayInterfaceType, typename ElementType>
+	int32 UploadNiagaraArray(FNiagaraArrayDirtyElements_Lf& DirtyElements, const TArray<ElementType>& Array,
+	                         const FName& ArrayName, const bool bUploadAll, const int32 NiagaraElementSize) const
+	{
+		if (!bUploadAll && !DirtyElements.IsDirty())
+		{
+			return 0;
+		}
+
+		ArrayInterfaceType* ArrayInterface = Cast<ArrayInterfaceType>(
+			FindNiagaraArrayInterface(ArrayInterfaceType::StaticClass(), ArrayName));
+		if (!ArrayInterface)
+		{
+			DirtyElements.Reset();
+			return 0;
+		}
+
+		int32 NumUploadedElements;
+		if (bUploadAll || DirtyElements.ShouldUploadAll(Array.Num()))
+		{
+			ArrayInterface->SetVariantArrayData(MakeArrayView(Array));
+			NumUploadedElements = Array.Num();
+		}
+		else
+		{
+			for (const int32 Index : DirtyElements.GetDirtyIndices())
+			{
+				ArrayInterface->SetVariantArrayValue(Index, Array[Index], false);
+			}
+			NumUploadedElements = DirtyElements.Num();
+		}
+		DirtyElements.Reset();
+
+		return NumUploadedElements * NiagaraElementSize;
+	}
+
 	static void Init(UTurboSequence_MeshAsset_Lf* InMeshAsset,
 	                 UTurboSequence_RenderData* TurboSequenceRenderData, const FVector& MeshMinBounds, const FVector& MeshMaxBounds);
 
@@ -142,6 +310,8 @@ private:
 
 	TArray<int32> FreeList;
 
+	TArray<FAttachmentMeshHandle> InstanceHandles; // < Renderer Instance Index | MeshID >, invalid for removed instances
+
 	// Transform
 	TArray<FVector> ParticlePositions;
 	TArray<FVector3f> ParticleScales;
@@ -155,6 +325,16 @@ private:
 	// Custom Data
 	TArray<float> ParticleCustomData;
 
+	// Compact Transform, replaces positions, rotations and scales, see FTurboSequence_Helper_Lf::EncodeCompactTransform
+	bool bUseCompactTransforms = false;
+	TArray<int32> CompactTransforms;
+	FVector CompactTileOrigin = FVector::ZeroVector;
+	double CompactPositionStep = 0.1;
+	bool bChangedCompactTileThisFrame = false;
+	bool bWarnedCompactTileRange = false;
+	// Every failed recenter scans all instances, until the next frame the out of range instances get clamped right away
+	uint64 LastFailedCompactTileRecenterFrame = MAX_uint64;
+
 	// Bounds Checking
 	FVector MinBounds = FVector(TNumericLimits<double>::Max());
 	FVector MaxBounds = FVector(TNumericLimits<double>::Lowest());
@@ -162,15 +342,18 @@ private:
 	FVector MeshMinBounds;
 	FVector MeshMaxBounds;
 	
-	bool bChangedPositionCollectionThisFrame = false;
-	bool bChangedRotationCollectionThisFrame = false;
-	bool bChangedScaleCollectionThisFrame = false;
-	bool bChangedFlagsCollectionThisFrame = false;
-	bool bChangedCustomDataCollectionThisFrame = false;
-	bool bChangedSkeletonIndexesThisFrame = false;
+	FNiagaraArrayDirtyElements_Lf DirtyPositions;
+	FNiagaraArrayDirtyElements_Lf DirtyRotations;
+	FNiagaraArrayDirtyElements_Lf DirtyScales;
+	FNiagaraArrayDirtyElements_Lf DirtyFlags;
+	FNiagaraArrayDirtyElements_Lf DirtyCustomData;
+	FNiagaraArrayDirtyElements_Lf DirtySkeletonIndexes;
+	FNiagaraArrayDirtyElements_Lf DirtyCompactTransforms;
 
 protected:
 
 	bool bChangedCollectionSizeThisFrame = false;
+
+	int32 WrittenBytesThisFrame = 0;
 	
 };
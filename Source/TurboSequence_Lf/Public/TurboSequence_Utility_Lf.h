@@ -72,28 +72,84 @@ public:
 	                            const TArray<FCameraView_Lf>& CameraViews);
 
 	/**
- * Determines if a skinned mesh is visible to any of the player cameras.
- *
- * @param Runtime The runtime data of the skinned mesh.
- * @param PlayerViews An array of camera views representing the player's perspective.
- *
- * @return void
- *
- * @throws None
- */
-	static bool IsMeshVisible(const FSkinnedMeshRuntime_Lf& Runtime,
-	                          const TArray<FCameraView_Lf>& PlayerViews);
+	 * Rotates the object space frustum planes of a camera view into world orientation for the batched culling,
+	 * requires Planes_Internal and InterpolatedCameraTransform_Internal to be up to date.
+	 *
+	 * @param View The camera view to update.
+	 *
+	 * @throws None
+	 */
+	static void UpdateCullingPlanes(FCameraView_Lf& View);
+
 	/**
-	 * Refreshes asynchronous chunked mesh data based on the provided global data and libraries.
+	 * Picks the animation LOD band of the mesh by the distance to the nearest camera and decides
+	 * if the animations are due this frame, updates of a band are spread evenly over its interval.
+	 * The DeltaTime is added to the pending time of the runtime, consume it when solving.
+	 *
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param PlayerViews An array of camera views representing the player's perspective.
+	 * @param DeltaTime The time passed since the last frame.
+	 * @param CurrentFrameCount The current frame count.
+	 * @param OutCameraDistance The distance to the nearest camera.
+	 *
+	 * @return True if the animations are due this frame.
+	 *
+	 * @throws None
+	 */
+	static bool UpdateAnimationLOD(FSkinnedMeshRuntime_Lf& Runtime,
+	                               const TArray<FCameraView_Lf>& PlayerViews,
+	                               const float DeltaTime, const int64 CurrentFrameCount,
+	                               double& OutCameraDistance);
+
+	/**
+	 * Collects the animations blended on the GPU, capped by the max animation layers of the LOD band.
+	 * The strongest animations are kept in their original order and the weight of the dropped ones is
+	 * handed to them through the weight scale.
+	 *
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param OutAnimationIndices The indices into the animation meta data to blend.
+	 * @param OutWeightScale The factor applied to the weights of the kept animations.
+	 *
+	 * @throws None
+	 */
+	static void GetBlendedAnimations(const FSkinnedMeshRuntime_Lf& Runtime,
+	                                 TArray<int32, TInlineAllocator<8>>& OutAnimationIndices,
+	                                 float& OutWeightScale);
+
+	/**
+	 * Culls the loose bounds of every used spatial grid cell against all camera views,
+	 * meshes inside a culled cell skip their own tests in CullMeshes. Run it before CullMeshes.
+	 *
+	 * @param Store The runtime store holding the spatial grid.
+	 * @param PlayerViews An array of camera views representing the player's perspective.
+	 *
+	 * @throws None
+	 */
+	static void CullSpatialCells(FSkinnedMeshRuntimeStore_Lf& Store,
+	                             const TArray<FCameraView_Lf>& PlayerViews);
+
+	/**
+	 * Culls a dense range of the runtime store against all camera views, four instances at a time
+	 * with SIMD sphere versus frustum tests, and writes the visibility bits of the store.
+	 *
+	 * @param Store The runtime store holding the packed culling spheres.
+	 * @param PlayerViews An array of camera views representing the player's perspective.
+	 * @param StartIndex The first dense index to cull.
+	 * @param EndIndex The dense index after the last one to cull.
+	 *
+	 * @throws None
+	 */
+	static void CullMeshes(FSkinnedMeshRuntimeStore_Lf& Store,
+	                       const TArray<FCameraView_Lf>& PlayerViews,
+	                       const int32 StartIndex, const int32 EndIndex);
+	/**
+	 * Rebuilds the reference data of the library and bumps its version, so the next frame snapshots carry it.
 	 *
 	 * @param Library The global library containing the mesh data to refresh.
-	 * @param Library_RenderThread The render thread library containing the mesh data to refresh.
 	 *
 	 * @throws None
 	 */
-	static void RefreshAsyncChunkedMeshData(
-		FSkinnedMeshGlobalLibrary_Lf& Library,
-		FSkinnedMeshGlobalLibrary_RenderThread_Lf& Library_RenderThread);
+	static void RefreshAsyncChunkedMeshData(FSkinnedMeshGlobalLibrary_Lf& Library);
 	/**
 	 * Creates maximum level of details and CPU bones for the provided global library.
 	 *
@@ -105,26 +161,79 @@ public:
 	 */
 	static void UpdateMaxBones(FSkinnedMeshGlobalLibrary_Lf& Library);
 	/**
-	 * Creates bone maps for the given skinned mesh global library and render thread library.
+	 * Creates bone maps for the given skinned mesh global library inside its reference data.
 	 *
 	 * @param Library The skinned mesh global library to create bone maps for.
-	 * @param Library_RenderThread The skinned mesh render thread library to create bone maps for.
 	 *
 	 * @throws None
 	 */
-	static void CreateBoneMaps(FSkinnedMeshGlobalLibrary_Lf& Library,
-	                           FSkinnedMeshGlobalLibrary_RenderThread_Lf& Library_RenderThread);
+	static void CreateBoneMaps(FSkinnedMeshGlobalLibrary_Lf& Library);
 
 	/**
-	 * Creates the inverse reference pose for a given skinned mesh global library and render thread library.
+	 * Creates the inverse reference pose for a given skinned mesh global library inside its reference data.
 	 *
 	 * @param Library The skinned mesh global library to create the inverse reference pose for.
-	 * @param Library_RenderThread The skinned mesh render thread library to create the inverse reference pose for.
 	 *
 	 * @throws None
 	 */
-	static void CreateInverseReferencePose(FSkinnedMeshGlobalLibrary_Lf& Library,
-	                                       FSkinnedMeshGlobalLibrary_RenderThread_Lf& Library_RenderThread);
+	static void CreateInverseReferencePose(FSkinnedMeshGlobalLibrary_Lf& Library);
+
+	/**
+	 * Sets up the pose evaluation of an animation for the library and maps the mesh bones to the animation bones.
+	 *
+	 * @param LibraryAnimData The library data of the animation.
+	 * @param Asset The mesh asset the animation plays on.
+	 * @param Animation The animation to evaluate.
+	 *
+	 * @throws None
+	 */
+	static void InitializeAnimationPoseData(FAnimationLibraryData_Lf& LibraryAnimData,
+	                                        const UTurboSequence_MeshAsset_Lf* Asset, const UAnimSequence* Animation);
+
+	// Keyframes of an animation in the library, one every TimeBetweenAnimationLibraryFrames of the asset
+	static int32 GetAnimationLibraryMaxFrames(const UAnimSequence* Animation, const UTurboSequence_MeshAsset_Lf* Asset);
+
+	// Animation time of a library keyframe
+	static float GetAnimationLibraryFrameTime(const int32 CPUIndex, const int32 MaxFrames, const UAnimSequence* Animation);
+
+	/**
+	 * Samples all library keyframes of an animation on the mesh asset, the way the runtime library would.
+	 *
+	 * @param OutBakedAnimation The keyframes in library texel layout.
+	 * @param Asset The mesh asset the animation plays on.
+	 * @param Animation The animation to bake.
+	 *
+	 * @return Success.
+	 *
+	 * @throws None
+	 */
+	static bool BakeAnimation(FTurboSequence_BakedAnimation_Lf& OutBakedAnimation,
+	                          const UTurboSequence_MeshAsset_Lf* Asset, UAnimSequence* Animation);
+
+	/**
+	 * Allocates a keyframe in the animation library texture, evicts the least recently used keyframes when it's full.
+	 *
+	 * @param Library The skinned mesh global library owning the animation library.
+	 * @param Size The texels of the keyframe, 3 per bone.
+	 *
+	 * @return The texture index of the keyframe, INDEX_NONE when every keyframe is in use.
+	 *
+	 * @throws None
+	 */
+	static int32 AllocateAnimationLibraryKeyframe(FSkinnedMeshGlobalLibrary_Lf& Library, const int32 Size);
+
+	/**
+	 * Evicts keyframes no mesh references anymore from the animation library, least recently used first,
+	 * until a keyframe of the given size fits. Keyframes used this frame and the rest poses stay resident.
+	 *
+	 * @param Library The skinned mesh global library owning the animation library.
+	 * @param Size The texels which have to fit afterward.
+	 *
+	 * @return True if a keyframe of the size fits now.
+	 *
+	 * @throws None
+	 */
+	static bool EvictAnimationLibraryKeyframes(FSkinnedMeshGlobalLibrary_Lf& Library, const int32 Size);
 
 	/**
 	 * Adds a pose to the chunked library with multi-threading support.
@@ -136,7 +245,8 @@ public:
 	 * @param ReferenceSkeleton The ReferenceSkeleton of the animation to add.
 	 * @param AnimationSkeleton The AnimationSkeleton of the animation to add.
 	 *
-	 * @return Success.
+	 * @return The texture index of the keyframe, or of the nearest resident keyframe standing in for it,
+	 *         INDEX_NONE when the library is full and the animation has no resident keyframe.
 	 *
 	 * @throws None
 	 */
@@ -148,6 +258,82 @@ public:
 	                                              const FReferenceSkeleton& ReferenceSkeleton,
 	                                              const FReferenceSkeleton& AnimationSkeleton);
 
+	/**
+	 * Starts sampling the pose of a library keyframe on a worker thread.
+	 *
+	 * @param Library The skinned mesh global library owning the pending samples.
+	 * @param LibraryAnimData The library data of the animation.
+	 * @param Animation The metadata of the animation to sample.
+	 * @param CPUIndex The keyframe to sample.
+	 *
+	 * @return True if the keyframe is sampling now, false when async sampling is off or too many samples are in flight.
+	 *
+	 * @throws None
+	 */
+	static bool RequestKeyframeSample(FSkinnedMeshGlobalLibrary_Lf& Library,
+	                                  FAnimationLibraryData_Lf& LibraryAnimData,
+	                                  const FAnimationMetaData_Lf& Animation,
+	                                  const int32 CPUIndex);
+
+	/**
+	 * Predicts the keyframes an animation reaches within the prefetch time from its speed and play direction.
+	 *
+	 * @param OutKeyframes The predicted keyframes which have no pose yet and are not sampling.
+	 * @param Library The skinned mesh global library.
+	 * @param LibraryAnimData The library data of the animation.
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param Animation The metadata of the playing animation.
+	 * @param CPUIndex0 The keyframe the animation blends from.
+	 * @param CPUIndex1 The keyframe the animation blends to.
+	 *
+	 * @throws None
+	 */
+	static void GetKeyframesToPrefetch(TArray<int32, TInlineAllocator<8>>& OutKeyframes,
+	                                   const FSkinnedMeshGlobalLibrary_Lf& Library,
+	                                   const FAnimationLibraryData_Lf& LibraryAnimData,
+	                                   const FSkinnedMeshRuntime_Lf& Runtime,
+	                                   const FAnimationMetaData_Lf& Animation,
+	                                   const int32 CPUIndex0, const int32 CPUIndex1);
+
+	/**
+	 * Finds the resident keyframe of an animation closest to a keyframe which isn't resident.
+	 *
+	 * @param LibraryAnimData The library data of the animation.
+	 * @param CPUIndex The keyframe which isn't resident.
+	 *
+	 * @return The keyframe index of the closest resident keyframe, INDEX_NONE if the animation has none.
+	 *
+	 * @throws None
+	 */
+	static int32 FindNearestResidentKeyframe(const FAnimationLibraryData_Lf& LibraryAnimData, const int32 CPUIndex);
+
+	/**
+	 * Moves the poses of finished keyframe samples into the library, call it on the game thread before the solve.
+	 *
+	 * @param Library The skinned mesh global library owning the pending samples.
+	 *
+	 * @throws None
+	 */
+	static void CommitKeyframeSamples(FSkinnedMeshGlobalLibrary_Lf& Library);
+
+	/**
+	 * Requests samples for the keyframes an animation reaches next, so they are ready once it gets there.
+	 *
+	 * @param Library The skinned mesh global library owning the pending samples.
+	 * @param LibraryAnimData The library data of the animation.
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param Animation The metadata of the playing animation.
+	 * @param CPUIndex0 The keyframe the animation blends from.
+	 * @param CPUIndex1 The keyframe the animation blends to.
+	 *
+	 * @throws None
+	 */
+	static void PrefetchKeyframes(FSkinnedMeshGlobalLibrary_Lf& Library,
+	                              FAnimationLibraryData_Lf& LibraryAnimData,
+	                              const FSkinnedMeshRuntime_Lf& Runtime,
+	                              const FAnimationMetaData_Lf& Animation,
+	                              const int32 CPUIndex0, const int32 CPUIndex1);
+
 	/**
 	 * Adds an animation to the chunked library with multi-threading support.
 	 *
@@ -236,6 +422,32 @@ public:
 	static void RemoveAnimation(FSkinnedMeshRuntime_Lf& Runtime,
 	                            FSkinnedMeshGlobalLibrary_Lf& Library,
 	                            const int32 Index);
+
+	/**
+	 * Increments the reference count of a built bone mask and generates the mask when it's not in use yet.
+	 *
+	 * @param Library The global library of skinned meshes.
+	 * @param BoneMaskBuiltProxyHandle The built mask handle of the added animation.
+	 * @param MaskDefinition The mask definition to generate the mask from.
+	 * @param DataAsset The mesh asset the mask is built for.
+	 *
+	 * @throws None
+	 */
+	static void AcquireAnimationMask(FSkinnedMeshGlobalLibrary_Lf& Library,
+	                                 const FBoneMaskBuiltProxyHandle& BoneMaskBuiltProxyHandle,
+	                                 const FTurboSequence_MaskDefinition& MaskDefinition,
+	                                 const TObjectPtr<UTurboSequence_MeshAsset_Lf>& DataAsset);
+
+	/**
+	 * Decrements the reference count of a built bone mask and removes the mask once it is unused.
+	 *
+	 * @param Library The global library of skinned meshes.
+	 * @param BoneMaskBuiltProxyHandle The built mask handle of the removed animation.
+	 *
+	 * @throws None
+	 */
+	static void ReleaseAnimationMask(FSkinnedMeshGlobalLibrary_Lf& Library,
+	                                 const FBoneMaskBuiltProxyHandle& BoneMaskBuiltProxyHandle);
 	/**
 	 * Clears animations from the given skinned mesh runtime based on a condition.
 	 *
@@ -410,7 +622,129 @@ public:
 	                            const float DeltaTime,
 	                            const int64 CurrentFrameCount);
 
-	static void GetAnimNotifies(const FSkinnedMeshRuntime_Lf& Runtime, FTurboSequence_AnimNotifyQueue_Lf& NotifyQueue);
+	/**
+	 * Solves animations for a given skinned mesh runtime without writing into the global library,
+	 * safe to call for different runtimes on multiple threads at the same time.
+	 *
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param Library The global library of skinned meshes, only read.
+	 * @param DeltaTime The time elapsed since the last update.
+	 * @param CurrentFrameCount The current frame count.
+	 * @param OutReleasedMasks The masks of removed animations, release them later with ReleaseAnimationMask.
+	 *
+	 * @return True if the animations need keyframes which are not in the library yet,
+	 *         call ResolveAnimationsInLibrary on the game thread afterwards.
+	 *
+	 * @throws None
+	 */
+	static bool SolveAnimations_Concurrent(FSkinnedMeshRuntime_Lf& Runtime,
+	                                       const FSkinnedMeshGlobalLibrary_Lf& Library,
+	                                       const float DeltaTime,
+	                                       const int64 CurrentFrameCount,
+	                                       TArray<FBoneMaskBuiltProxyHandle>& OutReleasedMasks);
+
+	/**
+	 * Advances time and weights of all animations of a skinned mesh runtime and removes finished ones.
+	 *
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param DeltaTime The time elapsed since the last update.
+	 * @param OutReleasedMasks The masks of removed animations, release them later with ReleaseAnimationMask.
+	 *
+	 * @throws None
+	 */
+	static void AdvanceAnimations(FSkinnedMeshRuntime_Lf& Runtime, const float DeltaTime,
+	                              TArray<FBoneMaskBuiltProxyHandle>& OutReleasedMasks);
+
+	/**
+	 * Resolves the frame indices of all animations of a skinned mesh runtime, adding missing keyframes to the library.
+	 *
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param Library The global library of skinned meshes.
+	 *
+	 * @throws None
+	 */
+	static void ResolveAnimationsInLibrary(FSkinnedMeshRuntime_Lf& Runtime, FSkinnedMeshGlobalLibrary_Lf& Library);
+
+	/**
+	 * Copies the solved timeline animations of an animation group into a phase, moves them by the phase offset
+	 * in whole keyframes and resolves their frame indices in the library.
+	 *
+	 * @param Group The animation group with its timeline solved this frame.
+	 * @param Phase The phase of the group to resolve.
+	 * @param Library The global library of skinned meshes.
+	 *
+	 * @throws None
+	 */
+	static void ResolveAnimationGroupPhase(FSkinnedMeshAnimationGroup_Lf& Group,
+	                                       FSkinnedMeshAnimationGroupPhase_Lf& Phase,
+	                                       FSkinnedMeshGlobalLibrary_Lf& Library);
+
+	/**
+	 * Resolves the frame indices of an animation from keyframes already in the library without modifying it.
+	 *
+	 * @param Library The global library of skinned meshes, only read.
+	 * @param CPUIndex0 The index for the CPU Frame before.
+	 * @param GPUIndex0 The index for the GPU Frame before.
+	 * @param CPUIndex1 The index for the CPU Frame after.
+	 * @param GPUIndex1 The index for the GPU Frame after.
+	 * @param FrameAlpha The alpha between the frames.
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param Animation The animation to resolve.
+	 *
+	 * @return False if the library has to be written, use AddAnimationToLibraryChunked in that case.
+	 *
+	 * @throws None
+	 */
+	static bool ResolveAnimationFromLibrary_Concurrent(const FSkinnedMeshGlobalLibrary_Lf& Library,
+	                                                   int32& CPUIndex0,
+	                                                   int32& GPUIndex0,
+	                                                   int32& CPUIndex1, int32& GPUIndex1, float& FrameAlpha,
+	                                                   const FSkinnedMeshRuntime_Lf& Runtime,
+	                                                   const FAnimationMetaData_Lf& Animation);
+
+	/**
+	 * Sorts the notifies of the animation into the notify timelines of its library data.
+	 *
+	 * @param LibraryAnimData The library data of the animation.
+	 * @param Animation The animation sequence holding the notifies.
+	 *
+	 * @throws None
+	 */
+	static void BuildNotifyTimeline(FAnimationLibraryData_Lf& LibraryAnimData, const UAnimSequence* Animation);
+
+	/**
+	 * Finds the notifies an animation passed during its last advance on the notify timelines, safe to call from any thread.
+	 *
+	 * @param OutNotifies The passed notifies, they point into the Notifies of the animation sequence.
+	 * @param Animation The animation metadata.
+	 * @param Library The global library holding the notify timelines.
+	 * @param PhaseOffset Keyframes the animation is shifted by, for meshes of an animation group.
+	 *
+	 * @throws None
+	 */
+	static void GetAnimationNotifies(TArray<const FAnimNotifyEvent*, TInlineAllocator<8>>& OutNotifies,
+	                                 const FAnimationMetaData_Lf& Animation,
+	                                 const FSkinnedMeshGlobalLibrary_Lf& Library, int32 PhaseOffset);
+
+	static void GetAnimNotifies(const FSkinnedMeshRuntime_Lf& Runtime, const FSkinnedMeshGlobalLibrary_Lf& Library,
+	                            FTurboSequence_AnimNotifyQueue_Lf& NotifyQueue);
+
+	/**
+	 * Appends the notifies the mesh passed in the solve of this frame to the event buffer, filtered by their
+	 * trigger weight threshold and chance.
+	 *
+	 * @param OutEvents The event buffer of the calling worker.
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param Library The global library holding the notify timelines and animation groups.
+	 * @param CurrentFrameCount Meshes which did not solve in this frame passed no notify.
+	 * @param RandomStream Rolls the trigger chance, one per worker.
+	 *
+	 * @throws None
+	 */
+	static void CollectAnimNotifies(TArray<FTurboSequence_AnimNotifyEvent_Lf>& OutEvents,
+	                                const FSkinnedMeshRuntime_Lf& Runtime,
+	                                const FSkinnedMeshGlobalLibrary_Lf& Library, int64 CurrentFrameCount,
+	                                FRandomStream& RandomStream);
 	
 	/**
 	 * Returns a FUintVector containing the hashed values of the given USkeleton, UTurboSequence_MeshAsset_Lf,
@@ -519,6 +853,19 @@ public:
 		uint16 SkeletonBoneIndex,
 		const FSkinnedMeshGlobalLibrary_Lf& Library, const FReferenceSkeleton& ReferenceSkeleton);
 
+	/**
+* Decomposes the bone space matrix of a keyframe bone into the rotation, translation and scale arrays of the CPU blends.
+*
+* @param LibraryAnimData The library data of the animation.
+* @param CPUIndex The keyframe index.
+* @param BoneIndex The index of the bone in the reference skeleton.
+* @param Colums The 3 texels of the bone as they are written to the animation library.
+*
+* @throws None
+*/
+	static void DecomposeKeyframeBone(FAnimationLibraryData_Lf& LibraryAnimData, int32 CPUIndex, uint16 BoneIndex,
+	                                  const FVector4f* Colums);
+
 	static void PrintAnimsToScreen(const FSkinnedMeshRuntime_Lf& Runtime);
 
 	/**
@@ -540,6 +887,7 @@ public:
 *
 * @param OutAtom The output atom to store the extracted root motion.
 * @param Runtime The runtime data of the skinned mesh.
+* @param Library The global library holding the root motion tracks.
 * @param DeltaTime The time elapsed since the last update.
 *
 * @return None
@@ -548,8 +896,34 @@ public:
 */
 	static void ExtractRootMotionFromAnimations(FTransform& OutAtom,
 	                                            const FSkinnedMeshRuntime_Lf& Runtime,
+	                                            const FSkinnedMeshGlobalLibrary_Lf& Library,
 	                                            float DeltaTime);
 
+	/**
+	 * Caches the root motion of the animation at every keyframe of its library data.
+	 *
+	 * @param LibraryAnimData The library data of the animation, its MaxFrames need to be set.
+	 * @param Animation The animation sequence.
+	 *
+	 * @throws None
+	 */
+	static void BakeRootMotionTrack(FAnimationLibraryData_Lf& LibraryAnimData, const UAnimSequence* Animation);
+
+	/**
+	 * Blends the root motion the animations of the mesh played in the solve of this frame, from the cached tracks.
+	 *
+	 * @param OutRootMotion The root motion in component space.
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param Library The global library holding the root motion tracks and animation groups.
+	 * @param CurrentFrameCount Meshes which did not solve in this frame played no root motion.
+	 *
+	 * @return True if any animation played root motion.
+	 *
+	 * @throws None
+	 */
+	static bool GetSolvedRootMotion(FTransform& OutRootMotion, const FSkinnedMeshRuntime_Lf& Runtime,
+	                                const FSkinnedMeshGlobalLibrary_Lf& Library, int64 CurrentFrameCount);
+
 
 	/**
 	 * 
@@ -582,6 +956,34 @@ public:
 	                             const FSkinnedMeshGlobalLibrary_Lf& Library,
 	                             const EBoneSpaces::Type Space);
 	/**
+* Reads the blended bone space transform of a bone from the pose cache, blends it on the first read after a solve.
+*
+* @param BoneIndex The index of the bone.
+* @param Runtime The skinned mesh runtime data.
+* @param Library The global library of skinned meshes.
+*
+* @return The bone space transform from the animations, override bones are not applied.
+*
+* @throws None
+*/
+	static const FTransform& GetCachedLocalBoneTransform(int32 BoneIndex,
+	                                                     const FSkinnedMeshRuntime_Lf& Runtime,
+	                                                     const FSkinnedMeshGlobalLibrary_Lf& Library);
+	/**
+* Reads the component space transform of a bone from the pose cache, fills it and its missing parents root first.
+*
+* @param BoneIndex The index of the bone.
+* @param Runtime The skinned mesh runtime data.
+* @param Library The global library of skinned meshes.
+*
+* @return The component space transform, the same GetBoneTransform computes without the cache.
+*
+* @throws None
+*/
+	static const FTransform& GetCachedComponentBoneTransform(int32 BoneIndex,
+	                                                         const FSkinnedMeshRuntime_Lf& Runtime,
+	                                                         const FSkinnedMeshGlobalLibrary_Lf& Library);
+	/**
 * Sets the IK transform for a bone in the skinned mesh runtime.
 *
 * @param Atom The transform to set.
@@ -599,6 +1001,51 @@ public:
 
 	static bool RemoveOverrideBoneTransform(int32 BoneIndex, FSkinnedMeshRuntime_Lf& Runtime);
 
+	/**
+	 * Bakes the float curves of the animation into the curve table of its library data, one value per keyframe.
+	 *
+	 * @param Library The global library holding the curve ids.
+	 * @param LibraryAnimData The library data of the animation, its MaxFrames need to be set.
+	 * @param Animation The animation sequence holding the curves.
+	 *
+	 * @throws None
+	 */
+	static void BakeAnimationCurves(FSkinnedMeshGlobalLibrary_Lf& Library, FAnimationLibraryData_Lf& LibraryAnimData,
+	                                const UAnimSequence* Animation);
+
+	// Compact id of a curve name, ids are handed out on first use and never released
+	static int32 GetAnimationCurveId(FSkinnedMeshGlobalLibrary_Lf& Library, const FName& CurveName);
+
+	/**
+	 * Samples a baked curve at the keyframes the animation resolved to in its last solve.
+	 *
+	 * @param OutValue The curve value, blended by the frame alpha of the animation.
+	 * @param Animation The animation metadata.
+	 * @param Library The global library holding the curve tables.
+	 * @param CurveId The curve id from GetAnimationCurveId.
+	 *
+	 * @return True if the animation has the curve.
+	 *
+	 * @throws None
+	 */
+	static bool SampleAnimationCurve(float& OutValue, const FAnimationMetaData_Lf& Animation,
+	                                 const FSkinnedMeshGlobalLibrary_Lf& Library, const int32 CurveId);
+
+	/**
+	 * Samples a baked curve over all animations of the mesh, weighted by their final animation weight.
+	 *
+	 * @param OutValue The blended curve value, 0 if no animation has the curve.
+	 * @param Runtime The runtime data of the skinned mesh.
+	 * @param Library The global library holding the curve tables and animation groups.
+	 * @param CurveId The curve id from GetAnimationCurveId.
+	 *
+	 * @return True if any animation of the mesh has the curve.
+	 *
+	 * @throws None
+	 */
+	static bool GetAnimationCurveValue(float& OutValue, const FSkinnedMeshRuntime_Lf& Runtime,
+	                                   const FSkinnedMeshGlobalLibrary_Lf& Library, const int32 CurveId);
+
 	/**
 * Retrieves the animation curve data for a given animation.
 *
@@ -29,7 +29,7 @@ void FMeshUnit_Compute_Shader_Execute_Lf::DispatchRenderThread(
 	{
 		PreCall(RHICmdList);
 
-		if (!Params.NumMeshes)
+		if (!Params.NumMeshes && !Params.NumCopyOnlyMeshes)
 		{
 			return;
 		}
@@ -142,23 +142,30 @@ void FMeshUnit_Compute_Shader_Execute_Lf::DispatchRenderThread(
 			FTurboSequence_Helper_Lf::CreateReadRenderTargetArrayTexture_Half4_Out(
 				GraphBuilder, *Params.AnimationLibraryTexture, TEXT("TS_AnimationLibrary"));
 
-		MeshUnitPassParameters->ReferencePose_StructuredBuffer =
-			FTurboSequence_Helper_Lf::CreateStructuredReadBufferFromTArray_Half4_Out(
-				GraphBuilder, Params.CPUInverseReferencePose,
-				*FTurboSequence_Helper_Lf::FormatDebugName(FTurboSequence_BoneTransform_CS_Lf::RefPoseDebugName,
-				                                           Params.ShaderID), true);
-		MeshUnitPassParameters->ReferenceNumCPUBones_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.ReferenceNumCPUBones_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::CustomDataIndicesDebugName, Params.ShaderID), PF_R16_UINT,
-				true);
-
-		MeshUnitPassParameters->ReferencePoseIndices_StructuredBuffer =
-			FTurboSequence_Helper_Lf::CreateStructuredReadBufferFromTArray_Half4_Out(
-				GraphBuilder, Params.Indices,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::RefPoseCPUIndicesDebugName, Params.ShaderID), true);
+		Params.NumUploadedBytes = 0;
+
+		// Const data, only uploaded again when it changed
+		MeshUnitPassParameters->ReferencePose_StructuredBuffer = Params.ReferencePoseBuffer.GetSRV(
+			GraphBuilder, Params.CPUInverseReferencePose, Params.ReferenceDataVersion,
+			*FTurboSequence_Helper_Lf::FormatDebugName(FTurboSequence_BoneTransform_CS_Lf::RefPoseDebugName,
+			                                           Params.ShaderID), PF_FloatRGBA, Params.NumUploadedBytes);
+		MeshUnitPassParameters->ReferenceNumCPUBones_StructuredBuffer = Params.ReferenceNumCPUBonesBuffer.GetSRV(
+			GraphBuilder, Params.ReferenceNumCPUBones_RenderThread, Params.ReferenceDataVersion,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::CustomDataIndicesDebugName, Params.ShaderID), PF_R16_UINT,
+			Params.NumUploadedBytes);
+
+		MeshUnitPassParameters->ReferencePoseIndices_StructuredBuffer = Params.ReferencePoseIndicesBuffer.GetSRV(
+			GraphBuilder, Params.Indices, Params.ReferenceDataVersion,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::RefPoseCPUIndicesDebugName, Params.ShaderID), PF_FloatRGBA,
+			Params.NumUploadedBytes);
+
+		MeshUnitPassParameters->AnimationLayerLibrary_StructuredBuffer = Params.AnimationLayersBuffer.GetSRV(
+			GraphBuilder, Params.AnimationLayers_RenderThread, Params.AnimationLayersVersion,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::AnimationLayersDebugName, Params.ShaderID), PF_R16_UINT,
+			Params.NumUploadedBytes);
 
 		MeshUnitPassParameters->OutputTextureSizeX = AnimationOutputTextureCurrent->SizeX;
 		MeshUnitPassParameters->OutputTextureSizeY = AnimationOutputTextureCurrent->SizeY;
@@ -168,115 +175,93 @@ void FMeshUnit_Compute_Shader_Execute_Lf::DispatchRenderThread(
 
 		MeshUnitPassParameters->NumCPUBones = Params.NumMaxCPUBones;
 		MeshUnitPassParameters->NumMeshesPerFrame = Params.NumMeshes;
-
-		MeshUnitPassParameters->PerMeshCustomDataIndices_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.PerMeshCustomDataIndex_Global_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::CustomDataIndicesDebugName, Params.ShaderID), PF_R32_SINT,
-				true);
+		MeshUnitPassParameters->NumCopyOnlyMeshes = Params.NumCopyOnlyMeshes;
+
+		// Per frame data, written into the ring buffers
+		MeshUnitPassParameters->PerMeshCustomDataIndices_StructuredBuffer = Params.PerMeshCustomDataIndexBuffer.GetSRV(
+			GraphBuilder, Params.PerMeshCustomDataIndex_Global_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::CustomDataIndicesDebugName, Params.ShaderID), PF_R32_SINT,
+			Params.NumUploadedBytes);
 		MeshUnitPassParameters->PerMeshCustomDataCollectionIndex_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
+			Params.PerMeshCustomDataCollectionIndexBuffer.GetSRV(
 				GraphBuilder, Params.PerMeshCustomDataCollectionIndex_RenderThread,
 				*FTurboSequence_Helper_Lf::FormatDebugName(
 					FTurboSequence_BoneTransform_CS_Lf::CustomDataIndicesDebugName, Params.ShaderID), PF_R16_UINT,
-				true);
-
-
-		MeshUnitPassParameters->AnimationStartIndex_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.AnimationStartIndex_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::AnimationStartIndexDebugName, Params.ShaderID), PF_R32_SINT,
-				true);
-		MeshUnitPassParameters->AnimationEndIndex_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.AnimationEndIndex_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::AnimationEndIndexDebugName, Params.ShaderID), PF_R16_SINT,
-				true);
-
-		MeshUnitPassParameters->AnimationFramePose0_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.AnimationFramePose0_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::AnimationFramePose0DebugName, Params.ShaderID), PF_R32_SINT,
-				true);
-
-		MeshUnitPassParameters->AnimationFramePose1_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.AnimationFramePose1_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::AnimationFramePose1DebugName, Params.ShaderID), PF_R32_SINT,
-				true);
-
-		MeshUnitPassParameters->AnimationFrameAlpha_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.AnimationFrameAlpha_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::AnimationFrameAlphaDebugName, Params.ShaderID), PF_R16_SINT,
-				true);
-
-		MeshUnitPassParameters->AnimationWeight_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.AnimationWeights_RenderThread,
+				Params.NumUploadedBytes);
+		MeshUnitPassParameters->PerMeshResetPreviousRows_StructuredBuffer =
+			Params.PerMeshResetPreviousRowsBuffer.GetSRV(
+				GraphBuilder, Params.PerMeshResetPreviousRows_RenderThread,
 				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::AnimationWeightsDebugName, Params.ShaderID), PF_R16_SINT, true);
-
-		MeshUnitPassParameters->AnimationLayerIndex_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.AnimationLayerIndex_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::AnimationRootIndexDebugName, Params.ShaderID), PF_R16_UINT,
-				true);
-
-		if (!Params.AnimationLayers_RenderThread.Num())
-		{
-			TArray<int32> Layers;
-			Layers.Add(0);
-			MeshUnitPassParameters->AnimationLayerLibrary_StructuredBuffer =
-				FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-					GraphBuilder, Layers,
-					*FTurboSequence_Helper_Lf::FormatDebugName(
-						FTurboSequence_BoneTransform_CS_Lf::AnimationLayersDebugName, Params.ShaderID), PF_R16_SINT,
-					false);
-		}
-		else
-		{
-			MeshUnitPassParameters->AnimationLayerLibrary_StructuredBuffer =
-				FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-					GraphBuilder, Params.AnimationLayers_RenderThread,
-					*FTurboSequence_Helper_Lf::FormatDebugName(
-						FTurboSequence_BoneTransform_CS_Lf::AnimationLayersDebugName, Params.ShaderID), PF_R16_UINT,
-					true);
-		}
+					FTurboSequence_BoneTransform_CS_Lf::CustomDataIndicesDebugName, Params.ShaderID), PF_R16_UINT,
+				Params.NumUploadedBytes);
+
+		MeshUnitPassParameters->AnimationStartIndex_StructuredBuffer = Params.AnimationStartIndexBuffer.GetSRV(
+			GraphBuilder, Params.AnimationStartIndex_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::AnimationStartIndexDebugName, Params.ShaderID), PF_R32_SINT,
+			Params.NumUploadedBytes);
+		MeshUnitPassParameters->AnimationEndIndex_StructuredBuffer = Params.AnimationEndIndexBuffer.GetSRV(
+			GraphBuilder, Params.AnimationEndIndex_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::AnimationEndIndexDebugName, Params.ShaderID), PF_R16_SINT,
+			Params.NumUploadedBytes);
+
+		MeshUnitPassParameters->AnimationFramePose0_StructuredBuffer = Params.AnimationFramePose0Buffer.GetSRV(
+			GraphBuilder, Params.AnimationFramePose0_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::AnimationFramePose0DebugName, Params.ShaderID), PF_R32_SINT,
+			Params.NumUploadedBytes);
+
+		MeshUnitPassParameters->AnimationFramePose1_StructuredBuffer = Params.AnimationFramePose1Buffer.GetSRV(
+			GraphBuilder, Params.AnimationFramePose1_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::AnimationFramePose1DebugName, Params.ShaderID), PF_R32_SINT,
+			Params.NumUploadedBytes);
+
+		MeshUnitPassParameters->AnimationFrameAlpha_StructuredBuffer = Params.AnimationFrameAlphaBuffer.GetSRV(
+			GraphBuilder, Params.AnimationFrameAlpha_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::AnimationFrameAlphaDebugName, Params.ShaderID), PF_R16_SINT,
+			Params.NumUploadedBytes);
+
+		MeshUnitPassParameters->AnimationWeight_StructuredBuffer = Params.AnimationWeightsBuffer.GetSRV(
+			GraphBuilder, Params.AnimationWeights_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::AnimationWeightsDebugName, Params.ShaderID), PF_R16_SINT,
+			Params.NumUploadedBytes);
+
+		MeshUnitPassParameters->AnimationLayerIndex_StructuredBuffer = Params.AnimationLayerIndexBuffer.GetSRV(
+			GraphBuilder, Params.AnimationLayerIndex_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::AnimationRootIndexDebugName, Params.ShaderID), PF_R16_UINT,
+			Params.NumUploadedBytes);
 		
-		MeshUnitPassParameters->BoneSpaceAnimationInput_StructuredBuffer =
-			FTurboSequence_Helper_Lf::CreateStructuredReadBufferFromTArray_Half4_Out(
-				GraphBuilder, Params.BoneSpaceAnimationIKInput_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::BoneSpaceAnimationIKInputDebugName, Params.ShaderID), true);
+		MeshUnitPassParameters->BoneSpaceAnimationInput_StructuredBuffer = Params.BoneSpaceAnimationIKInputBuffer.GetSRV(
+			GraphBuilder, Params.BoneSpaceAnimationIKInput_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::BoneSpaceAnimationIKInputDebugName, Params.ShaderID), PF_FloatRGBA,
+			Params.NumUploadedBytes);
 	
-		MeshUnitPassParameters->BoneSpaceAnimationDataInput_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
-				GraphBuilder, Params.BoneSpaceAnimationIKData_RenderThread,
-				*FTurboSequence_Helper_Lf::FormatDebugName(
-					FTurboSequence_BoneTransform_CS_Lf::BoneSpaceAnimationIKDataInputDebugName, Params.ShaderID),
-				PF_R16_SINT, true);
+		MeshUnitPassParameters->BoneSpaceAnimationDataInput_StructuredBuffer = Params.BoneSpaceAnimationIKDataBuffer.GetSRV(
+			GraphBuilder, Params.BoneSpaceAnimationIKData_RenderThread,
+			*FTurboSequence_Helper_Lf::FormatDebugName(
+				FTurboSequence_BoneTransform_CS_Lf::BoneSpaceAnimationIKDataInputDebugName, Params.ShaderID),
+			PF_R16_SINT, Params.NumUploadedBytes);
 		
 		MeshUnitPassParameters->BoneSpaceAnimationDataStartIndex_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
+			Params.BoneSpaceAnimationIKStartIndexBuffer.GetSRV(
 				GraphBuilder, Params.BoneSpaceAnimationIKStartIndex_RenderThread,
 				*FTurboSequence_Helper_Lf::FormatDebugName(
 					FTurboSequence_BoneTransform_CS_Lf::BoneSpaceAnimationIKDataStartIndexInputDebugName,
-					Params.ShaderID), PF_R32_SINT, true);
+					Params.ShaderID), PF_R32_SINT, Params.NumUploadedBytes);
 
 		MeshUnitPassParameters->BoneSpaceAnimationDataEndIndex_StructuredBuffer =
-			FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
+			Params.BoneSpaceAnimationIKEndIndexBuffer.GetSRV(
 				GraphBuilder, Params.BoneSpaceAnimationIKEndIndex_RenderThread,
 				*FTurboSequence_Helper_Lf::FormatDebugName(
 					FTurboSequence_BoneTransform_CS_Lf::BoneSpaceAnimationIKDataEndIndexInputDebugName,
-					Params.ShaderID), PF_R16_SINT, true);
+					Params.ShaderID), PF_R16_SINT, Params.NumUploadedBytes);
 
 		FRDGBufferRef OutputDebugBufferRef;
 		MeshUnitPassParameters->DebugValue = FTurboSequence_Helper_Lf::TCreateWriteBuffer<float>(
@@ -304,7 +289,8 @@ void FMeshUnit_Compute_Shader_Execute_Lf::DispatchRenderThread(
 		AddCopyTexturePass(GraphBuilder, RenderTargetAnimationOutputPreviousFrameTexture,
 		                   AnimationOutputTexturePeviousRef, AnimationRenderTargetCopyInfo);
 
-		const FIntVector GroupCount = FIntVector(FMath::DivideAndRoundUp(Params.NumMeshes, FTurboSequence_BoneTransform_CS_Lf::NumThreads.X), 1, 1);
+		const FIntVector GroupCount = FIntVector(FMath::DivideAndRoundUp(Params.NumMeshes + Params.NumCopyOnlyMeshes,
+		                                                                  FTurboSequence_BoneTransform_CS_Lf::NumThreads.X), 1, 1);
 
 		GraphBuilder.AddPass(
 			RDG_EVENT_NAME("TurboSequence_Execute_Writing_Transform_Texture %d", Params.ShaderID),
@@ -400,6 +386,19 @@ void FSettingsCompute_Shader_Execute_Lf::DispatchRenderThread(
 			*FTurboSequence_Helper_Lf::FormatDebugName(FTurboSequence_Settings_CS_Lf::DataInputDebugName,
 			                                           Params.ShaderID), true);
 
+	// The buffer has to be bound either way, a single dummy index stands in when the inputs are written in a row
+	const bool bUseWriteIndices = Params.SettingsInputIndices.Num() == Params.SettingsInput.Num();
+	if (!bUseWriteIndices)
+	{
+		Params.SettingsInputIndices.Init(0, 1);
+	}
+	PassParameters->bUseWriteIndices = bUseWriteIndices;
+	PassParameters->WriteIndices_StructuredBuffer =
+		FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
+			GraphBuilder, Params.SettingsInputIndices,
+			*FTurboSequence_Helper_Lf::FormatDebugName(FTurboSequence_Settings_CS_Lf::WriteIndicesDebugName,
+			                                           Params.ShaderID), PF_R32_SINT, true);
+
 	PassParameters->TextureDimensionX = OutputTexture->SizeX;
 	PassParameters->TextureDimensionY = OutputTexture->SizeY;
 	int32 NumThreads = FTurboSequence_Settings_CS_Lf::NumThreads.X * FTurboSequence_Settings_CS_Lf::NumThreads.Y;
@@ -410,9 +409,12 @@ void FSettingsCompute_Shader_Execute_Lf::DispatchRenderThread(
 	{
 		PassParameters->BaseIndex = Params.AdditiveWriteBaseIndex;
 
+		const int64 WriteEndIndex = bUseWriteIndices
+			                            ? static_cast<int64>(FMath::Max(Params.SettingsInputIndices)) + 1
+			                            : static_cast<int64>(Params.AdditiveWriteBaseIndex) + Params.SettingsInput.Num();
 		uint16 NumSlicesWritten = FMath::Min(
 			FMath::CeilToInt(
-				static_cast<float>((Params.AdditiveWriteBaseIndex + Params.SettingsInput.Num()) / (OutputTexture->SizeX
+				static_cast<float>(WriteEndIndex / (OutputTexture->SizeX
 					* OutputTexture->SizeY))) + 1, 1024);
 
 		if (NumSlicesWritten > OutputTexture->Slices)
@@ -11,17 +11,85 @@
 #include "Engine/TextureRenderTarget2DArray.h"
 
 
+// GPU buffer kept across frames for data that rarely changes, uploaded again only when its version changes
+struct TURBOSEQUENCE_SHADER_LF_API FPersistentStructuredBuffer_Lf
+{
+	TRefCountPtr<FRDGPooledBuffer> PooledBuffer;
+	uint32 UploadedVersion = 0;
+
+	template <class T>
+	FRDGBufferSRVRef GetSRV(FRDGBuilder& GraphBuilder, const TArray<T>& Array, const uint32 Version,
+	                        const TCHAR* BufferName, const EPixelFormat Format, uint32& InOutUploadedBytes)
+	{
+		if (PooledBuffer.IsValid() && UploadedVersion == Version)
+		{
+			return GraphBuilder.CreateSRV(FRDGBufferSRVDesc(GraphBuilder.RegisterExternalBuffer(PooledBuffer), Format));
+		}
+
+		FRDGBufferRef Buffer;
+		const FRDGBufferSRVRef BufferSRV = FTurboSequence_Helper_Lf::TCreateStructuredReadBufferFromTArray_Custom_Out(
+			GraphBuilder, Array, Buffer, BufferName, Format, true);
+		PooledBuffer = GraphBuilder.ConvertToExternalBuffer(Buffer);
+		UploadedVersion = Version;
+		InOutUploadedBytes += Array.Num() * sizeof(T);
+
+		return BufferSRV;
+	}
+};
+
+// Per frame data uploaded into a ring of pooled buffers, no buffer gets created per frame
+// and a buffer the GPU might still read for an earlier frame is never written
+struct TURBOSEQUENCE_SHADER_LF_API FRingStructuredBuffer_Lf
+{
+	static constexpr int32 NumRingBuffers = 3;
+
+	TRefCountPtr<FRDGPooledBuffer> PooledBuffers[NumRingBuffers];
+	int32 RingIndex = 0;
+
+	template <class T>
+	FRDGBufferSRVRef GetSRV(FRDGBuilder& GraphBuilder, const TArray<T>& Array, const TCHAR* BufferName,
+	                        const EPixelFormat Format, uint32& InOutUploadedBytes)
+	{
+		RingIndex = (RingIndex + 1) % NumRingBuffers;
+		TRefCountPtr<FRDGPooledBuffer>& PooledBuffer = PooledBuffers[RingIndex];
+
+		const uint32 NumElements = FMath::Max(Array.Num(), 1);
+		FRDGBufferRef Buffer;
+		if (PooledBuffer.IsValid() && PooledBuffer->Desc.NumElements >= NumElements)
+		{
+			Buffer = GraphBuilder.RegisterExternalBuffer(PooledBuffer);
+		}
+		else
+		{
+			// Grows with slack, so a growing crowd doesn't reallocate every frame
+			Buffer = GraphBuilder.CreateBuffer(
+				FRDGBufferDesc::CreateStructuredDesc(sizeof(T), FMath::RoundUpToPowerOfTwo(NumElements)), BufferName);
+			PooledBuffer = GraphBuilder.ConvertToExternalBuffer(Buffer);
+		}
+
+		if (Array.Num())
+		{
+			GraphBuilder.QueueBufferUpload(Buffer, Array.GetData(), Array.Num() * sizeof(T), ERDGInitialDataFlags::NoCopy);
+			InOutUploadedBytes += Array.Num() * sizeof(T);
+		}
+
+		return GraphBuilder.CreateSRV(FRDGBufferSRVDesc(Buffer, Format));
+	}
+};
+
 struct TURBOSEQUENCE_SHADER_LF_API FMeshUnitComputeShader_Params_Lf
 {
 	// ID for memory management
 	uint32 ShaderID;
 
-	TArray<int32> ReferenceNumCPUBones;
-
 	// Minimals getting uploaded to the GPU
 	int32 NumMeshes;
+	// Meshes after NumMeshes which only copy their current rows to the previous rows
+	int32 NumCopyOnlyMeshes = 0;
 	TArray<int32> PerMeshCustomDataIndex_Global_RenderThread;
 	TArray<int32> PerMeshCustomDataCollectionIndex_RenderThread;
+	// 1 when the solve writes the previous rows as well, the skeleton moved or is new in the bone texture
+	TArray<int32> PerMeshResetPreviousRows_RenderThread;
 	TArray<int32> ReferenceNumCPUBones_RenderThread;
 
 	TArray<int32> AnimationStartIndex_RenderThread;
@@ -47,6 +115,35 @@ struct TURBOSEQUENCE_SHADER_LF_API FMeshUnitComputeShader_Params_Lf
 	TArray<FVector4f> Indices;
 	int32 NumMaxCPUBones;
 
+	// Version of CPUInverseReferencePose, Indices and ReferenceNumCPUBones_RenderThread,
+	// the const data stays on the GPU until it changes
+	uint32 ReferenceDataVersion = 0;
+	// Version of AnimationLayers_RenderThread
+	uint32 AnimationLayersVersion = 0;
+
+	FPersistentStructuredBuffer_Lf ReferencePoseBuffer;
+	FPersistentStructuredBuffer_Lf ReferencePoseIndicesBuffer;
+	FPersistentStructuredBuffer_Lf ReferenceNumCPUBonesBuffer;
+	FPersistentStructuredBuffer_Lf AnimationLayersBuffer;
+
+	FRingStructuredBuffer_Lf PerMeshCustomDataIndexBuffer;
+	FRingStructuredBuffer_Lf PerMeshCustomDataCollectionIndexBuffer;
+	FRingStructuredBuffer_Lf PerMeshResetPreviousRowsBuffer;
+	FRingStructuredBuffer_Lf AnimationStartIndexBuffer;
+	FRingStructuredBuffer_Lf AnimationEndIndexBuffer;
+	FRingStructuredBuffer_Lf AnimationFramePose0Buffer;
+	FRingStructuredBuffer_Lf AnimationFramePose1Buffer;
+	FRingStructuredBuffer_Lf AnimationFrameAlphaBuffer;
+	FRingStructuredBuffer_Lf AnimationWeightsBuffer;
+	FRingStructuredBuffer_Lf AnimationLayerIndexBuffer;
+	FRingStructuredBuffer_Lf BoneSpaceAnimationIKInputBuffer;
+	FRingStructuredBuffer_Lf BoneSpaceAnimationIKDataBuffer;
+	FRingStructuredBuffer_Lf BoneSpaceAnimationIKStartIndexBuffer;
+	FRingStructuredBuffer_Lf BoneSpaceAnimationIKEndIndexBuffer;
+
+	// Bytes of buffer data the last dispatch uploaded
+	uint32 NumUploadedBytes = 0;
+
 	bool bUse32BitTransformTexture;
 
 	// Debug
@@ -65,6 +162,9 @@ struct TURBOSEQUENCE_SHADER_LF_API FSettingsComputeShader_Params_Lf
 
 	TArray<FVector4f> SettingsInput;
 
+	// Texture index per input, when set the inputs get scattered there instead of written from AdditiveWriteBaseIndex on
+	TArray<int32> SettingsInputIndices;
+
 	bool bIsAdditiveWrite;
 
 	uint32 AdditiveWriteBaseIndex = 0;
@@ -131,6 +231,7 @@ public:
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters,)
 		SHADER_PARAMETER(int, NumCPUBones)
 		SHADER_PARAMETER(int, NumMeshesPerFrame)
+		SHADER_PARAMETER(int, NumCopyOnlyMeshes)
 
 		SHADER_PARAMETER(int, AnimTextureSizeX)
 		SHADER_PARAMETER(int, AnimTextureSizeY)
@@ -149,6 +250,7 @@ public:
 		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<min16int>, BoneSpaceAnimationDataEndIndex_StructuredBuffer)
 		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<int>, PerMeshCustomDataIndices_StructuredBuffer)
 		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<min16uint>, PerMeshCustomDataCollectionIndex_StructuredBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<min16uint>, PerMeshResetPreviousRows_StructuredBuffer)
 		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<min16uint>, ReferenceNumCPUBones_StructuredBuffer)
 
 		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<int>, AnimationStartIndex_StructuredBuffer)
@@ -204,6 +306,7 @@ public:
 	inline static const FString DebugName = TEXT("TurboSequence_Settings_Debug_{0}");
 	inline static const FString WriteTextureDebugName = TEXT("TurboSequence_Settings_WriteTexture_{0}");
 	inline static const FString DataInputDebugName = TEXT("TurboSequence_Settings_DataInput_{0}");
+	inline static const FString WriteIndicesDebugName = TEXT("TurboSequence_Settings_WriteIndices_{0}");
 
 	DECLARE_GLOBAL_SHADER(FTurboSequence_Settings_CS_Lf);
 	SHADER_USE_PARAMETER_STRUCT(FTurboSequence_Settings_CS_Lf, FGlobalShader);
@@ -213,8 +316,10 @@ public:
 		SHADER_PARAMETER(uint32, TextureDimensionY)
 		SHADER_PARAMETER(uint32, NumPixelPerThread)
 		SHADER_PARAMETER(uint32, BaseIndex)
+		SHADER_PARAMETER(uint32, bUseWriteIndices)
 
 		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FVector4f>, BoneWeights_StructuredBuffer)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<int>, WriteIndices_StructuredBuffer)
 
 		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2DArray<FVector4f>, RW_Settings_OutputTexture)
 	END_SHADER_PARAMETER_STRUCT()